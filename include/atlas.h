@@ -0,0 +1,53 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include <SDL/SDL.h>
+
+#define ATLAS_PAGE_SIZE 2048    // Square pages in the SDL_DisplayFormatAlpha() layout
+#define MAX_ATLAS_PAGES 16
+#define MAX_ATLAS_SHEETS 512
+
+// A run of visible pixels in one row of a trimmed cell, x relative to the box: either all fully
+// opaque (copied as is) or all translucent (blended)
+typedef struct {
+    Uint16 x, w;
+    Uint8 opaque;
+} AtlasSpan;
+
+// Where one cell of a packed sheet lives. Only the cell's opaque bounding box is stored: rect is
+// that box on its page and offsetX/offsetY place it inside the cell. A fully transparent cell
+// keeps no pixels and has page -1. Row r of the box has spans[rowSpans[r]] to spans[rowSpans[r + 1] - 1].
+typedef struct {
+    int page;
+    SDL_Rect rect;
+    int offsetX, offsetY;
+    AtlasSpan *spans;
+    int *rowSpans;
+} AtlasFrame;
+
+// A sheet cut into cellW x cellH cells, row-major; the last column and row may be narrower
+typedef struct {
+    SDL_Surface *sheet;     // The loader's surface, still the handle render code passes around
+    int w, h;
+    int cellW, cellH;
+    int columns, rows;
+    AtlasFrame *frames;
+} AtlasSheet;
+
+// Copies a loaded sheet into the shared pages, cell by cell and trimmed to each cell's opaque
+// pixels. The sheet keeps its own pixels, so it stays a plain surface for SDL_BlitSurface(),
+// sprite masks and the per-pixel collision test.
+// Returns 0 and leaves the sheet as it was when it cannot be packed (RLE, hardware or
+// surface-alpha sheets, cells larger than a page, or no page left); blitSprite() then draws the
+// sheet directly.
+int packSpriteSheet(SDL_Surface *sheet, int cellW, int cellH);
+void unpackSpriteSheet(SDL_Surface *sheet);    // Call before SDL_FreeSurface()
+const AtlasSheet *findAtlasSheet(SDL_Surface *sheet);
+
+// blitSprite() for a packed sheet: srcrect is in the sheet's coordinates (mirrored ones when
+// mirrored, as for blitMirrored()) and may span several cells. On a 32-bit screen in the pages'
+// RGB layout the cells are drawn span by span, skipping transparent runs; other targets go
+// through SDL_BlitSurface() or blitMirrored().
+int blitAtlasSheet(const AtlasSheet *packed, SDL_Rect *srcrect, SDL_Surface *dst, SDL_Rect *dstrect, int mirrored);
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef BGTILES_H
+#define BGTILES_H
+
+#include <SDL/SDL.h>
+
+#define BG_TILE_WIDTH 256       // Column width level backgrounds are split into
+#define BG_TILE_CACHE 10        // Cooked columns kept decoded; a 1280 px screen spans at most 6
+#define BG_TILES_MAGIC "BGTILES"
+#define BG_TILES_VERSION 1
+
+// A level background held as BG_TILE_WIDTH-wide columns. Cooked backgrounds ("make tiles") decode
+// columns from BMP on demand around the camera and keep the BG_TILE_CACHE most recently used, so
+// memory does not grow with the level width. Otherwise the PNG is split on load and stays resident.
+typedef struct {
+    int width, height;
+    int tileWidth, numTiles;
+    SDL_Surface **tiles;        // NULL while a column is not decoded
+    Uint32 *lastUsed;           // Frame each column was last drawn or prefetched
+    int resident;
+    int cooked;                 // Columns can be reloaded from tilePattern, so they may be evicted
+    char tilePattern[64];       // printf pattern of the column BMPs, indexed by column
+    Uint32 frame;
+    int scroll_x, direction;    // Camera of the last frame and which way it last moved (-1, 0, 1)
+    int loads, evictions;
+} TiledBackground;
+
+// Splits a decoded background into resident columns; image is left to the caller
+int splitTiledBackground(TiledBackground *bg, SDL_Surface *image, int tileWidth);
+// Writes the columns as BMPs next to index_path, then the index itself
+int saveTiledBackground(const TiledBackground *bg, const char *index_path);
+// Reads a cooked index; no column is decoded until it is needed
+int loadTiledBackground(TiledBackground *bg, const char *index_path);
+void freeTiledBackground(TiledBackground *bg);
+
+// Once per frame: decodes the columns in view plus the next one in the scroll direction, then
+// evicts the least recently used cooked columns beyond BG_TILE_CACHE
+void updateTiledBackground(TiledBackground *bg, int scroll_x, int view_w);
+// SDL_BlitSurface() of a background area, decoding any column it needs that is not resident
+int blitTiledBackground(TiledBackground *bg, SDL_Rect src, SDL_Surface *dst, int x, int y);
+
+#endif
@@ -37,6 +37,7 @@ typedef struct {
     int invulnTimer;
     int facingLeft;
     int active;
+    int onGround;      // Refreshed each frame by onGroundBatch()
     int attackCooldown;
     int angry;
     int hasDamagedThisAttack;
@@ -57,6 +58,7 @@ typedef struct {
     SDL_Rect levelUpIconPosition;
     int levelUpIconActive;
     Uint32 levelUpIconSpawnTime;
+    int levelUpTrigger;     // Pickup handle in game->triggers while the icon is out, -1 otherwise
     int levelUpFlickerCounter;
 } Boss;
 
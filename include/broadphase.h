@@ -0,0 +1,47 @@
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <SDL/SDL.h>
+
+#define MAX_COLLIDERS 96
+#define BROADPHASE_MAX_INDEX 32   // Colliders per type; keep >= the largest MAX_* entity count
+#define BROADPHASE_MARGIN 32      // x padding so intervals built once a frame still cover a frame's movement
+#define PLAYER_MELEE_REACH 50     // How far the ATTACK_1 hitbox reaches behind the player's world_x
+
+typedef enum {
+    COLLIDER_PLAYER,
+    COLLIDER_BULLET,
+    COLLIDER_SOLDIER,
+    COLLIDER_SOLDIER2,
+    COLLIDER_ROBOT,
+    COLLIDER_BOSS,
+    COLLIDER_TYPE_COUNT
+} ColliderType;
+
+// Contact bits: which probe colliders share an x-interval with a collider this frame
+#define CONTACT_PLAYER 1
+#define CONTACT_BULLET 2
+
+typedef struct {
+    ColliderType type;
+    int index;
+    int x0, x1;     // Padded world x-interval [x0, x1)
+} Collider;
+
+typedef struct {
+    Collider colliders[MAX_COLLIDERS];
+    int count;
+    Uint8 contacts[COLLIDER_TYPE_COUNT][BROADPHASE_MAX_INDEX];
+} Broadphase;
+
+void resetBroadphase(Broadphase *bp);
+void addCollider(Broadphase *bp, ColliderType type, int index, int world_x, int w);
+void sweepBroadphase(Broadphase *bp);
+
+// CONTACT_* bits of collider (type, index) from the last sweep
+static inline int colliderContacts(const Broadphase *bp, ColliderType type, int index) {
+    if (index < 0 || index >= BROADPHASE_MAX_INDEX) return CONTACT_PLAYER | CONTACT_BULLET;
+    return bp->contacts[type][index];
+}
+
+#endif
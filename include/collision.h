@@ -10,6 +10,8 @@
 #include "enemylvl2.h" 
 #include "player2.h" // Added for Player2
 
+#define LOS_CHECK_FRAMES 10  // Shooters refresh their line of sight to the player this often
+
 void PutPixel(SDL_Surface *surface, int x, int y, Uint32 pixel);
 void placePlayerOnGround(GAME *game);
 void placeSoldierOnGround(GAME *game, Soldier *soldier);
@@ -20,6 +22,8 @@ void placeEnemyLvl2OnGround(GAME *game, SDL_Rect *position, int world_x);
 void placeNPCOnGround(GAME *game, NPC *npc);
 void placeNPC2OnGround(GAME *game, NPC2 *npc);
 Color collision_color(GAME *game, int x, int y);
+int projectileHitsTerrain(GAME *game, int x0, int y0, int x1, int y1);
+int hasLineOfSight(GAME *game, int x0, int y0, int x1, int y1);
 void placePlayer2OnGround(GAME *game); // Added for Player2
 
 #endif
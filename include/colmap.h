@@ -0,0 +1,188 @@
+#ifndef COLMAP_H
+#define COLMAP_H
+
+#include <SDL/SDL.h>
+
+// Materials stored in the packed collision map (2 bits per pixel)
+typedef enum {
+    MAT_EMPTY = 0,
+    MAT_SOLID = 1,  // 255/255/255 in the mask
+    MAT_DOOR = 2,   // 255/0/42 (DOOR_RED)
+    MAT_GREEN = 3   // 0/255/0 (GREEN_ZONE)
+} Material;
+
+#define COLMAP_ALIGN 64          // Rows start on a cache line
+#define COLMAP_PIXELS_PER_BYTE 4
+
+// Vertical run of solid pixels in one column; top is a ground surface
+typedef struct {
+    Uint16 top, bottom;
+} GroundSpan;
+
+// Rectangle of door or green-zone pixels, built by merging identical runs on consecutive rows
+typedef struct {
+    SDL_Rect rect;      // Mask coordinates
+    Material material;
+} MaskZone;
+
+// Min/max solidity of size x size pixel tiles, so ray walks can skip empty tiles whole and stop in solid ones
+#define COLMAP_TILE_LEVELS 2     // tiles[0] is 64x64, tiles[1] is 8x8
+#define COLMAP_TILE_ANY 1        // At least one solid pixel
+#define COLMAP_TILE_ALL 2        // Every pixel solid
+
+typedef struct {
+    Uint8 *flags;   // COLMAP_TILE_* per tile, row-major
+    int size;       // Tile edge in pixels
+    int w, h;       // Tiles per row and per column
+} SolidTiles;
+
+typedef struct {
+    Uint8 *bits;    // 2-bit materials, 4 pixels per byte, low bits = leftmost pixel
+    int w, h;
+    int pitch;      // Bytes per packed row, multiple of COLMAP_ALIGN
+    int y_offset;   // Screen y of mask row 0: (SCREEN_HEIGHT - h) / 2
+    GroundSpan *spans;   // All columns' solid runs, sorted top to bottom per column
+    int *spanStart;      // Column x owns spans[spanStart[x] .. spanStart[x + 1] - 1]
+    MaskZone *zones;     // Every MAT_DOOR / MAT_GREEN pixel, sorted by rect.x
+    int numZones;
+    int maxZoneWidth;
+    SolidTiles tiles[COLMAP_TILE_LEVELS];   // Built at load time, not stored in .colmap files
+    void *mapped;        // Whole .colmap file when loaded by loadCollisionMap(), else NULL
+    size_t mappedSize;
+} CollisionMap;
+
+// Compiled .colmap file: this header, then each section at its offset (64-byte aligned).
+// Written by tools/colmapc ("make masks") in the byte order of the machine that builds the game.
+#define COLMAP_MAGIC "CMAP"
+#define COLMAP_VERSION 1
+
+typedef struct {
+    char magic[4];
+    Uint32 version;
+    Sint32 w, h, pitch, y_offset;
+    Sint32 numSpans, numZones, maxZoneWidth;
+    Uint32 bitsOffset;        // pitch * h bytes
+    Uint32 spanStartOffset;   // (w + 1) ints
+    Uint32 spansOffset;       // numSpans GroundSpans
+    Uint32 zonesOffset;       // numZones MaskZones
+} ColmapHeader;
+
+// Terrain query cost, counted by every query below and shown by the debug overlay
+#define COLMAP_MAX_PROBES 512
+
+typedef enum {
+    PROBE_ROW,      // collisionRowSolid(): onGround* row scans
+    PROBE_COLUMN,   // collisionFirstSolidBelow(): place*OnGround / sweep searches, from y down to the ground found
+    PROBE_PIXEL,    // collision_color() point reads
+    PROBE_RAY       // collisionRaycast(): shots and line of sight
+} ProbeKind;
+
+typedef struct {
+    Sint16 x0, y0, x1, y1;   // Mask coordinates
+    Uint8 kind;
+} CollisionProbe;
+
+typedef struct {
+    Uint32 samples;          // Mask bytes, spans, tiles and zones read this frame
+    Uint32 locks;            // SDL_LockSurface() calls this frame
+    Uint32 queries;
+    int recordProbes;        // Keep this frame's probe shapes (set while the overlay is shown)
+    CollisionProbe probes[COLMAP_MAX_PROBES];
+    int numProbes;
+    Uint32 frames;           // Totals folded in by collisionStatsEndFrame()
+    Uint64 totalSamples, totalLocks, totalQueries;
+    Uint32 peakSamples, peakLocks, peakQueries;
+} CollisionStats;
+
+extern CollisionStats collisionStats;
+
+// The sample and query counters sit in the innermost collision loops, so they are only compiled in
+// with -DCOLLISION_STATS; otherwise the overlay and the exit dump report them as 0
+#ifdef COLLISION_STATS
+#define COLLISION_COUNT(counter) (collisionStats.counter++)
+#else
+#define COLLISION_COUNT(counter) ((void)0)
+#endif
+
+static inline void collisionNoteProbe(ProbeKind kind, int x0, int y0, int x1, int y1) {
+    COLLISION_COUNT(queries);
+    if (!collisionStats.recordProbes || collisionStats.numProbes == COLMAP_MAX_PROBES) return;
+    CollisionProbe *probe = &collisionStats.probes[collisionStats.numProbes++];
+    probe->x0 = (Sint16)x0;
+    probe->y0 = (Sint16)y0;
+    probe->x1 = (Sint16)x1;
+    probe->y1 = (Sint16)y1;
+    probe->kind = (Uint8)kind;
+}
+
+void collisionStatsEndFrame(void);
+// Prints the whole-run totals to `path`, or stdout when path is NULL, then clears them
+void collisionStatsDump(const char *path);
+
+int initCollisionMap(CollisionMap *map, SDL_Surface *mask, int y_offset);
+void freeCollisionMap(CollisionMap *map);
+int saveCollisionMap(const CollisionMap *map, const char *path);
+int loadCollisionMap(CollisionMap *map, const char *path);
+
+// Material at mask coordinates (x, y); MAT_EMPTY outside the map
+static inline Material collisionMaterial(const CollisionMap *map, int x, int y) {
+    if (x < 0 || x >= map->w || y < 0 || y >= map->h) return MAT_EMPTY;
+    COLLISION_COUNT(samples);
+    Uint8 byte = map->bits[y * map->pitch + (x >> 2)];
+    return (Material)((byte >> ((x & 3) << 1)) & 3);
+}
+
+static inline int collisionSolid(const CollisionMap *map, int x, int y) {
+    return collisionMaterial(map, x, y) == MAT_SOLID;
+}
+
+// One packed row, with the bounds and pitch math done once for scans along it
+typedef struct {
+    const Uint8 *row;   // NULL when y is outside the map
+    int w;
+} MaskView;
+
+static inline MaskView collisionRowView(const CollisionMap *map, int y) {
+    MaskView view = {NULL, map->w};
+    if (map->bits && y >= 0 && y < map->h) view.row = map->bits + y * map->pitch;
+    return view;
+}
+
+// x must be inside [0, view.w) and view.row non-NULL
+static inline Material maskViewMaterial(MaskView view, int x) {
+    return (Material)((view.row[x >> 2] >> ((x & 3) << 1)) & 3);
+}
+
+static inline int maskViewSolid(MaskView view, int x) {
+    return maskViewMaterial(view, x) == MAT_SOLID;
+}
+
+// End (exclusive) of the run of `material` pixels starting at x; skips whole bytes of it at a time
+int maskViewRunEnd(MaskView view, int x, Material material);
+
+// Scans row y from x_left to x_right in steps of `step`, returns 1 on the first solid sample
+int collisionRowSolid(const CollisionMap *map, int x_left, int x_right, int y, int step);
+
+// First solid y at or below y in column x, or -1 (binary search over the column's spans)
+int collisionFirstSolidBelow(const CollisionMap *map, int x, int y);
+// Smallest collisionFirstSolidBelow() over columns x_left..x_right sampled every `step` px, or -1
+int collisionGroundBelow(const CollisionMap *map, int x_left, int x_right, int step, int y);
+
+// COLMAP_TILE_* flags of the tile holding mask pixel (x, y) at pyramid level `level`; 0 outside the map
+static inline int collisionTileFlags(const CollisionMap *map, int level, int x, int y) {
+    const SolidTiles *tiles = &map->tiles[level];
+    if (!tiles->flags || x < 0 || x >= map->w || y < 0 || y >= map->h) return 0;
+    COLLISION_COUNT(samples);
+    return tiles->flags[(y / tiles->size) * tiles->w + x / tiles->size];
+}
+
+// Walks every pixel on the segment (x0, y0)-(x1, y1) from the start; on the first solid one
+// stores it in *hit_x / *hit_y (either may be NULL) and returns 1. Empty pyramid tiles are
+// stepped over in one jump, so long rays through open air cost a few tile lookups; a pixel in
+// a fully solid tile is answered from the tile flags alone.
+int collisionRaycast(const CollisionMap *map, int x0, int y0, int x1, int y1, int *hit_x, int *hit_y);
+
+// Leftmost x of a `material` pixel within `radius` px of (x, y), or -1
+int collisionFindZone(const CollisionMap *map, Material material, int x, int y, int radius);
+
+#endif
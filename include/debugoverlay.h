@@ -0,0 +1,24 @@
+#ifndef DEBUGOVERLAY_H
+#define DEBUGOVERLAY_H
+
+#include <SDL/SDL.h>
+#include "colmap.h"
+
+#define DEBUG_OVERLAY_ALPHA 96        // Opacity of the tinted collision mask
+#define DEBUG_STATS_ENV "COLLISION_STATS_FILE"   // Collision counters are appended here at exit, else printed
+
+struct GAME;
+
+// Collision debug view, toggled with F3
+typedef struct {
+    int visible;
+    SDL_Surface *tint;      // 8-bit copy of the collision map coloured by material, built on first show
+} DebugOverlay;
+
+void toggleDebugOverlay(DebugOverlay *overlay);
+void freeDebugOverlay(DebugOverlay *overlay);   // Drops the tint; it is rebuilt for the next level
+
+// Draws the tinted mask, this frame's probes, trigger volumes and counters over the finished frame
+void renderDebugOverlay(struct GAME *game, SDL_Surface *screen, int scroll_x);
+
+#endif
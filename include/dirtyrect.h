@@ -0,0 +1,42 @@
+#ifndef DIRTYRECT_H
+#define DIRTYRECT_H
+
+#include <SDL/SDL.h>
+
+#define MAX_DIRTY_RECTS 128
+#define RENDERER_ENV "SB_RENDERER"   // "dirty" selects the dirty-rectangle renderer (on a software screen)
+
+// Tracks what each frame draws on the screen so the next one repaints and presents only those areas.
+// Off by default: every frame is then cleared, redrawn and flipped whole, as before.
+typedef struct {
+    SDL_Surface *screen;
+    int enabled;
+    int full;               // Next frame repaints and presents the whole screen
+    int presentAll;         // This frame presents the whole screen (repainted, scrolled or too many rects)
+    int scroll_x, haveScroll;                  // Camera of the last level frame
+    SDL_Rect drawn[MAX_DIRTY_RECTS];           // Areas drawn this frame, clipped to the screen
+    int numDrawn;
+    SDL_Rect previous[MAX_DIRTY_RECTS];        // Areas drawn last frame
+    int numPrevious;
+    SDL_Rect restore[MAX_DIRTY_RECTS + 1];     // Areas beginDirtyFrame() wants repainted with background
+    int numRestore;
+} DirtyRenderer;
+
+extern DirtyRenderer dirtyRenderer;
+
+void initDirtyRenderer(SDL_Surface *screen, int enabled);   // Stays off on double-buffered screens
+void invalidateScreen(void);                                // Something else drew over the whole screen
+int consumeFullRedraw(void);                                // 1 once after invalidateScreen(), and always when off
+void markDirty(SDL_Rect rect);
+
+// SDL_BlitSurface() / SDL_FillRect() that record the clipped area when they draw on the screen
+int trackedBlit(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst, SDL_Rect *dstrect);
+int trackedFill(SDL_Surface *dst, SDL_Rect *dstrect, Uint32 color);
+
+// Starts a level frame at camera scroll_x. Scrolls the screen pixels along with the camera and returns how
+// many dirtyRenderer.restore rects need the background repainted, or -1 to repaint the whole screen.
+int beginDirtyFrame(int scroll_x);
+// SDL_UpdateRects() over the repainted and drawn areas; SDL_Flip() when off
+void presentDirtyFrame(void);
+
+#endif
@@ -38,23 +38,14 @@ typedef struct {
     int world_x; // Added world_x
     // Sprite sheets
     SDL_Surface* idleSheet;
-    SDL_Surface* idleSheetFlipped;
     SDL_Surface* walkSheet;
-    SDL_Surface* walkSheetFlipped;
     SDL_Surface* attack1Sheet;
-    SDL_Surface* attack1SheetFlipped;
     SDL_Surface* attack2Sheet;
-    SDL_Surface* attack2SheetFlipped;
     SDL_Surface* attack3Sheet;
-    SDL_Surface* attack3SheetFlipped;
     SDL_Surface* hurtSheet;
-    SDL_Surface* hurtSheetFlipped;
     SDL_Surface* deadSheet;
-    SDL_Surface* deadSheetFlipped;
     SDL_Surface* enablingSheet;
-    SDL_Surface* enablingSheetFlipped;
     SDL_Surface* shutdownSheet;
-    SDL_Surface* shutdownSheetFlipped;
 } Enemy;
 
 void initEnemy(Enemy* enemy, int x, int y);
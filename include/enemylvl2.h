@@ -3,6 +3,7 @@
 
 #include <SDL/SDL.h>
 #include "utils.h"
+#include "navgraph.h"
 
 
 #define MAX_FALL_SPEED 10.0f
@@ -53,6 +54,7 @@ typedef struct {
     int active;
     Uint32 lastFrameTime;
     int attackCooldown;
+    NavAgent nav;
 } Mummy;
 
 typedef struct {
@@ -70,6 +72,7 @@ typedef struct {
     int active;
     Uint32 lastFrameTime;
     int attackCooldown;
+    NavAgent nav;
     SDL_Rect projectilePos;
     int projectileActive;
     float projectileDx;
@@ -92,6 +95,7 @@ typedef struct {
     int active;
     Uint32 lastFrameTime;
     int attackCooldown;
+    NavAgent nav;
     int hasPetrified;
     Particle particles[MAX_PARTICLES];
 } Gorgon;
@@ -111,6 +115,7 @@ typedef struct {
     int active;
     Uint32 lastFrameTime;
     int attackCooldown;
+    NavAgent nav;
     int hasFallen;
 } SkeletonSpearman;
 
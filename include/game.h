@@ -17,6 +17,15 @@
 #include "npc2.h"       
 #include "enemylvl2.h"  
 #include "player2.h"    
+#include "colmap.h"
+#include "navgraph.h"
+#include "broadphase.h"
+#include "trigger.h"
+#include "debugoverlay.h"
+#include "dirtyrect.h"
+#include "spriteblit.h"
+#include "atlas.h"
+#include "bgtiles.h"
 
 #define SCREEN_WIDTH 1280
 #define SCREEN_HEIGHT 720
@@ -82,26 +91,27 @@ typedef struct {
 } Item;
 
 typedef struct {
-    SDL_Surface *image;
-    SDL_Surface *levelCollision;
+    TiledBackground tiles;   // Level image as columns, decoded around the camera when cooked
+    CollisionMap collision;  // Packed level mask, built in load_level()
+    NavGraph nav;            // Platforms and edges extracted from the mask for enemy chase routes
     int scroll_x;
     int width;
     int height;
 } Background;
 
 typedef struct {
-    SDL_Surface *idleSheet, *idleSheetFlipped;
-    SDL_Surface *walkSheet, *walkSheetFlipped;
-    SDL_Surface *runSheet, *runSheetFlipped;
-    SDL_Surface *jumpSheet, *jumpSheetFlipped;
-    SDL_Surface *attack1Sheet, *attack1SheetFlipped;
-    SDL_Surface *shotSheet, *shotSheetFlipped;
-    SDL_Surface *rechargeSheet, *rechargeSheetFlipped;
-    SDL_Surface *hurtSheet, *hurtSheetFlipped;
-    SDL_Surface *deadSheet, *deadSheetFlipped;
+    SDL_Surface *idleSheet;
+    SDL_Surface *walkSheet;
+    SDL_Surface *runSheet;
+    SDL_Surface *jumpSheet;
+    SDL_Surface *attack1Sheet;
+    SDL_Surface *shotSheet;
+    SDL_Surface *rechargeSheet;
+    SDL_Surface *hurtSheet;
+    SDL_Surface *deadSheet;
     SDL_Surface *healthBarBg, *healthBarGreen;
     SDL_Surface *killIcon1, *killIcon2, *killIcon3, *killIcon4;
-    SDL_Surface *bulletSheet, *bulletSheetFlipped;
+    SDL_Surface *bulletSheet;
     Item healthItem;
     SDL_Rect position;
     SDL_Rect bullet;
@@ -142,9 +152,7 @@ typedef struct {
     SDL_Rect pos_avatar, pos_lives;
     SDL_Rect pos_healthBar;
     SDL_Rect pos_score;
-    SDL_Surface *cachedScoreSurface;
     SDL_Surface *ammoIcon;         // Added
-    SDL_Surface *cachedAmmoSurface; // Added
 } UI;
 
 typedef enum {
@@ -183,7 +191,6 @@ typedef struct {
     int showMessage, currentLevel;
     char message[50];
     SDL_Rect messagePosition;
-    SDL_Surface *messageSurface;
     int gameOver;
     int currentGreenZone;
     int quizActive;
@@ -236,6 +243,9 @@ typedef struct GAME{
     int numCoins;
     void *enigma;
     int inventoryVisible; // Added for inventory toggle
+    Broadphase broadphase; // x-sorted colliders, rebuilt each frame in playLevel()
+    TriggerSet triggers;   // Door, talk, portal and pickup volumes of the current level
+    DebugOverlay debug;    // F3 collision view
 } GAME;
 
 void load_level(struct GAME *game, int level);
@@ -0,0 +1,23 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_ttf.h>
+
+#define GLYPH_FIRST 32          // Latin-1 glyphs 32-255, as TTF_RenderText_Solid() reads its input
+#define GLYPH_COUNT 224
+#define GLYPH_COLUMNS 16
+#define MAX_GLYPH_SETS 16       // (font, colour) pairs kept at once
+
+// Solid-mode text drawn from glyphs rasterized once per (font, colour) and packed into the sprite
+// atlas. Layout follows TTF_RenderText_Solid() without kerning, so a string lands where a
+// rendered surface blitted at (x, y) would have put it, with TTF_FontHeight() as its height.
+int blitText(SDL_Surface *dst, TTF_Font *font, const char *text, SDL_Color color, int x, int y);
+
+// Width TTF_SizeText() would report, from the cached glyph metrics; nothing is rendered
+int textWidth(TTF_Font *font, const char *text);
+
+// Drops every glyph set of a font; call before TTF_CloseFont()
+void releaseGlyphFont(TTF_Font *font);
+
+#endif
@@ -5,6 +5,7 @@
 #include <SDL/SDL_image.h>
 #include <SDL/SDL_ttf.h>
 #include <SDL/SDL_mixer.h>
+#include "dirtyrect.h"
 
 
 // Constants
@@ -75,7 +76,7 @@ void renderBackground(SDL_Surface *screen, BackgroundState background_state);
 
 void initialize_sdl();
 void handle_events(int *running, int *selected, Button buttons[], int button_count, Mix_Chunk *hover_sound, Mix_Chunk *click_sound, int *selected_button);
-void render(SDL_Surface *screen, SDL_Surface *background, Button buttons[], int button_count, TTF_Font *font, SDL_Color textColor, int selected_button);
+int render(SDL_Surface *screen, SDL_Surface *background, Button buttons[], int button_count, TTF_Font *font, SDL_Color textColor, int selected_button);
 void cleanup(Button buttons[], int button_count, SDL_Surface *background, Mix_Music *music, Mix_Chunk *hover_sound, Mix_Chunk *click_sound, TTF_Font *font);
 
 
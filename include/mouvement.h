@@ -11,7 +11,19 @@
 #include "npc.h"
 #include "player2.h" // Added for Player2
 
+// One entity's ground query for onGroundBatch(); the result is written through onGround
+typedef struct {
+    int world_x;
+    int bottom_y;   // Screen y of the feet: position.y + position.h
+    int width;
+    int *onGround;
+} GroundProbe;
+
 int onGround(GAME *game, Player *player);
+void onGroundBatch(GAME *game, GroundProbe *probes, int count);
+int sweepMove(GAME *game, int world_x, int width, int bottom_y, int dy);
+int chaseDirection(GAME *game, NavAgent *agent, int world_x, int width, int bottom_y, int target_x, int target_bottom_y);
+int patrolBlocked(GAME *game, int world_x, int width, int bottom_y, int direction);
 int onGroundSoldier(GAME *game, Soldier *soldier);
 int onGroundSoldier2(GAME *game, Soldier2 *soldier);
 int onGroundEntity(GAME *game, SDL_Rect *position, int world_x);
@@ -0,0 +1,77 @@
+#ifndef NAVGRAPH_H
+#define NAVGRAPH_H
+
+#include "colmap.h"
+
+#define NAV_STEP 20             // Largest height change between neighbouring columns of one platform (placeOnGround range)
+#define NAV_JUMP_SAMPLE 16      // Column spacing used when searching for jump take-off and landing points
+#define NAV_CACHE_SIZE 64
+#define NAV_REPLAN_FRAMES 15    // AI re-queries its route this often
+
+// Ways to leave a platform; also used as the `allowed` mask of navNextEdge()
+typedef enum {
+    NAV_WALK = 1,   // Step onto a platform that touches this one
+    NAV_DROP = 2,   // Walk off the end and fall onto a lower platform
+    NAV_JUMP = 4    // Jump across a gap or up to a platform within JUMP_POWER / GRAVITY reach; built on
+                    // the first query that allows them, since finding them compares every platform pair
+} NavEdgeType;
+
+// Connected run of ground surfaces (span tops) that can be walked without leaving the ground
+typedef struct {
+    int x0, x1;             // Mask columns, inclusive
+    int surface;            // surfaceY[surface + x - x0] is the surface row at column x
+    int firstEdge, numEdges;
+} NavPlatform;
+
+typedef struct {
+    int from, to;           // Platform indices
+    int fromX, toX;         // Leave `from` at column fromX, arrive on `to` at column toX
+    NavEdgeType type;
+} NavEdge;
+
+typedef struct {
+    int start, goal, allowed;
+    int edge;               // First edge of the route, -1 when there is none
+} NavRoute;
+
+typedef struct {
+    NavPlatform *platforms;
+    int numPlatforms;
+    NavEdge *edges;         // Sorted by `from`
+    int numEdges, edgeCapacity;
+    int maxJumpHeight, maxJumpReach;
+    int haveJumpEdges;
+    int *surfaceY;
+    int *spanPlatform;      // Platform whose surface is the top of each GroundSpan in the collision map
+    int *cost, *entryX, *cameFrom;   // A* scratch, one entry per platform
+    Uint8 *closed;
+    NavRoute cache[NAV_CACHE_SIZE];
+} NavGraph;
+
+typedef enum {
+    NAV_AGENT_DIRECT,       // Same platform as the target (or either is airborne): walk straight at it
+    NAV_AGENT_CROSS,        // Walk in `direction` until the whole body is past waypointX
+    NAV_AGENT_HOLD          // No route: follow the target along `platform` but stop at its ends
+} NavAgentMode;
+
+// Per-entity route state, zero it when the entity spawns
+typedef struct {
+    int timer;              // Frames until the next query
+    NavAgentMode mode;
+    int waypointX;          // First column on the next platform
+    int direction;
+    int platform;
+} NavAgent;
+
+int buildNavGraph(NavGraph *nav, const CollisionMap *map, int maxJumpHeight, int maxJumpReach);
+void freeNavGraph(NavGraph *nav);
+
+// Platform the entity at column x with feet at mask row feet_y stands on or will land on, or -1
+int navPlatformAt(const NavGraph *nav, const CollisionMap *map, int x, int feet_y);
+
+// First edge on the cheapest route from platform start (entered at startX) to goal using only `allowed`
+// edge types; -1 when the goal cannot be reached. Results are cached per (start, goal, allowed).
+// The first query allowing NAV_JUMP adds the jump edges to the graph and drops the cached routes.
+int navNextEdge(NavGraph *nav, int start, int startX, int goal, int goalX, int allowed);
+
+#endif
@@ -20,6 +20,7 @@ typedef struct {
     int frame;
     int speed;
     int dialogueActive;
+    int trigger;            // Talk-range handle in game->triggers
     int dialogueLine;
     int dialogueFrame;
     Uint32 lastMoveTime;
@@ -0,0 +1,16 @@
+#ifndef PIXELKERNELS_H
+#define PIXELKERNELS_H
+
+#include <SDL/SDL.h>
+
+// Row kernels for sprite sheet processing. x86 builds use SSE2, and AVX2 when the CPU reports it
+// at run time; other targets get the scalar loops. All of them handle any count and alignment.
+
+// dst[i] = src[count - 1 - i]; dst and src must not overlap
+void reversePixels32(Uint32 *dst, const Uint32 *src, int count);
+
+// Zeroes every pixel whose (pixel & rgbMask) equals key, the way SDL_ConvertSurface() leaves
+// colorkeyed pixels of an RGBA conversion: fully transparent black. Returns how many it cleared.
+int clearKeyedPixels32(Uint32 *pixels, int count, Uint32 rgbMask, Uint32 key);
+
+#endif
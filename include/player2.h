@@ -37,8 +37,7 @@ typedef struct {
     Player2State etat;
     int lookingRight;
     int frame_actuelle;
-    SDL_Surface *spriteSheet;
-    SDL_Surface *spriteSheetFlipped;
+    SDL_Surface *spriteSheet;   // Drawn mirrored with blitMirrored() when facing left
     SDL_Rect frame;
     int frame_max;
     int health;
@@ -37,7 +37,7 @@ extern int isSelectionMade;
 
 void PlayerMenu_Init();
 int PlayerMenu_HandleEvents(SDL_Event *event);
-void PlayerMenu_Render(SDL_Surface *screen);
+int PlayerMenu_Render(SDL_Surface *screen);      // 0 when nothing changed since the last call
 void PlayerMenu_Cleanup();
 
 #define PLAYER_MENU_CONTINUE 1
@@ -10,6 +10,7 @@ typedef struct {
     int frame;              
     int totalFrames;        
     int active;             
+    int trigger;            // Handle in game->triggers while active, -1 otherwise
 } Portal;
 
 void initPortal(Portal* portal, int x, int y);
@@ -3,6 +3,7 @@
 
 #include <SDL/SDL.h>
 #include "utils.h"
+#include "navgraph.h"
 
 // Forward declaration
 struct GAME;
@@ -44,8 +45,11 @@ typedef struct {
     int damageCooldown;
     int activationZone;
     int fireZone;
+    int seesPlayer;
+    int losTimer;
     int patrolDirection;
     int patrolTimer;
+    NavAgent nav;
     int patrolLeft;    // Added for patrol boundaries
     int patrolRight;   // Added for patrol boundaries
     int specialCooldown; // Added for special attack cooldown
@@ -54,21 +58,13 @@ typedef struct {
 
 // Global sprite sheets
 extern SDL_Surface* robot_idleSheet;
-extern SDL_Surface* robot_idleSheetFlipped;
 extern SDL_Surface* robot_walkSheet;
-extern SDL_Surface* robot_walkSheetFlipped;
 extern SDL_Surface* robot_attack1Sheet;
-extern SDL_Surface* robot_attack1SheetFlipped;
 extern SDL_Surface* robot_attack3Sheet;
-extern SDL_Surface* robot_attack3SheetFlipped;
 extern SDL_Surface* robot_specialSheet;
-extern SDL_Surface* robot_specialSheetFlipped;
 extern SDL_Surface* robot_hurtSheet;
-extern SDL_Surface* robot_hurtSheetFlipped;
 extern SDL_Surface* robot_deathSheet;
-extern SDL_Surface* robot_deathSheetFlipped;
 extern SDL_Surface* robot_projectileSheet;
-extern SDL_Surface* robot_projectileSheetFlipped;
 
 void initRobot(Robot* robot, int x, int y);
 void updateRobot(Robot* robot, SDL_Rect playerPosition, int* playerHealth, int playerMaxHealth, struct GAME *game);
@@ -4,6 +4,7 @@
 #include <SDL/SDL.h>
 #include "utils.h"
 #include "constants.h"
+#include "navgraph.h"
 
 
 struct GAME;
@@ -65,8 +66,11 @@ typedef struct {
     int frameDelay;
     int activationZone;
     int fireZone;
+    int seesPlayer;         // Line of sight to the player, refreshed every LOS_CHECK_FRAMES
+    int losTimer;
     int patrolDirection;
     int patrolTimer;
+    NavAgent nav;           // Chase route, see chaseDirection()
     Explosion explosion;
 } Soldier;
 
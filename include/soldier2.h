@@ -4,6 +4,7 @@
 #include <SDL/SDL.h>
 #include "utils.h"
 #include "constants.h"
+#include "navgraph.h"
 
 struct GAME;
 
@@ -44,6 +45,9 @@ typedef struct {
     int frameDelay;
     int patrolDirection;
     int patrolTimer;
+    NavAgent nav;
+    int seesPlayer;
+    int losTimer;
     int patrolLeft;
     int patrolRight;
     int grenadeCooldown;
@@ -0,0 +1,17 @@
+#ifndef SPRITEBLIT_H
+#define SPRITEBLIT_H
+
+#include <SDL/SDL.h>
+
+// Draws srcrect of src horizontally mirrored, the way SDL_BlitSurface() would draw it from a
+// horizontally flipped copy: srcrect is in the mirrored sheet's coordinates, so frame N of a sheet
+// laid out left to right is at (w - (N + 1) * frame width). Clips and updates dstrect like SDL_BlitSurface(),
+// follows SDL's per-pixel alpha / surface alpha / colorkey rules, and marks screen areas dirty.
+// src should not be SDL_RLEACCEL: locking an RLE surface decodes it on every call.
+int blitMirrored(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst, SDL_Rect *dstrect);
+
+// trackedBlit() when mirrored is 0, blitMirrored() otherwise; sheets packed into the sprite atlas
+// are drawn from their pages
+int blitSprite(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst, SDL_Rect *dstrect, int mirrored);
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef SPRITEMASK_H
+#define SPRITEMASK_H
+
+#include <SDL/SDL.h>
+
+#define MAX_SPRITE_MASKS 128
+
+// 1-bit opacity of a whole sprite sheet, 64 pixels per row word
+typedef struct {
+    int w, h;
+    int words;      // Uint64 words per row, including one zero word of padding
+    Uint64 *rows;   // Bit (x & 63) of rows[y * words + (x >> 6)] is set when pixel (x, y) is opaque
+} SpriteMask;
+
+SpriteMask *createSpriteMask(SDL_Surface *surface);
+SpriteMask *mirrorSpriteMask(const SpriteMask *mask);   // Mask of the horizontally flipped sheet
+void freeSpriteMask(SpriteMask *mask);
+int spriteMaskCollision(const SpriteMask *mask1, const SDL_Rect *rect1, const SDL_Rect *srcRect1,
+                        const SpriteMask *mask2, const SDL_Rect *rect2, const SDL_Rect *srcRect2);
+
+// Opacity test used by the masks: not the colorkey and not fully transparent. Surface must be locked.
+int spritePixelOpaque(SDL_Surface *surface, int x, int y);
+
+// Sheets registered by their loaders get a mask, and one for the sheet drawn mirrored, that
+// pixelPerfectCollision() picks up
+void registerSpriteMask(SDL_Surface *surface);
+void releaseSpriteMask(SDL_Surface *surface);   // Call before SDL_FreeSurface()
+const SpriteMask *findSpriteMask(SDL_Surface *surface);
+const SpriteMask *findMirroredSpriteMask(SDL_Surface *surface);
+
+#endif
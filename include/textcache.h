@@ -0,0 +1,27 @@
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_ttf.h>
+
+#define MAX_CACHED_TEXTS 128
+#define TEXT_CACHE_BYTES (4 * 1024 * 1024)     // Pixel memory the cached surfaces may hold
+
+typedef enum {
+    TEXT_SOLID,             // TTF_RenderText_Solid()
+    TEXT_BLENDED,           // TTF_RenderText_Blended()
+    TEXT_UTF8_SOLID,        // TTF_RenderUTF8_Solid()
+    TEXT_UTF8_BLENDED       // TTF_RenderUTF8_Blended()
+} TextMode;
+
+// Rendered text keyed on (font, string, colour, mode), converted to the display format once.
+// Strings that repeat frame after frame are rasterized only on their first frame; the least
+// recently used entries go when the cache is over its memory cap or entry count.
+// The cache owns the surface: blit it right away and do not free it, since the next call may
+// evict it. Returns NULL if rendering fails.
+SDL_Surface *cachedText(TTF_Font *font, const char *text, SDL_Color color, TextMode mode);
+
+// Drops every entry of a font; call before TTF_CloseFont()
+void releaseTextFont(TTF_Font *font);
+
+#endif
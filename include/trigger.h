@@ -0,0 +1,51 @@
+#ifndef TRIGGER_H
+#define TRIGGER_H
+
+#include <SDL/SDL.h>
+#include "colmap.h"
+
+#define TRIGGER_MAX_INSIDE 16   // Volumes the player can overlap at once
+
+struct GAME;
+
+typedef enum {
+    TRIGGER_ENTER,
+    TRIGGER_STAY,
+    TRIGGER_EXIT
+} TriggerEvent;
+
+// id is the caller's value from addTrigger(); rect is a copy, so the callback may add or remove triggers
+typedef void (*TriggerCallback)(struct GAME *game, int id, SDL_Rect rect, TriggerEvent event);
+
+typedef struct {
+    SDL_Rect rect;          // World x, screen y, like the entity rects
+    int feet;               // Test the player's feet point instead of the whole body
+    int id;
+    int alive;
+    TriggerCallback callback;
+} Trigger;
+
+typedef struct {
+    Trigger *triggers;      // Indexed by handle; handles stay valid until resetTriggers()
+    int count, capacity;
+    int *order;             // Live handles sorted by rect.x
+    int numOrdered;
+    int maxWidth;           // Widest rect ever added, bounds the left end of an x query
+    int inside[TRIGGER_MAX_INSIDE];   // Handles overlapping the player after the last update
+    int numInside;
+} TriggerSet;
+
+void resetTriggers(TriggerSet *set);   // Drops every trigger without exit events
+void freeTriggers(TriggerSet *set);
+int addTrigger(TriggerSet *set, SDL_Rect rect, int feet, int id, TriggerCallback callback);   // Handle, or -1
+void moveTrigger(TriggerSet *set, int handle, SDL_Rect rect);
+void removeTrigger(TriggerSet *set, int handle);   // No exit event
+
+// One feet-tested trigger per cluster of `material` zones, grown by `radius` px; ids count from 0
+int addZoneTriggers(TriggerSet *set, const CollisionMap *map, Material material, int radius, TriggerCallback callback);
+
+// Raises exit, then enter, then stay events against the player's body and feet point.
+// Costs one binary search plus the volumes near the player, however many triggers exist.
+void updateTriggers(TriggerSet *set, struct GAME *game, SDL_Rect body, int feet_x, int feet_y);
+
+#endif
@@ -10,10 +10,14 @@ typedef struct {
     int direction;
 } Bullet;
 
-SDL_Surface* flipHorizontally(SDL_Surface *src);
+// SDL_DisplayFormatAlpha() with the colorkey applied by a vectorized pass instead of SDL's keyed blitter
+SDL_Surface* keyedDisplayFormatAlpha(SDL_Surface *surface);
 SDL_Color get_pixel(SDL_Surface *surface, int x, int y);
 int rectIntersect(const SDL_Rect *a, const SDL_Rect *b);
 int pixelPerfectCollision(SDL_Surface *surface1, SDL_Rect *rect1, SDL_Rect *srcRect1,
                          SDL_Surface *surface2, SDL_Rect *rect2, SDL_Rect *srcRect2);
+// Same, with either sheet taken as drawn by blitMirrored(): its srcRect is in mirrored coordinates
+int mirroredPixelCollision(SDL_Surface *surface1, int mirrored1, SDL_Rect *rect1, SDL_Rect *srcRect1,
+                           SDL_Surface *surface2, int mirrored2, SDL_Rect *rect2, SDL_Rect *srcRect2);
 
 #endif
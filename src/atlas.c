@@ -0,0 +1,344 @@
+#include "atlas.h"
+#include "spriteblit.h"
+#include "dirtyrect.h"
+#include "utils.h"
+#include "pixelkernels.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    SDL_Surface *surface;
+    int shelfX, shelfY, shelfH;     // The open shelf; the ones above it are full
+    int sheets;                     // Packed sheets with cells here; the page is freed at 0
+} AtlasPage;
+
+static AtlasPage pages[MAX_ATLAS_PAGES];
+static AtlasSheet atlasSheets[MAX_ATLAS_SHEETS];
+static int numAtlasSheets = 0;
+static SDL_PixelFormat pageFormat;
+static int havePageFormat = 0;
+
+// Pages use whatever layout SDL_DisplayFormatAlpha() picks for this screen
+static int loadPageFormat(void) {
+    if (havePageFormat) return 1;
+    SDL_Surface *probe = SDL_CreateRGBSurface(SDL_SWSURFACE, 1, 1, 32, 0, 0, 0, 0);
+    SDL_Surface *converted = probe ? SDL_DisplayFormatAlpha(probe) : NULL;
+    if (probe) SDL_FreeSurface(probe);
+    if (!converted) {
+        fprintf(stderr, "loadPageFormat: SDL_DisplayFormatAlpha failed: %s\n", SDL_GetError());
+        return 0;
+    }
+    pageFormat = *converted->format;
+    pageFormat.palette = NULL;
+    SDL_FreeSurface(converted);
+    havePageFormat = 1;
+    return 1;
+}
+
+static void freePage(int p) {
+    if (pages[p].surface) SDL_FreeSurface(pages[p].surface);
+    memset(&pages[p], 0, sizeof(pages[p]));
+}
+
+// Shelf packing: cells go left to right on the open shelf of the first page with room for them
+static int allocCell(int w, int h, int *page, int *x, int *y) {
+    for (int p = 0; p < MAX_ATLAS_PAGES; p++) {
+        AtlasPage *pg = &pages[p];
+        if (!pg->surface) {
+            pg->surface = SDL_CreateRGBSurface(SDL_SWSURFACE, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE, 32,
+                                               pageFormat.Rmask, pageFormat.Gmask, pageFormat.Bmask, pageFormat.Amask);
+            if (!pg->surface) {
+                fprintf(stderr, "allocCell: Failed to create atlas page %d: %s\n", p, SDL_GetError());
+                return 0;
+            }
+        }
+        if (pg->shelfX + w > ATLAS_PAGE_SIZE) {
+            if (pg->shelfY + pg->shelfH + h > ATLAS_PAGE_SIZE) continue;
+            pg->shelfY += pg->shelfH;
+            pg->shelfX = 0;
+            pg->shelfH = 0;
+        }
+        if (pg->shelfY + h > ATLAS_PAGE_SIZE) continue;
+        *page = p;
+        *x = pg->shelfX;
+        *y = pg->shelfY;
+        pg->shelfX += w;
+        if (h > pg->shelfH) pg->shelfH = h;
+        return 1;
+    }
+    return 0;
+}
+
+static int inPageFormat(const SDL_Surface *surface) {
+    const SDL_PixelFormat *f = surface->format;
+    return f->BytesPerPixel == 4 && f->Rmask == pageFormat.Rmask && f->Gmask == pageFormat.Gmask &&
+           f->Bmask == pageFormat.Bmask && f->Amask == pageFormat.Amask;
+}
+
+// Bounding box of the pixels with any alpha in a cell of a page-format surface, relative to the cell
+static int opaqueBounds(const SDL_Surface *source, int sx, int sy, int w, int h, SDL_Rect *box) {
+    Uint32 amask = source->format->Amask;
+    int x0 = w, x1 = 0, y0 = h, y1 = 0;
+    for (int y = 0; y < h; y++) {
+        const Uint32 *row = (const Uint32 *)((const Uint8 *)source->pixels + (sy + y) * source->pitch) + sx;
+        int first = 0, last = w - 1;
+        while (first < w && !(row[first] & amask)) first++;
+        if (first == w) continue;
+        while (!(row[last] & amask)) last--;
+        if (first < x0) x0 = first;
+        if (last + 1 > x1) x1 = last + 1;
+        if (y < y0) y0 = y;
+        y1 = y + 1;
+    }
+    if (x0 >= x1) return 0;
+    *box = (SDL_Rect){x0, y0, x1 - x0, y1 - y0};
+    return 1;
+}
+
+// Splits each row of a frame's box on its page into runs of opaque and of translucent pixels
+static int encodeSpans(AtlasFrame *frame, const SDL_Surface *page) {
+    Uint32 amask = pageFormat.Amask, opaque = amask;
+    int count = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        count = 0;
+        for (int y = 0; y < frame->rect.h; y++) {
+            const Uint32 *row = (const Uint32 *)((const Uint8 *)page->pixels + (frame->rect.y + y) * page->pitch) + frame->rect.x;
+            if (pass) frame->rowSpans[y] = count;
+            for (int x = 0; x < frame->rect.w;) {
+                Uint32 a = row[x] & amask;
+                int start = x;
+                while (x < frame->rect.w && (row[x] & amask) == a) x++;
+                if (!a) continue;
+                // Translucent pixels of different alphas still share a run
+                while (a != opaque && x < frame->rect.w && (row[x] & amask) && (row[x] & amask) != opaque) x++;
+                if (pass) frame->spans[count] = (AtlasSpan){start, x - start, a == opaque};
+                count++;
+            }
+        }
+        if (!pass) {
+            frame->spans = malloc((count ? count : 1) * sizeof(AtlasSpan));
+            frame->rowSpans = malloc((frame->rect.h + 1) * sizeof(int));
+            if (!frame->spans || !frame->rowSpans) return 0;
+        }
+    }
+    frame->rowSpans[frame->rect.h] = count;
+    return 1;
+}
+
+static void freeFrames(AtlasSheet *packed) {
+    if (!packed->frames) return;
+    for (int i = 0; i < packed->columns * packed->rows; i++) {
+        free(packed->frames[i].spans);
+        free(packed->frames[i].rowSpans);
+    }
+    free(packed->frames);
+    packed->frames = NULL;
+}
+
+int packSpriteSheet(SDL_Surface *sheet, int cellW, int cellH) {
+    if (!sheet || cellW <= 0 || cellH <= 0) return 0;
+    if (findAtlasSheet(sheet)) return 1;
+    // Surface alpha, or an alpha channel SDL is told to ignore, has no per-pixel alpha equivalent;
+    // RLE and hardware sheets keep no plain pixels to copy
+    int alphaMismatch = ((sheet->flags & SDL_SRCALPHA) != 0) != (sheet->format->Amask != 0);
+    if (!sheet->pixels || alphaMismatch || (sheet->flags & (SDL_HWSURFACE | SDL_RLEACCEL | SDL_RLEACCELOK))) {
+        return 0;
+    }
+    if (cellW > sheet->w) cellW = sheet->w;
+    if (cellH > sheet->h) cellH = sheet->h;
+    if (cellW > ATLAS_PAGE_SIZE || cellH > ATLAS_PAGE_SIZE || !loadPageFormat()) return 0;
+    if (numAtlasSheets == MAX_ATLAS_SHEETS) {
+        fprintf(stderr, "packSpriteSheet: Sheet table full, sheet is drawn directly\n");
+        return 0;
+    }
+
+    // Colorkeyed and opaque sheets become per-pixel alpha, which SDL draws the same way
+    SDL_Surface *source = inPageFormat(sheet) ? sheet : keyedDisplayFormatAlpha(sheet);
+    if (!source) return 0;
+
+    AtlasSheet packed = {sheet, sheet->w, sheet->h, cellW, cellH,
+                         (sheet->w + cellW - 1) / cellW, (sheet->h + cellH - 1) / cellH, NULL};
+    packed.frames = calloc(packed.columns * packed.rows, sizeof(AtlasFrame));
+    int ok = packed.frames != NULL;
+    long cellPixels = 0, keptPixels = 0;
+    if (SDL_MUSTLOCK(source)) SDL_LockSurface(source);
+    for (int row = 0; ok && row < packed.rows; row++) {
+        for (int col = 0; ok && col < packed.columns; col++) {
+            AtlasFrame *frame = &packed.frames[row * packed.columns + col];
+            int sx = col * cellW, sy = row * cellH, px, py;
+            int w = sx + cellW <= sheet->w ? cellW : sheet->w - sx;
+            int h = sy + cellH <= sheet->h ? cellH : sheet->h - sy;
+            SDL_Rect box;
+            cellPixels += w * h;
+            if (!opaqueBounds(source, sx, sy, w, h, &box)) {
+                frame->page = -1;
+                continue;
+            }
+            if (!allocCell(box.w, box.h, &frame->page, &px, &py)) {
+                ok = 0;
+                break;
+            }
+            frame->rect = (SDL_Rect){px, py, box.w, box.h};
+            frame->offsetX = box.x;
+            frame->offsetY = box.y;
+            keptPixels += box.w * box.h;
+            SDL_Surface *page = pages[frame->page].surface;
+            for (int y = 0; y < box.h; y++) {
+                memcpy((Uint8 *)page->pixels + (py + y) * page->pitch + px * 4,
+                       (const Uint8 *)source->pixels + (sy + box.y + y) * source->pitch + (sx + box.x) * 4, box.w * 4);
+            }
+            ok = encodeSpans(frame, page);
+        }
+    }
+    if (SDL_MUSTLOCK(source)) SDL_UnlockSurface(source);
+    if (source != sheet) SDL_FreeSurface(source);
+
+    if (!ok) {
+        fprintf(stderr, "packSpriteSheet: Atlas full, %dx%d sheet is drawn directly\n", sheet->w, sheet->h);
+        freeFrames(&packed);
+        for (int p = 0; p < MAX_ATLAS_PAGES; p++) {
+            if (pages[p].surface && pages[p].sheets == 0) freePage(p);
+        }
+        return 0;
+    }
+
+    int used[MAX_ATLAS_PAGES] = {0};
+    for (int i = 0; i < packed.columns * packed.rows; i++) {
+        if (packed.frames[i].page >= 0) used[packed.frames[i].page] = 1;
+    }
+    for (int p = 0; p < MAX_ATLAS_PAGES; p++) pages[p].sheets += used[p];
+    atlasSheets[numAtlasSheets++] = packed;
+    printf("Packed %dx%d sheet: %ld of %ld pixels kept after trimming (%ld%%)\n", sheet->w, sheet->h,
+           keptPixels, cellPixels, cellPixels ? keptPixels * 100 / cellPixels : 0);
+    return 1;
+}
+
+void unpackSpriteSheet(SDL_Surface *sheet) {
+    for (int i = 0; i < numAtlasSheets; i++) {
+        if (atlasSheets[i].sheet == sheet) {
+            int used[MAX_ATLAS_PAGES] = {0};
+            for (int f = 0; f < atlasSheets[i].columns * atlasSheets[i].rows; f++) {
+                if (atlasSheets[i].frames[f].page >= 0) used[atlasSheets[i].frames[f].page] = 1;
+            }
+            for (int p = 0; p < MAX_ATLAS_PAGES; p++) {
+                if (used[p] && --pages[p].sheets == 0) freePage(p);
+            }
+            freeFrames(&atlasSheets[i]);
+            atlasSheets[i] = atlasSheets[--numAtlasSheets];
+            return;
+        }
+    }
+}
+
+const AtlasSheet *findAtlasSheet(SDL_Surface *sheet) {
+    for (int i = 0; i < numAtlasSheets; i++) {
+        if (atlasSheets[i].sheet == sheet) return &atlasSheets[i];
+    }
+    return NULL;
+}
+
+// The span blitter writes page pixels straight into the target, so it needs the same RGB layout
+static int spanTarget(const SDL_Surface *dst) {
+    const SDL_PixelFormat *f = dst->format;
+    return f->BytesPerPixel == 4 && !f->Amask && f->Rmask == pageFormat.Rmask && f->Gmask == pageFormat.Gmask &&
+           f->Bmask == pageFormat.Bmask && f->Gmask == 0x0000FF00 && (f->Rmask | f->Bmask) == 0x00FF00FF;
+}
+
+// Draws part (page coordinates, inside the frame's box) at to. Opaque spans are plain copies,
+// reversed for a mirrored frame; the page's alpha byte lands in the target's unused byte.
+static int blitSpans(const AtlasFrame *frame, const SDL_Surface *page, const SDL_Rect *part, SDL_Surface *dst,
+                     const SDL_Rect *to, int mirrored) {
+    int sx = part->x, sy = part->y, w = part->w, h = part->h, dx = to->x, dy = to->y, c;
+    const SDL_Rect *clip = &dst->clip_rect;
+    if ((c = clip->x - dx) > 0) { dx += c; w -= c; if (!mirrored) sx += c; }
+    if ((c = dx + w - clip->x - clip->w) > 0) { w -= c; if (mirrored) sx += c; }
+    if ((c = clip->y - dy) > 0) { dy += c; sy += c; h -= c; }
+    if ((c = dy + h - clip->y - clip->h) > 0) h -= c;
+    if (w <= 0 || h <= 0) return 0;
+    if (SDL_MUSTLOCK(dst) && SDL_LockSurface(dst) < 0) return -1;
+
+    Uint32 amask = pageFormat.Amask, ashift = pageFormat.Ashift;
+    int x0 = sx - frame->rect.x, x1 = x0 + w;     // Box columns being drawn
+    for (int y = 0; y < h; y++) {
+        int row = sy - frame->rect.y + y;
+        const Uint32 *src = (const Uint32 *)((const Uint8 *)page->pixels + (sy + y) * page->pitch) + frame->rect.x;
+        Uint32 *d = (Uint32 *)((Uint8 *)dst->pixels + (dy + y) * dst->pitch) + dx;
+        for (int i = frame->rowSpans[row]; i < frame->rowSpans[row + 1]; i++) {
+            const AtlasSpan *span = &frame->spans[i];
+            if (span->x >= x1) break;
+            int a = span->x > x0 ? span->x : x0, b = span->x + span->w < x1 ? span->x + span->w : x1;
+            if (a >= b) continue;
+            Uint32 *out = d + (mirrored ? x1 - b : a - x0);
+            if (span->opaque) {
+                if (mirrored) reversePixels32(out, src + a, b - a);
+                else memcpy(out, src + a, (b - a) * 4);
+                continue;
+            }
+            for (int k = 0; k < b - a; k++) {
+                // Same arithmetic as SDL's 32-bit alpha blitters, two channels at a time
+                Uint32 p = mirrored ? src[b - 1 - k] : src[a + k], q = out[k];
+                Uint32 alpha = (p & amask) >> ashift;
+                Uint32 rb = ((q & 0xFF00FF) + (((p & 0xFF00FF) - (q & 0xFF00FF)) * alpha >> 8)) & 0xFF00FF;
+                Uint32 g = ((q & 0xFF00) + (((p & 0xFF00) - (q & 0xFF00)) * alpha >> 8)) & 0xFF00;
+                out[k] = rb | g;
+            }
+        }
+    }
+
+    if (SDL_MUSTLOCK(dst)) SDL_UnlockSurface(dst);
+    if (dst == dirtyRenderer.screen) markDirty((SDL_Rect){dx, dy, w, h});
+    return 0;
+}
+
+int blitAtlasSheet(const AtlasSheet *packed, SDL_Rect *srcrect, SDL_Surface *dst, SDL_Rect *dstrect, int mirrored) {
+    if (!packed || !dst) return -1;
+    int sx = srcrect ? srcrect->x : 0, sy = srcrect ? srcrect->y : 0;
+    int w = srcrect ? srcrect->w : packed->w, h = srcrect ? srcrect->h : packed->h;
+    int dx = dstrect ? dstrect->x : 0, dy = dstrect ? dstrect->y : 0;
+
+    // Clip to the sheet like SDL_UpperBlit(), in the coordinates srcrect was given in
+    if (sx < 0) { w += sx; dx -= sx; sx = 0; }
+    if (sx + w > packed->w) w = packed->w - sx;
+    if (sy < 0) { h += sy; dy -= sy; sy = 0; }
+    if (sy + h > packed->h) h = packed->h - sy;
+
+    int result = 0, fast = spanTarget(dst);
+    if (w > 0 && h > 0) {
+        int left = mirrored ? packed->w - sx - w : sx;    // The area in the sheet's own coordinates
+        for (int row = sy / packed->cellH; row * packed->cellH < sy + h; row++) {
+            for (int col = left / packed->cellW; col * packed->cellW < left + w; col++) {
+                const AtlasFrame *frame = &packed->frames[row * packed->columns + col];
+                if (frame->page < 0) continue;
+                // Only the trimmed box is drawn; the rest of the cell is transparent anyway
+                int boxX = col * packed->cellW + frame->offsetX, boxY = row * packed->cellH + frame->offsetY;
+                int x0 = left > boxX ? left : boxX;
+                int x1 = left + w < boxX + frame->rect.w ? left + w : boxX + frame->rect.w;
+                int y0 = sy > boxY ? sy : boxY;
+                int y1 = sy + h < boxY + frame->rect.h ? sy + h : boxY + frame->rect.h;
+                if (x0 >= x1 || y0 >= y1) continue;
+                SDL_Surface *page = pages[frame->page].surface;
+                SDL_Rect part = {frame->rect.x + x0 - boxX, frame->rect.y + y0 - boxY, x1 - x0, y1 - y0};
+                SDL_Rect to = {dx + (mirrored ? left + w - x1 : x0 - left), dy + y0 - sy, 0, 0};
+                if (fast) {
+                    if (blitSpans(frame, page, &part, dst, &to, mirrored) < 0) result = -1;
+                } else if (mirrored) {
+                    part.x = page->w - part.x - part.w;
+                    if (blitMirrored(page, &part, dst, &to) < 0) result = -1;
+                } else if (trackedBlit(page, &part, dst, &to) < 0) {
+                    result = -1;
+                }
+            }
+        }
+    }
+
+    // Report the drawn area like SDL_BlitSurface() does
+    if (dstrect) {
+        const SDL_Rect *clip = &dst->clip_rect;
+        int x0 = dx > clip->x ? dx : clip->x, y0 = dy > clip->y ? dy : clip->y;
+        int x1 = dx + w < clip->x + clip->w ? dx + w : clip->x + clip->w;
+        int y1 = dy + h < clip->y + clip->h ? dy + h : clip->y + clip->h;
+        *dstrect = (SDL_Rect){x0, y0, x1 > x0 && w > 0 ? x1 - x0 : 0, y1 > y0 && h > 0 ? y1 - y0 : 0};
+    }
+    return result;
+}
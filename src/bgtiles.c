@@ -0,0 +1,203 @@
+#include "bgtiles.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int allocTiles(TiledBackground *bg, int width, int height, int tileWidth) {
+    memset(bg, 0, sizeof(*bg));
+    bg->width = width;
+    bg->height = height;
+    bg->tileWidth = tileWidth;
+    bg->numTiles = (width + tileWidth - 1) / tileWidth;
+    bg->direction = 1;
+    bg->tiles = calloc(bg->numTiles, sizeof(SDL_Surface *));
+    bg->lastUsed = calloc(bg->numTiles, sizeof(Uint32));
+    if (!bg->tiles || !bg->lastUsed) {
+        fprintf(stderr, "allocTiles: Out of memory for %d columns\n", bg->numTiles);
+        freeTiledBackground(bg);
+        return 0;
+    }
+    return 1;
+}
+
+// Converts to the screen format when there is a screen; the cooker runs without one
+static SDL_Surface *optimizeTile(SDL_Surface *tile) {
+    if (!tile || !SDL_GetVideoSurface()) return tile;
+    SDL_Surface *optimized = SDL_DisplayFormat(tile);
+    if (!optimized) {
+        fprintf(stderr, "optimizeTile: SDL_DisplayFormat failed: %s\n", SDL_GetError());
+        return tile;
+    }
+    SDL_FreeSurface(tile);
+    return optimized;
+}
+
+int splitTiledBackground(TiledBackground *bg, SDL_Surface *image, int tileWidth) {
+    if (!bg || !image || tileWidth <= 0) return 0;
+    if (!allocTiles(bg, image->w, image->h, tileWidth)) return 0;
+
+    // Copy pixels as they are instead of blending them onto the empty columns
+    SDL_SetAlpha(image, 0, SDL_ALPHA_OPAQUE);
+    SDL_SetColorKey(image, 0, 0);
+    for (int i = 0; i < bg->numTiles; i++) {
+        SDL_Rect src = {i * tileWidth, 0, tileWidth, image->h};
+        if (src.x + src.w > image->w) src.w = image->w - src.x;
+        SDL_Surface *tile = SDL_CreateRGBSurface(SDL_SWSURFACE, src.w, src.h, 32,
+                                                 0x00FF0000, 0x0000FF00, 0x000000FF, 0);
+        if (!tile || SDL_BlitSurface(image, &src, tile, NULL) != 0) {
+            fprintf(stderr, "splitTiledBackground: Failed to copy column %d: %s\n", i, SDL_GetError());
+            if (tile) SDL_FreeSurface(tile);
+            freeTiledBackground(bg);
+            return 0;
+        }
+        bg->tiles[i] = optimizeTile(tile);
+        bg->resident++;
+    }
+    return 1;
+}
+
+// "assets/levels/level1.tiles" -> "assets/levels/level1_tile%03d.bmp"
+static int tilePatternFor(char *pattern, size_t size, const char *index_path) {
+    const char *slash = strrchr(index_path, '/');
+    const char *dot = strrchr(index_path, '.');
+    int base = (dot && (!slash || dot > slash)) ? (int)(dot - index_path) : (int)strlen(index_path);
+    return snprintf(pattern, size, "%.*s_tile%%03d.bmp", base, index_path) < (int)size;
+}
+
+int saveTiledBackground(const TiledBackground *bg, const char *index_path) {
+    char pattern[64], path[80];
+    if (!bg || !bg->tiles || !index_path || !tilePatternFor(pattern, sizeof(pattern), index_path)) {
+        fprintf(stderr, "saveTiledBackground: Background is not split or path is too long\n");
+        return 0;
+    }
+    for (int i = 0; i < bg->numTiles; i++) {
+        snprintf(path, sizeof(path), pattern, i);
+        if (!bg->tiles[i] || SDL_SaveBMP(bg->tiles[i], path) != 0) {
+            fprintf(stderr, "saveTiledBackground: Failed to write %s: %s\n", path, SDL_GetError());
+            return 0;
+        }
+    }
+
+    // The index goes last so an interrupted cook is never taken as current
+    FILE *file = fopen(index_path, "w");
+    if (!file) {
+        fprintf(stderr, "saveTiledBackground: Cannot open %s for writing\n", index_path);
+        return 0;
+    }
+    int ok = fprintf(file, "%s %d %d %d %d %d\n", BG_TILES_MAGIC, BG_TILES_VERSION,
+                     bg->width, bg->height, bg->tileWidth, bg->numTiles) > 0;
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) {
+        fprintf(stderr, "saveTiledBackground: Failed to write %s\n", index_path);
+        remove(index_path);
+    }
+    return ok;
+}
+
+int loadTiledBackground(TiledBackground *bg, const char *index_path) {
+    if (!bg || !index_path) return 0;
+    memset(bg, 0, sizeof(*bg));
+    FILE *file = fopen(index_path, "r");
+    if (!file) return 0;
+
+    char magic[16];
+    int version, width, height, tileWidth, numTiles;
+    int fields = fscanf(file, "%15s %d %d %d %d %d", magic, &version, &width, &height, &tileWidth, &numTiles);
+    fclose(file);
+    if (fields != 6 || strcmp(magic, BG_TILES_MAGIC) != 0 || version != BG_TILES_VERSION ||
+        width <= 0 || height <= 0 || tileWidth <= 0 || numTiles != (width + tileWidth - 1) / tileWidth) {
+        fprintf(stderr, "loadTiledBackground: %s is not a version %d tile index\n", index_path, BG_TILES_VERSION);
+        return 0;
+    }
+    if (!allocTiles(bg, width, height, tileWidth)) return 0;
+    if (!tilePatternFor(bg->tilePattern, sizeof(bg->tilePattern), index_path)) {
+        fprintf(stderr, "loadTiledBackground: Path %s is too long\n", index_path);
+        freeTiledBackground(bg);
+        return 0;
+    }
+    bg->cooked = 1;
+    return 1;
+}
+
+void freeTiledBackground(TiledBackground *bg) {
+    if (!bg) return;
+    if (bg->tiles) {
+        for (int i = 0; i < bg->numTiles; i++) {
+            if (bg->tiles[i]) SDL_FreeSurface(bg->tiles[i]);
+        }
+    }
+    if (bg->cooked && bg->loads) {
+        printf("Background columns: %d decoded, %d evicted\n", bg->loads, bg->evictions);
+    }
+    free(bg->tiles);
+    free(bg->lastUsed);
+    memset(bg, 0, sizeof(*bg));
+}
+
+// Decodes column i if needed and marks it used this frame; NULL when it cannot be loaded
+static SDL_Surface *useTile(TiledBackground *bg, int i) {
+    if (i < 0 || i >= bg->numTiles) return NULL;
+    bg->lastUsed[i] = bg->frame;
+    if (bg->tiles[i] || !bg->cooked) return bg->tiles[i];
+
+    char path[80];
+    snprintf(path, sizeof(path), bg->tilePattern, i);
+    SDL_Surface *tile = optimizeTile(SDL_LoadBMP(path));
+    if (!tile) {
+        fprintf(stderr, "useTile: Failed to load %s: %s\n", path, SDL_GetError());
+        return NULL;
+    }
+    bg->tiles[i] = tile;
+    bg->resident++;
+    bg->loads++;
+    return tile;
+}
+
+void updateTiledBackground(TiledBackground *bg, int scroll_x, int view_w) {
+    if (!bg || !bg->tiles) return;
+    bg->frame++;
+    // Keep the last direction while the camera stands still
+    if (scroll_x != bg->scroll_x) bg->direction = scroll_x > bg->scroll_x ? 1 : -1;
+    bg->scroll_x = scroll_x;
+
+    int first = scroll_x / bg->tileWidth;
+    int last = (scroll_x + view_w - 1) / bg->tileWidth;
+    for (int i = first; i <= last; i++) useTile(bg, i);
+    useTile(bg, bg->direction > 0 ? last + 1 : first - 1);
+
+    if (!bg->cooked) return;
+    while (bg->resident > BG_TILE_CACHE) {
+        int oldest = -1;
+        for (int i = 0; i < bg->numTiles; i++) {
+            if (bg->tiles[i] && bg->lastUsed[i] != bg->frame &&
+                (oldest < 0 || bg->lastUsed[i] < bg->lastUsed[oldest])) oldest = i;
+        }
+        if (oldest < 0) break;   // Everything resident is in use this frame
+        SDL_FreeSurface(bg->tiles[oldest]);
+        bg->tiles[oldest] = NULL;
+        bg->resident--;
+        bg->evictions++;
+    }
+}
+
+int blitTiledBackground(TiledBackground *bg, SDL_Rect src, SDL_Surface *dst, int x, int y) {
+    if (!bg || !bg->tiles || !dst) return -1;
+    int x0 = src.x > 0 ? src.x : 0;
+    int x1 = src.x + src.w < bg->width ? src.x + src.w : bg->width;
+    int h = src.y + src.h < bg->height ? src.h : bg->height - src.y;
+    if (x1 <= x0 || h <= 0 || src.y < 0) return 0;
+    x += x0 - src.x;
+
+    for (int i = x0 / bg->tileWidth; i * bg->tileWidth < x1; i++) {
+        int tileX = i * bg->tileWidth;
+        int from = x0 > tileX ? x0 : tileX;
+        int to = x1 < tileX + bg->tileWidth ? x1 : tileX + bg->tileWidth;
+        SDL_Surface *tile = useTile(bg, i);
+        if (tile) {
+            SDL_Rect part = {from - tileX, src.y, to - from, h};
+            SDL_Rect dest = {x + from - x0, y, to - from, h};
+            if (SDL_BlitSurface(tile, &part, dst, &dest) != 0) return -1;
+        }
+    }
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include "collision.h"
 #include "mouvement.h"
 #include "utils.h"
+#include "atlas.h"
 #include <SDL/SDL.h>
 #include <SDL/SDL_image.h>
 #include <stdio.h>
@@ -30,32 +31,25 @@ int clamp(int value, int min, int max) {
 
 // Get ground Y position at a given x coordinate
 int getGroundY(GAME* game, int x) {
-    if (!game || !game->background.levelCollision) {
-        fprintf(stderr, "getGroundY: Game or levelCollision is NULL\n");
+    if (!game || !game->background.collision.bits) {
+        fprintf(stderr, "getGroundY: Game or collision map is NULL\n");
         return SCREEN_HEIGHT - 512; // Fallback to boss height
     }
 
-    int y_offset = (SCREEN_HEIGHT - game->background.levelCollision->h) / 2;
-    int y_start = 0; // Start from top of collision map
-    int max_y = game->background.levelCollision->h;
+    int y_offset = game->background.collision.y_offset;
+    int max_y = game->background.collision.h;
 
-    if (x < 0 || x >= game->background.levelCollision->w) {
-        printf("getGroundY: Invalid x=%d for levelCollision width=%d\n", x, game->background.levelCollision->w);
+    if (x < 0 || x >= game->background.collision.w) {
+        printf("getGroundY: Invalid x=%d for collision map width=%d\n", x, game->background.collision.w);
         return SCREEN_HEIGHT - 512; // Fallback
     }
 
-    for (int y = y_start; y < max_y; y++) {
-        SDL_Color color = get_pixel(game->background.levelCollision, x, y);
-        if (color.r == 255 && color.g == 255 && color.b == 255) {
-            int ground_y = y + y_offset - 512;
-            printf("getGroundY: x=%d, ground_y=%d\n", x, ground_y);
-            return ground_y;
-        }
+    // Topmost ground surface in this column, straight from the precomputed spans
+    int y = collisionFirstSolidBelow(&game->background.collision, x, 0);
+    if (y >= 0) {
+        return y + y_offset - 512;
     }
-
-    int fallback_y = max_y + y_offset - 512;
-    printf("getGroundY: Fallback x=%d, y=%d\n", x, fallback_y);
-    return fallback_y; // Fallback to bottom
+    return max_y + y_offset - 512; // Fallback to bottom
 }
 
 void initVFX(VFX* vfx, const char* folder, int x, int y, int totalFrames, int frameWidth, int frameHeight, int frameDelayThreshold) {
@@ -85,6 +79,7 @@ void initVFX(VFX* vfx, const char* folder, int x, int y, int totalFrames, int fr
         SDL_Surface* optimized = SDL_DisplayFormatAlpha(frames[i]);
         SDL_FreeSurface(frames[i]);
         frames[i] = optimized;
+        if (optimized) packSpriteSheet(optimized, optimized->w, optimized->h);
     }
     vfx->frames = frames;
     vfx->totalFrames = totalFrames;
@@ -114,15 +109,18 @@ void renderVFX(SDL_Surface* screen, VFX* vfx, int scroll_x) {
     if (!screen || !vfx || !vfx->active || !vfx->frames[vfx->frame]) return;
     SDL_Rect src = {0, 0, vfx->frameWidth, vfx->frameHeight};
     SDL_Rect dest = {vfx->x - scroll_x, vfx->y, vfx->frameWidth, vfx->frameHeight};
-    if (SDL_BlitSurface(vfx->frames[vfx->frame], &src, screen, &dest) < 0) {
-        fprintf(stderr, "renderVFX: SDL_BlitSurface failed: %s\n", SDL_GetError());
+    if (blitSprite(vfx->frames[vfx->frame], &src, screen, &dest, 0) < 0) {
+        fprintf(stderr, "renderVFX: blitSprite failed: %s\n", SDL_GetError());
     }
 }
 
 void freeVFX(VFX* vfx) {
     if (!vfx) return;
     for (int i = 0; i < vfx->totalFrames; i++) {
-        if (vfx->frames[i]) SDL_FreeSurface(vfx->frames[i]);
+        if (vfx->frames[i]) {
+            unpackSpriteSheet(vfx->frames[i]);
+            SDL_FreeSurface(vfx->frames[i]);
+        }
     }
     free(vfx->frames);
     vfx->frames = NULL;
@@ -162,6 +160,7 @@ void initBoss(Boss* boss, int x, int y) {
         SDL_Surface* optimized = SDL_DisplayFormatAlpha(boss->idleFrames[i]);
         SDL_FreeSurface(boss->idleFrames[i]);
         boss->idleFrames[i] = optimized;
+        if (optimized) packSpriteSheet(optimized, optimized->w, optimized->h);
     }
     for (int i = 0; i < boss->walkFrameCount; i++) {
         char path[100];
@@ -175,6 +174,7 @@ void initBoss(Boss* boss, int x, int y) {
         SDL_Surface* optimized = SDL_DisplayFormatAlpha(boss->walkFrames[i]);
         SDL_FreeSurface(boss->walkFrames[i]);
         boss->walkFrames[i] = optimized;
+        if (optimized) packSpriteSheet(optimized, optimized->w, optimized->h);
     }
     for (int i = 0; i < boss->attackFrameCount; i++) {
         char path[100];
@@ -188,6 +188,7 @@ void initBoss(Boss* boss, int x, int y) {
         SDL_Surface* optimized = SDL_DisplayFormatAlpha(boss->attackFrames[i]);
         SDL_FreeSurface(boss->attackFrames[i]);
         boss->attackFrames[i] = optimized;
+        if (optimized) packSpriteSheet(optimized, optimized->w, optimized->h);
     }
     for (int i = 0; i < boss->takehitFrameCount; i++) {
         char path[100];
@@ -201,6 +202,7 @@ void initBoss(Boss* boss, int x, int y) {
         SDL_Surface* optimized = SDL_DisplayFormatAlpha(boss->takehitFrames[i]);
         SDL_FreeSurface(boss->takehitFrames[i]);
         boss->takehitFrames[i] = optimized;
+        if (optimized) packSpriteSheet(optimized, optimized->w, optimized->h);
     }
     for (int i = 0; i < boss->deathFrameCount; i++) {
         char path[100];
@@ -214,6 +216,7 @@ void initBoss(Boss* boss, int x, int y) {
         SDL_Surface* optimized = SDL_DisplayFormatAlpha(boss->deathFrames[i]);
         SDL_FreeSurface(boss->deathFrames[i]);
         boss->deathFrames[i] = optimized;
+        if (optimized) packSpriteSheet(optimized, optimized->w, optimized->h);
     }
     // Load level-up icon
     boss->levelUpIcon = IMG_Load("assets/items/Jump_Bonus_01.png");
@@ -233,6 +236,7 @@ void initBoss(Boss* boss, int x, int y) {
     }
     printf("Level-up icon loaded: w=%d, h=%d\n", boss->levelUpIcon->w, boss->levelUpIcon->h);
     SDL_SetColorKey(boss->levelUpIcon, SDL_SRCCOLORKEY, SDL_MapRGB(boss->levelUpIcon->format, 255, 0, 255));
+    packSpriteSheet(boss->levelUpIcon, boss->levelUpIcon->w, boss->levelUpIcon->h);
 
     boss->world_x = x;
     boss->y = y;
@@ -246,12 +250,14 @@ void initBoss(Boss* boss, int x, int y) {
     boss->invulnTimer = 0;
     boss->facingLeft = 0;
     boss->active = 1;
+    boss->onGround = 0;
     boss->attackCooldown = 0;
     boss->angry = 0;
     boss->hasDamagedThisAttack = 0;
     boss->levelUpIconActive = 0;
     boss->levelUpIconSpawnTime = 0;
     boss->levelUpFlickerCounter = 0;
+    boss->levelUpTrigger = -1;
     initVFX(&boss->umbrellaVFX, "assets/vfx/Umbrella", x, y, 14, UMBRELLA_FRAME_WIDTH, UMBRELLA_FRAME_HEIGHT, 5);
     initVFX(&boss->iceSlashVFX, "assets/vfx/IceSlash", x, y + 256, 9, SLASH_FRAME_WIDTH, SLASH_FRAME_HEIGHT, 5);
     for (int i = 0; i < 3; i++) {
@@ -263,6 +269,19 @@ void initBoss(Boss* boss, int x, int y) {
     printf("Boss initialized at x=%d, y=%d\n", x, y);
 }
 
+static void levelUpIconTrigger(GAME *game, int id, SDL_Rect rect, TriggerEvent event) {
+    (void)id;
+    (void)rect;
+    Boss *boss = &game->boss;
+    // Allow collection after 500ms to prevent instant pickup
+    if (event == TRIGGER_EXIT || SDL_GetTicks() - boss->levelUpIconSpawnTime <= 500) return;
+    game->player.score += 100;
+    boss->levelUpIconActive = 0;
+    removeTrigger(&game->triggers, boss->levelUpTrigger);
+    boss->levelUpTrigger = -1;
+    printf("Level-up icon collected, score=%d\n", game->player.score);
+}
+
 void updateBoss(Boss* boss, GAME* game) {
     if (!boss || !game) return;
 
@@ -272,15 +291,10 @@ void updateBoss(Boss* boss, GAME* game) {
         Uint32 elapsedTime = currentTime - boss->levelUpIconSpawnTime;
         if (elapsedTime >= 5000) { // Deactivate after 5 seconds
             boss->levelUpIconActive = 0;
+            removeTrigger(&game->triggers, boss->levelUpTrigger);
+            boss->levelUpTrigger = -1;
             printf("Level-up icon deactivated after 5 seconds\n");
         }
-        // Allow collection after 500ms to prevent instant pickup
-        SDL_Rect playerHitbox = {game->player.world_x, game->player.position.y, 258, 258};
-        if (elapsedTime > 500 && rectIntersect(&boss->levelUpIconPosition, &playerHitbox)) { // Changed: 500ms delay
-            game->player.score += 100;
-            boss->levelUpIconActive = 0;
-            printf("Level-up icon collected, score=%d\n", game->player.score);
-        }
     }
 
     if (!boss->active && !boss->levelUpIconActive) return;
@@ -300,6 +314,7 @@ void updateBoss(Boss* boss, GAME* game) {
                 boss->levelUpIconPosition.h = 392;
                 boss->levelUpIconSpawnTime = SDL_GetTicks();
                 boss->levelUpFlickerCounter = 0;
+                boss->levelUpTrigger = addTrigger(&game->triggers, boss->levelUpIconPosition, 0, 0, levelUpIconTrigger);
                 printf("Level-up icon spawned at x=%d, y=%d (groundY=%d, boss_x=%d)\n", 
                        boss->levelUpIconPosition.x, boss->levelUpIconPosition.y, groundY, boss->world_x);
             }
@@ -308,8 +323,8 @@ void updateBoss(Boss* boss, GAME* game) {
         return;
     }
 
-    if (!onGroundBoss(game, boss)) {
-        boss->y += (int)GRAVITY;
+    if (!boss->onGround) {
+        boss->y += sweepMove(game, boss->world_x, boss->position.w, boss->y + boss->position.h, (int)GRAVITY);
         boss->position.y = boss->y;
         placeBossOnGround(game, boss);
     }
@@ -475,7 +490,8 @@ void updateBoss(Boss* boss, GAME* game) {
             boss->invulnTimer = 30;
         }
     }
-    if (game->player.bulletActive && boss->invulnTimer <= 0) {
+    if (game->player.bulletActive && boss->invulnTimer <= 0 &&
+        (colliderContacts(&game->broadphase, COLLIDER_BOSS, 0) & CONTACT_BULLET)) {
         SDL_Rect bulletRect = {game->player.bullet.x, game->player.bullet.y, game->player.bullet.w, game->player.bullet.h};
         if (rectIntersect(&bulletRect, &boss->position)) {
             boss->health -= 15;
@@ -509,8 +525,8 @@ void renderBoss(SDL_Surface* screen, Boss* boss, int scroll_x, GAME* game) {
             // Clamp to screen bounds to ensure visibility
             iconDestRect.x = clamp(iconDestRect.x, scroll_x, scroll_x + SCREEN_WIDTH - 314);
             iconDestRect.y = clamp(iconDestRect.y, 0, SCREEN_HEIGHT - 392);
-            if (SDL_BlitSurface(boss->levelUpIcon, NULL, screen, &iconDestRect) < 0) {
-                fprintf(stderr, "renderBoss: SDL_BlitSurface failed for level-up icon: %s\n", SDL_GetError());
+            if (blitSprite(boss->levelUpIcon, NULL, screen, &iconDestRect, 0) < 0) {
+                fprintf(stderr, "renderBoss: blitSprite failed for level-up icon: %s\n", SDL_GetError());
             } else {
                 printf("Rendering level-up icon at screen_x=%d, screen_y=%d (world_x=%d, scroll_x=%d, elapsed=%u)\n", 
                        iconDestRect.x, iconDestRect.y, boss->levelUpIconPosition.x, scroll_x, elapsedTime);
@@ -539,14 +555,9 @@ void renderBoss(SDL_Surface* screen, Boss* boss, int scroll_x, GAME* game) {
             break;
     }
     if (frame) {
+        SDL_Rect src = {0, 0, frame->w, frame->h};
         SDL_Rect dest = {boss->world_x - scroll_x, boss->y, 0, 0};
-        if (boss->facingLeft) {
-            SDL_Surface* flipped = flipHorizontally(frame);
-            SDL_BlitSurface(flipped, NULL, screen, &dest);
-            SDL_FreeSurface(flipped);
-        } else {
-            SDL_BlitSurface(frame, NULL, screen, &dest);
-        }
+        blitSprite(frame, &src, screen, &dest, boss->facingLeft);
     }
     if (boss->state != BOSS_DEATH) {
         int boss_hb_x = SCREEN_WIDTH / 2 - 100;
@@ -554,10 +565,10 @@ void renderBoss(SDL_Surface* screen, Boss* boss, int scroll_x, GAME* game) {
         int boss_hb_width = 200;
         int boss_hb_height = 20;
         SDL_Rect boss_bgRect = {boss_hb_x, boss_hb_y, boss_hb_width, boss_hb_height};
-        SDL_FillRect(screen, &boss_bgRect, SDL_MapRGB(screen->format, 0, 0, 0));
+        trackedFill(screen, &boss_bgRect, SDL_MapRGB(screen->format, 0, 0, 0));
         int boss_health_width = (int)((boss->health / (float)boss->maxHealth) * boss_hb_width);
         SDL_Rect boss_healthRect = {boss_hb_x, boss_hb_y, boss_health_width, boss_hb_height};
-        SDL_FillRect(screen, &boss_healthRect, SDL_MapRGB(screen->format, 0, 0, 255));
+        trackedFill(screen, &boss_healthRect, SDL_MapRGB(screen->format, 0, 0, 255));
     }
     renderVFX(screen, &boss->iceSlashVFX, scroll_x);
     for (int i = 0; i < 3; i++) {
@@ -569,26 +580,44 @@ void renderBoss(SDL_Surface* screen, Boss* boss, int scroll_x, GAME* game) {
 void freeBoss(Boss* boss) {
     if (!boss) return;
     for (int i = 0; i < boss->idleFrameCount; i++) {
-        if (boss->idleFrames[i]) SDL_FreeSurface(boss->idleFrames[i]);
+        if (boss->idleFrames[i]) {
+            unpackSpriteSheet(boss->idleFrames[i]);
+            SDL_FreeSurface(boss->idleFrames[i]);
+        }
     }
     free(boss->idleFrames);
     for (int i = 0; i < boss->walkFrameCount; i++) {
-        if (boss->walkFrames[i]) SDL_FreeSurface(boss->walkFrames[i]);
+        if (boss->walkFrames[i]) {
+            unpackSpriteSheet(boss->walkFrames[i]);
+            SDL_FreeSurface(boss->walkFrames[i]);
+        }
     }
     free(boss->walkFrames);
     for (int i = 0; i < boss->attackFrameCount; i++) {
-        if (boss->attackFrames[i]) SDL_FreeSurface(boss->attackFrames[i]);
+        if (boss->attackFrames[i]) {
+            unpackSpriteSheet(boss->attackFrames[i]);
+            SDL_FreeSurface(boss->attackFrames[i]);
+        }
     }
     free(boss->attackFrames);
     for (int i = 0; i < boss->takehitFrameCount; i++) {
-        if (boss->takehitFrames[i]) SDL_FreeSurface(boss->takehitFrames[i]);
+        if (boss->takehitFrames[i]) {
+            unpackSpriteSheet(boss->takehitFrames[i]);
+            SDL_FreeSurface(boss->takehitFrames[i]);
+        }
     }
     free(boss->takehitFrames);
     for (int i = 0; i < boss->deathFrameCount; i++) {
-        if (boss->deathFrames[i]) SDL_FreeSurface(boss->deathFrames[i]);
+        if (boss->deathFrames[i]) {
+            unpackSpriteSheet(boss->deathFrames[i]);
+            SDL_FreeSurface(boss->deathFrames[i]);
+        }
     }
     free(boss->deathFrames);
-    if (boss->levelUpIcon) SDL_FreeSurface(boss->levelUpIcon);
+    if (boss->levelUpIcon) {
+        unpackSpriteSheet(boss->levelUpIcon);
+        SDL_FreeSurface(boss->levelUpIcon);
+    }
     freeVFX(&boss->iceSlashVFX);
     for (int i = 0; i < 3; i++) {
         freeVFX(&boss->frostExplosionVFX[i]);
@@ -598,26 +627,23 @@ void freeBoss(Boss* boss) {
 }
 
 void placeBossOnGround(GAME* game, Boss* boss) {
-    if (!game || !game->background.levelCollision || !boss) {
-        fprintf(stderr, "placeBossOnGround: Game, boss, or levelCollision is NULL\n");
+    if (!game || !game->background.collision.bits || !boss) {
+        fprintf(stderr, "placeBossOnGround: Game, boss, or collision map is NULL\n");
         return;
     }
     int x = boss->world_x + 256;
-    int y_offset = (SCREEN_HEIGHT - game->background.levelCollision->h) / 2;
+    int y_offset = game->background.collision.y_offset;
     int y_start = boss->y - y_offset;
-    if (x < 0 || x >= game->background.levelCollision->w || y_start < -50 || y_start >= game->background.levelCollision->h) {
+    if (x < 0 || x >= game->background.collision.w || y_start < -50 || y_start >= game->background.collision.h) {
         printf("placeBossOnGround: Invalid coordinates x=%d, y_start=%d\n", x, y_start);
         return;
     }
-    for (int y = y_start - 40; y <= y_start + 40 && y < game->background.levelCollision->h; y++) {
-        if (y < 0) continue;
-        SDL_Color color = get_pixel(game->background.levelCollision, x, y);
-        if (color.r == 255 && color.g == 255 && color.b == 255) {
-            boss->y = y - 512 + y_offset;
-            boss->position.y = boss->y;
-            return;
-        }
+    int y = collisionFirstSolidBelow(&game->background.collision, x, y_start - 40);
+    if (y >= 0 && y <= y_start + 40) {
+        boss->y = y - 512 + y_offset;
+        boss->position.y = boss->y;
+        return;
     }
-    boss->y = (game->background.levelCollision->h - 512) + y_offset;
+    boss->y = (game->background.collision.h - 512) + y_offset;
     boss->position.y = boss->y;
 }
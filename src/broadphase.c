@@ -0,0 +1,55 @@
+#include "broadphase.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void resetBroadphase(Broadphase *bp) {
+    bp->count = 0;
+    memset(bp->contacts, 0, sizeof(bp->contacts));
+}
+
+void addCollider(Broadphase *bp, ColliderType type, int index, int world_x, int w) {
+    if (bp->count == MAX_COLLIDERS || index < 0 || index >= BROADPHASE_MAX_INDEX) {
+        fprintf(stderr, "addCollider: No room for collider type %d index %d\n", type, index);
+        return;
+    }
+    Collider *c = &bp->colliders[bp->count++];
+    c->type = type;
+    c->index = index;
+    c->x0 = world_x - BROADPHASE_MARGIN;
+    c->x1 = world_x + w + BROADPHASE_MARGIN;
+}
+
+static int compareColliders(const void *a, const void *b) {
+    return ((const Collider *)a)->x0 - ((const Collider *)b)->x0;
+}
+
+static int contactBit(ColliderType type) {
+    if (type == COLLIDER_PLAYER) return CONTACT_PLAYER;
+    if (type == COLLIDER_BULLET) return CONTACT_BULLET;
+    return 0;
+}
+
+// Sort-and-sweep on x: each collider is checked only against the still-open intervals it starts inside
+void sweepBroadphase(Broadphase *bp) {
+    qsort(bp->colliders, bp->count, sizeof(Collider), compareColliders);
+
+    int open[MAX_COLLIDERS];
+    int numOpen = 0;
+    for (int i = 0; i < bp->count; i++) {
+        const Collider *c = &bp->colliders[i];
+
+        int kept = 0;
+        for (int k = 0; k < numOpen; k++) {
+            if (bp->colliders[open[k]].x1 > c->x0) open[kept++] = open[k];
+        }
+        numOpen = kept;
+
+        for (int k = 0; k < numOpen; k++) {
+            const Collider *other = &bp->colliders[open[k]];
+            bp->contacts[c->type][c->index] |= contactBit(other->type);
+            bp->contacts[other->type][other->index] |= contactBit(c->type);
+        }
+        open[numOpen++] = i;
+    }
+}
@@ -0,0 +1,651 @@
+#include "colmap.h"
+#include <SDL/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Pixel pairs of a packed byte that are MAT_SOLID (low bit set, high bit clear)
+#define SOLID_BITS(byte) ((byte) & ~((byte) >> 1) & 0x55)
+
+CollisionStats collisionStats;
+
+void collisionStatsEndFrame(void) {
+    CollisionStats *stats = &collisionStats;
+    stats->frames++;
+    stats->totalSamples += stats->samples;
+    stats->totalLocks += stats->locks;
+    stats->totalQueries += stats->queries;
+    if (stats->samples > stats->peakSamples) stats->peakSamples = stats->samples;
+    if (stats->locks > stats->peakLocks) stats->peakLocks = stats->locks;
+    if (stats->queries > stats->peakQueries) stats->peakQueries = stats->queries;
+    stats->samples = 0;
+    stats->locks = 0;
+    stats->queries = 0;
+    stats->numProbes = 0;
+}
+
+void collisionStatsDump(const char *path) {
+    CollisionStats *stats = &collisionStats;
+    if (stats->frames == 0) return;
+    FILE *out = path ? fopen(path, "a") : stdout;
+    if (!out) {
+        fprintf(stderr, "collisionStatsDump: Failed to open %s\n", path);
+        out = stdout;
+    }
+    fprintf(out, "Collision stats over %u frames:\n", stats->frames);
+    fprintf(out, "  samples: %llu total, %.1f/frame, peak %u\n",
+            (unsigned long long)stats->totalSamples, (double)stats->totalSamples / stats->frames, stats->peakSamples);
+    fprintf(out, "  queries: %llu total, %.1f/frame, peak %u\n",
+            (unsigned long long)stats->totalQueries, (double)stats->totalQueries / stats->frames, stats->peakQueries);
+    fprintf(out, "  surface locks: %llu total, %.1f/frame, peak %u\n",
+            (unsigned long long)stats->totalLocks, (double)stats->totalLocks / stats->frames, stats->peakLocks);
+    if (out != stdout) fclose(out);
+
+    stats->frames = 0;
+    stats->totalSamples = stats->totalLocks = stats->totalQueries = 0;
+    stats->peakSamples = stats->peakLocks = stats->peakQueries = 0;
+}
+
+// Classifies one mask colour the same way collision_color() and the ground probes always have
+static Material classifyMaskColor(Uint8 r, Uint8 g, Uint8 b) {
+    if (r == 255 && g == 255 && b == 255) return MAT_SOLID;
+    if (r == 255 && g == 0 && b == 42) return MAT_DOOR;
+    if (r == 0 && g == 255 && b == 0) return MAT_GREEN;
+    return MAT_EMPTY;
+}
+
+// Precomputes each column's solid runs so ground searches never walk the mask row by row
+static int buildGroundSpans(CollisionMap *map) {
+    map->spanStart = malloc((map->w + 1) * sizeof(int));
+    if (!map->spanStart) return 0;
+
+    // Columns are walked with a byte pointer stepping by pitch and the pixel's shift fixed per column
+    int total = 0;
+    for (int x = 0; x < map->w; x++) {
+        map->spanStart[x] = total;
+        const Uint8 *p = map->bits + (x >> 2);
+        int shift = (x & 3) << 1;
+        int inside = 0;
+        for (int y = 0; y < map->h; y++, p += map->pitch) {
+            int solid = ((*p >> shift) & 3) == MAT_SOLID;
+            if (solid && !inside) total++;
+            inside = solid;
+        }
+    }
+    map->spanStart[map->w] = total;
+
+    map->spans = malloc((total > 0 ? total : 1) * sizeof(GroundSpan));
+    if (!map->spans) {
+        free(map->spanStart);
+        map->spanStart = NULL;
+        return 0;
+    }
+    for (int x = 0; x < map->w; x++) {
+        GroundSpan *span = map->spans + map->spanStart[x];
+        const Uint8 *p = map->bits + (x >> 2);
+        int shift = (x & 3) << 1;
+        int top = -1;
+        for (int y = 0; y <= map->h; y++, p += map->pitch) {
+            int solid = y < map->h && ((*p >> shift) & 3) == MAT_SOLID;
+            if (solid && top < 0) {
+                top = y;
+            } else if (!solid && top >= 0) {
+                span->top = (Uint16)top;
+                span->bottom = (Uint16)(y - 1);
+                span++;
+                top = -1;
+            }
+        }
+    }
+    printf("Ground spans built: %d spans over %d columns\n", total, map->w);
+    return 1;
+}
+
+static int compareZones(const void *a, const void *b) {
+    return ((const MaskZone *)a)->rect.x - ((const MaskZone *)b)->rect.x;
+}
+
+// Collects door and green-zone pixels into rectangles so proximity tests never touch the pixels
+static int buildZones(CollisionMap *map) {
+    int capacity = 64;
+    map->zones = malloc(capacity * sizeof(MaskZone));
+    // Zones still open from the previous row, and the ones opened or extended on this row
+    int *open = malloc(map->w * sizeof(int));
+    int *next = malloc(map->w * sizeof(int));
+    if (!map->zones || !open || !next) {
+        free(open);
+        free(next);
+        return 0;
+    }
+
+    int numOpen = 0;
+    for (int y = 0; y < map->h; y++) {
+        MaskView view = collisionRowView(map, y);
+        int numNext = 0, o = 0;
+        int x = 0;
+        while (x < map->w) {
+            Material m = maskViewMaterial(view, x);
+            if (m != MAT_DOOR && m != MAT_GREEN) {
+                x = maskViewRunEnd(view, x, m);
+                continue;
+            }
+            int start = x;
+            x = maskViewRunEnd(view, x, m);
+
+            // Open zones are sorted by x, so the matching one (if any) is at or after o
+            while (o < numOpen && map->zones[open[o]].rect.x < start) o++;
+            MaskZone *zone = (o < numOpen) ? &map->zones[open[o]] : NULL;
+            if (zone && zone->rect.x == start && zone->rect.w == x - start && zone->material == m) {
+                zone->rect.h++;
+                next[numNext++] = open[o++];
+                continue;
+            }
+
+            if (map->numZones == capacity) {
+                capacity *= 2;
+                MaskZone *grown = realloc(map->zones, capacity * sizeof(MaskZone));
+                if (!grown) {
+                    free(open);
+                    free(next);
+                    return 0;
+                }
+                map->zones = grown;
+            }
+            zone = &map->zones[map->numZones];
+            zone->rect.x = start;
+            zone->rect.y = y;
+            zone->rect.w = x - start;
+            zone->rect.h = 1;
+            zone->material = m;
+            if (zone->rect.w > map->maxZoneWidth) map->maxZoneWidth = zone->rect.w;
+            next[numNext++] = map->numZones++;
+        }
+        int *swap = open;
+        open = next;
+        next = swap;
+        numOpen = numNext;
+    }
+    free(open);
+    free(next);
+
+    qsort(map->zones, map->numZones, sizeof(MaskZone), compareZones);
+    printf("Mask zones built: %d door/green rectangles\n", map->numZones);
+    return 1;
+}
+
+// 8x8 flags straight from the packed rows (two bytes per tile row), then 64x64 flags from those
+static int buildSolidTiles(CollisionMap *map) {
+    static const int sizes[COLMAP_TILE_LEVELS] = {64, 8};
+    for (int level = 0; level < COLMAP_TILE_LEVELS; level++) {
+        SolidTiles *tiles = &map->tiles[level];
+        tiles->size = sizes[level];
+        tiles->w = (map->w + tiles->size - 1) / tiles->size;
+        tiles->h = (map->h + tiles->size - 1) / tiles->size;
+        tiles->flags = malloc((size_t)tiles->w * tiles->h);
+        if (!tiles->flags) return 0;
+    }
+
+    SolidTiles *fine = &map->tiles[1];
+    for (int ty = 0; ty < fine->h; ty++) {
+        for (int tx = 0; tx < fine->w; tx++) {
+            int any = 0, all = 1;
+            for (int y = ty * 8; y < ty * 8 + 8; y++) {
+                if (y >= map->h || tx * 8 + 8 > map->w) {
+                    all = 0;   // Partial tiles at the map edge are never full
+                    if (y >= map->h) break;
+                }
+                const Uint8 *p = map->bits + y * map->pitch + tx * 2;
+                Uint8 right = tx * 2 + 1 < map->pitch ? p[1] : 0;
+                any |= SOLID_BITS(p[0]) | SOLID_BITS(right);
+                all &= p[0] == 0x55 && right == 0x55;
+            }
+            fine->flags[ty * fine->w + tx] = (any ? COLMAP_TILE_ANY : 0) | (all ? COLMAP_TILE_ALL : 0);
+        }
+    }
+
+    SolidTiles *coarse = &map->tiles[0];
+    int ratio = coarse->size / fine->size;
+    for (int ty = 0; ty < coarse->h; ty++) {
+        for (int tx = 0; tx < coarse->w; tx++) {
+            int any = 0, all = 1;
+            for (int fy = ty * ratio; fy < ty * ratio + ratio; fy++) {
+                for (int fx = tx * ratio; fx < tx * ratio + ratio; fx++) {
+                    int flags = (fx < fine->w && fy < fine->h) ? fine->flags[fy * fine->w + fx] : 0;
+                    any |= flags & COLMAP_TILE_ANY;
+                    all &= (flags & COLMAP_TILE_ALL) != 0;
+                }
+            }
+            coarse->flags[ty * coarse->w + tx] = (any ? COLMAP_TILE_ANY : 0) | (all ? COLMAP_TILE_ALL : 0);
+        }
+    }
+    return 1;
+}
+
+int initCollisionMap(CollisionMap *map, SDL_Surface *mask, int y_offset) {
+    if (!map || !mask) {
+        fprintf(stderr, "initCollisionMap: Map or mask surface is NULL\n");
+        return 0;
+    }
+    memset(map, 0, sizeof(*map));
+
+    int bpp = mask->format->BytesPerPixel;
+    if (bpp != 2 && bpp != 3 && bpp != 4) {
+        fprintf(stderr, "initCollisionMap: Unsupported mask format (%d bytes per pixel)\n", bpp);
+        return 0;
+    }
+
+    int rowBytes = (mask->w + COLMAP_PIXELS_PER_BYTE - 1) / COLMAP_PIXELS_PER_BYTE;
+    int pitch = (rowBytes + COLMAP_ALIGN - 1) / COLMAP_ALIGN * COLMAP_ALIGN;
+    void *bits = NULL;
+    if (posix_memalign(&bits, COLMAP_ALIGN, (size_t)pitch * mask->h) != 0) {
+        fprintf(stderr, "initCollisionMap: Failed to allocate %dx%d collision map\n", mask->w, mask->h);
+        return 0;
+    }
+    memset(bits, 0, (size_t)pitch * mask->h);
+
+    int redPixels = 0;
+    if (SDL_MUSTLOCK(mask) && SDL_LockSurface(mask) == 0) collisionStats.locks++;
+    for (int y = 0; y < mask->h; y++) {
+        const Uint8 *src = (const Uint8 *)mask->pixels + y * mask->pitch;
+        Uint8 *dst = (Uint8 *)bits + y * pitch;
+        Uint32 lastPixel = 0;
+        Material lastMaterial = MAT_EMPTY;
+        int lastRed = 0, haveLast = 0;
+        for (int x = 0; x < mask->w; x++) {
+            Uint32 pixel;
+            const Uint8 *p = src + x * bpp;
+            if (bpp == 4) {
+                pixel = *(const Uint32 *)p;
+            } else if (bpp == 2) {
+                pixel = *(const Uint16 *)p;
+            } else if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+                pixel = (p[0] << 16) | (p[1] << 8) | p[2];
+            } else {
+                pixel = p[0] | (p[1] << 8) | (p[2] << 16);
+            }
+            // Masks are long runs of a few colours: only convert when the pixel value changes
+            if (!haveLast || pixel != lastPixel) {
+                Uint8 r, g, b;
+                SDL_GetRGB(pixel, mask->format, &r, &g, &b);
+                lastPixel = pixel;
+                lastMaterial = classifyMaskColor(r, g, b);
+                lastRed = lastMaterial == MAT_EMPTY && r == 255 && g == 0 && b == 0;
+                haveLast = 1;
+            }
+            redPixels += lastRed;
+            dst[x >> 2] |= (Uint8)(lastMaterial << ((x & 3) << 1));
+        }
+    }
+    if (SDL_MUSTLOCK(mask)) SDL_UnlockSurface(mask);
+
+    // Plain RED has no slot in the 2-bit encoding and no caller tests for it
+    if (redPixels > 0) {
+        fprintf(stderr, "initCollisionMap: %d RED (255,0,0) pixels stored as empty\n", redPixels);
+    }
+
+    map->bits = bits;
+    map->w = mask->w;
+    map->h = mask->h;
+    map->pitch = pitch;
+    map->y_offset = y_offset;
+    printf("Collision map built: %dx%d, %d bytes\n", map->w, map->h, pitch * map->h);
+
+    if (!buildGroundSpans(map)) {
+        fprintf(stderr, "initCollisionMap: Failed to allocate ground spans\n");
+        freeCollisionMap(map);
+        return 0;
+    }
+    if (!buildZones(map)) {
+        fprintf(stderr, "initCollisionMap: Failed to allocate mask zones\n");
+        freeCollisionMap(map);
+        return 0;
+    }
+    if (!buildSolidTiles(map)) {
+        fprintf(stderr, "initCollisionMap: Failed to allocate solidity tiles\n");
+        freeCollisionMap(map);
+        return 0;
+    }
+    return 1;
+}
+
+void freeCollisionMap(CollisionMap *map) {
+    if (!map) return;
+    for (int level = 0; level < COLMAP_TILE_LEVELS; level++) free(map->tiles[level].flags);
+    if (map->mapped) {
+        munmap(map->mapped, map->mappedSize);
+    } else {
+        free(map->bits);
+        free(map->spans);
+        free(map->spanStart);
+        free(map->zones);
+    }
+    memset(map, 0, sizeof(*map));
+}
+
+static Uint32 alignOffset(Uint32 offset) {
+    return (offset + COLMAP_ALIGN - 1) / COLMAP_ALIGN * COLMAP_ALIGN;
+}
+
+int saveCollisionMap(const CollisionMap *map, const char *path) {
+    if (!map || !map->bits || !map->spans || !map->zones || !path) {
+        fprintf(stderr, "saveCollisionMap: Map is not built or path is NULL\n");
+        return 0;
+    }
+
+    ColmapHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, COLMAP_MAGIC, 4);
+    header.version = COLMAP_VERSION;
+    header.w = map->w;
+    header.h = map->h;
+    header.pitch = map->pitch;
+    header.y_offset = map->y_offset;
+    header.numSpans = map->spanStart[map->w];
+    header.numZones = map->numZones;
+    header.maxZoneWidth = map->maxZoneWidth;
+    header.bitsOffset = alignOffset(sizeof(header));
+    header.spanStartOffset = alignOffset(header.bitsOffset + map->pitch * map->h);
+    header.spansOffset = alignOffset(header.spanStartOffset + (map->w + 1) * sizeof(int));
+    header.zonesOffset = alignOffset(header.spansOffset + header.numSpans * sizeof(GroundSpan));
+
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "saveCollisionMap: Cannot open %s for writing\n", path);
+        return 0;
+    }
+    // Seeking past the end leaves the alignment padding zero-filled
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fseek(file, header.bitsOffset, SEEK_SET) == 0 &&
+             fwrite(map->bits, map->pitch, map->h, file) == (size_t)map->h &&
+             fseek(file, header.spanStartOffset, SEEK_SET) == 0 &&
+             fwrite(map->spanStart, sizeof(int), map->w + 1, file) == (size_t)map->w + 1 &&
+             fseek(file, header.spansOffset, SEEK_SET) == 0 &&
+             fwrite(map->spans, sizeof(GroundSpan), header.numSpans, file) == (size_t)header.numSpans &&
+             fseek(file, header.zonesOffset, SEEK_SET) == 0 &&
+             fwrite(map->zones, sizeof(MaskZone), header.numZones, file) == (size_t)header.numZones;
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) {
+        fprintf(stderr, "saveCollisionMap: Failed to write %s\n", path);
+        remove(path);
+    }
+    return ok;
+}
+
+int loadCollisionMap(CollisionMap *map, const char *path) {
+    if (!map || !path) return 0;
+    memset(map, 0, sizeof(*map));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ColmapHeader)) {
+        close(fd);
+        return 0;
+    }
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "loadCollisionMap: mmap failed for %s\n", path);
+        return 0;
+    }
+
+    const ColmapHeader *header = data;
+    size_t size = st.st_size;
+    int valid = memcmp(header->magic, COLMAP_MAGIC, 4) == 0 && header->version == COLMAP_VERSION &&
+                header->w > 0 && header->h > 0 && header->pitch * COLMAP_PIXELS_PER_BYTE >= header->w &&
+                header->numSpans >= 0 && header->numZones >= 0 &&
+                header->bitsOffset + (size_t)header->pitch * header->h <= size &&
+                header->spanStartOffset + (size_t)(header->w + 1) * sizeof(int) <= size &&
+                header->spansOffset + (size_t)header->numSpans * sizeof(GroundSpan) <= size &&
+                header->zonesOffset + (size_t)header->numZones * sizeof(MaskZone) <= size;
+    if (valid) {
+        const int *spanStart = (const int *)((const Uint8 *)data + header->spanStartOffset);
+        valid = spanStart[header->w] == header->numSpans;
+    }
+    if (!valid) {
+        fprintf(stderr, "loadCollisionMap: %s is not a valid version %d collision map\n", path, COLMAP_VERSION);
+        munmap(data, size);
+        return 0;
+    }
+
+    // Sections are used in place; nothing is decoded or copied
+    Uint8 *base = data;
+    map->bits = base + header->bitsOffset;
+    map->w = header->w;
+    map->h = header->h;
+    map->pitch = header->pitch;
+    map->y_offset = header->y_offset;
+    map->spanStart = (int *)(base + header->spanStartOffset);
+    map->spans = (GroundSpan *)(base + header->spansOffset);
+    map->zones = (MaskZone *)(base + header->zonesOffset);
+    map->numZones = header->numZones;
+    map->maxZoneWidth = header->maxZoneWidth;
+    map->mapped = data;
+    map->mappedSize = size;
+    if (!buildSolidTiles(map)) {
+        fprintf(stderr, "loadCollisionMap: Failed to allocate solidity tiles\n");
+        freeCollisionMap(map);
+        return 0;
+    }
+    printf("Collision map mapped from %s: %dx%d\n", path, map->w, map->h);
+    return 1;
+}
+
+int maskViewRunEnd(MaskView view, int x, Material material) {
+    Uint8 full = (Uint8)(0x55 * material);   // Four pixels of `material`
+    while (x < view.w && (x & 3)) {
+        if (maskViewMaterial(view, x) != material) return x;
+        x++;
+    }
+    while (x + 4 <= view.w && view.row[x >> 2] == full) x += 4;
+    while (x < view.w && maskViewMaterial(view, x) == material) x++;
+    return x;
+}
+
+int collisionRowSolid(const CollisionMap *map, int x_left, int x_right, int y, int step) {
+    collisionNoteProbe(PROBE_ROW, x_left, y, x_right, y);
+    MaskView view = collisionRowView(map, y);
+    if (!view.row) return 0;
+    int x = x_left;
+    if (x < 0) x += (-x + step - 1) / step * step;   // First sample inside the map
+    if (x_right >= view.w) x_right = view.w - 1;
+    for (; x <= x_right; x += step) {
+        COLLISION_COUNT(samples);
+        if (maskViewSolid(view, x)) return 1;
+    }
+    return 0;
+}
+
+int collisionFirstSolidBelow(const CollisionMap *map, int x, int y) {
+    if (!map->spans || x < 0 || x >= map->w || y >= map->h) {
+        collisionNoteProbe(PROBE_COLUMN, x, y, x, y);
+        return -1;
+    }
+    if (y < 0) y = 0;
+
+    // First span whose bottom reaches y
+    int lo = map->spanStart[x], hi = map->spanStart[x + 1];
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        COLLISION_COUNT(samples);
+        if (map->spans[mid].bottom < y) lo = mid + 1;
+        else hi = mid;
+    }
+    int ground = lo == map->spanStart[x + 1] ? -1 : (map->spans[lo].top > y ? map->spans[lo].top : y);
+    collisionNoteProbe(PROBE_COLUMN, x, y, x, ground >= 0 ? ground : map->h - 1);
+    return ground;
+}
+
+int collisionGroundBelow(const CollisionMap *map, int x_left, int x_right, int step, int y) {
+    int best = -1;
+    for (int x = x_left; x <= x_right; x += step) {
+        int ground = collisionFirstSolidBelow(map, x, y);
+        if (ground >= 0 && (best < 0 || ground < best)) {
+            best = ground;
+            if (best <= y) break;
+        }
+    }
+    return best;
+}
+
+int collisionFindZone(const CollisionMap *map, Material material, int x, int y, int radius) {
+    collisionNoteProbe(PROBE_PIXEL, x, y, x, y);
+    if (!map->zones || radius < 0) return -1;
+
+    // First zone that can reach x - radius
+    int lo = 0, hi = map->numZones;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (map->zones[mid].rect.x + map->maxZoneWidth <= x - radius) lo = mid + 1;
+        else hi = mid;
+    }
+
+    int best = -1;
+    for (int i = lo; i < map->numZones && map->zones[i].rect.x <= x + radius; i++) {
+        const MaskZone *zone = &map->zones[i];
+        COLLISION_COUNT(samples);
+        if (zone->material != material) continue;
+
+        int top = zone->rect.y, bottom = zone->rect.y + zone->rect.h - 1;
+        int dy = (y < top) ? top - y : (y > bottom) ? y - bottom : 0;
+        if (dy > radius) continue;
+
+        // Half-width of the circle at that row
+        int reach = (int)sqrt((double)(radius * radius - dy * dy));
+        int left = zone->rect.x > x - reach ? zone->rect.x : x - reach;
+        int right = zone->rect.x + zone->rect.w - 1;
+        if (right > x + reach) right = x + reach;
+        if (left <= right && (best < 0 || left < best)) best = left;
+    }
+    return best;
+}
+
+// Horizontal case of collisionRaycast(): skips 4 empty pixels per byte test
+static int rowRaycast(const CollisionMap *map, int x0, int x1, int y) {
+    if (y < 0 || y >= map->h) return -1;
+    int step = (x1 >= x0) ? 1 : -1;
+    if (step > 0) {
+        if (x0 < 0) x0 = 0;
+        if (x1 >= map->w) x1 = map->w - 1;
+    } else {
+        if (x0 >= map->w) x0 = map->w - 1;
+        if (x1 < 0) x1 = 0;
+    }
+
+    const Uint8 *row = map->bits + y * map->pitch;
+    for (int x = x0; step > 0 ? x <= x1 : x >= x1; ) {
+        COLLISION_COUNT(samples);
+        if (!SOLID_BITS(row[x >> 2])) {
+            x = (step > 0) ? (x | 3) + 1 : (x & ~3) - 1;
+            continue;
+        }
+        if (((row[x >> 2] >> ((x & 3) << 1)) & 3) == MAT_SOLID) return x;
+        x += step;
+    }
+    return -1;
+}
+
+static long long floorDiv(long long a, long long b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+int collisionRaycast(const CollisionMap *map, int x0, int y0, int x1, int y1, int *hit_x, int *hit_y) {
+    if (!map->bits) return 0;
+    collisionNoteProbe(PROBE_RAY, x0, y0, x1, y1);
+
+    if (y0 == y1) {
+        int x = rowRaycast(map, x0, x1, y0);
+        if (x < 0) return 0;
+        if (hit_x) *hit_x = x;
+        if (hit_y) *hit_y = y0;
+        return 1;
+    }
+
+    // Grid traversal (Amanatides & Woo): one pixel per step, never skipping a corner the segment crosses.
+    // After nx x-steps and ny y-steps the error term is dx - dy - 2*nx*dy + 2*ny*dx, so the walk can
+    // jump straight to the first pixel past an empty tile and carry on from there.
+    int dx = abs(x1 - x0), dy = abs(y1 - y0);
+    int sx = (x1 >= x0) ? 1 : -1, sy = (y1 >= y0) ? 1 : -1;
+    int nx = 0, ny = 0;
+    int err = dx - dy;
+    int x = x0, y = y0;
+    while (1) {
+        // Off the map, coarse tiles that lie wholly outside it count as empty. A pixel inside a fully
+        // solid tile is a hit without reading the mask.
+        const SolidTiles *empty = NULL;
+        int solid = 0;
+        if (x >= 0 && x < map->w && y >= 0 && y < map->h) {
+            for (int level = 0; level < COLMAP_TILE_LEVELS && map->tiles[level].flags; level++) {
+                int flags = collisionTileFlags(map, level, x, y);
+                if (flags & COLMAP_TILE_ALL) {
+                    solid = 1;
+                    break;
+                }
+                if (!(flags & COLMAP_TILE_ANY)) {
+                    empty = &map->tiles[level];
+                    break;
+                }
+            }
+        } else if (map->tiles[0].flags) {
+            int size = map->tiles[0].size;
+            int tileX = (int)floorDiv(x, size) * size, tileY = (int)floorDiv(y, size) * size;
+            if (tileX + size <= 0 || tileX >= map->w || tileY + size <= 0 || tileY >= map->h) empty = &map->tiles[0];
+        }
+        if (empty) {
+            int size = empty->size;
+            int tileX = (int)floorDiv(x, size) * size, tileY = (int)floorDiv(y, size) * size;
+            int exitX = sx > 0 ? tileX + size : tileX - 1;
+            int exitY = sy > 0 ? tileY + size : tileY - 1;
+            int NX = abs(exitX - x0), NY = abs(exitY - y0);
+            long long stepsA = -1, stepsB = -1;   // Steps to leave through the x side / the y side
+            int nyA = 0, nxB = 0;
+            if (dx > 0) {
+                // x steps from NX - 1 to NX on the first row where the error term turns positive
+                long long k = 2LL * (NX - 1) * dy + dy - dx;
+                nyA = (int)(floorDiv(k, 2LL * dx) + 1);
+                if (nyA < ny) nyA = ny;
+                stepsA = (long long)NX + nyA;
+            }
+            if (dy > 0) {
+                // y steps from NY - 1 to NY on the first column where the error term is no longer positive
+                long long m = (long long)dx - dy + 2LL * (NY - 1) * dx;
+                nxB = (int)-floorDiv(-m, 2LL * dy);
+                if (nxB < nx) nxB = nx;
+                stepsB = (long long)nxB + NY;
+            }
+            if (stepsA < 0 || (stepsB >= 0 && stepsB < stepsA)) {
+                nx = nxB;
+                ny = NY;
+            } else {
+                nx = NX;
+                ny = nyA;
+            }
+            if (nx + ny > dx + dy) return 0;
+            x = x0 + sx * nx;
+            y = y0 + sy * ny;
+            err = dx - dy - 2 * nx * dy + 2 * ny * dx;
+            continue;
+        }
+
+        if (solid || collisionSolid(map, x, y)) {
+            if (hit_x) *hit_x = x;
+            if (hit_y) *hit_y = y;
+            return 1;
+        }
+        if (nx + ny == dx + dy) return 0;
+        if (err > 0) {
+            x += sx;
+            nx++;
+            err -= 2 * dy;
+        } else {
+            y += sy;
+            ny++;
+            err += 2 * dx;
+        }
+    }
+}
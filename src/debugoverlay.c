@@ -0,0 +1,129 @@
+#include "debugoverlay.h"
+#include "game.h"
+#include "glyphatlas.h"
+#include <SDL/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+void toggleDebugOverlay(DebugOverlay *overlay) {
+    overlay->visible = !overlay->visible;
+    collisionStats.recordProbes = overlay->visible;
+    printf("Collision debug overlay %s\n", overlay->visible ? "shown" : "hidden");
+}
+
+void freeDebugOverlay(DebugOverlay *overlay) {
+    if (overlay->tint) {
+        SDL_FreeSurface(overlay->tint);
+        overlay->tint = NULL;
+    }
+}
+
+// One palette index per material, so the tint is a straight copy of the packed map; index 0 is transparent
+static SDL_Surface *buildTint(const CollisionMap *map) {
+    SDL_Surface *tint = SDL_CreateRGBSurface(SDL_SWSURFACE, map->w, map->h, 8, 0, 0, 0, 0);
+    if (!tint) {
+        fprintf(stderr, "buildTint: Failed to create %dx%d overlay: %s\n", map->w, map->h, SDL_GetError());
+        return NULL;
+    }
+    SDL_Color colors[4] = {{0, 0, 0, 0}, {0, 160, 255, 0}, {255, 0, 42, 0}, {0, 255, 0, 0}};
+    SDL_SetColors(tint, colors, MAT_EMPTY, 4);
+
+    for (int y = 0; y < map->h; y++) {
+        MaskView view = collisionRowView(map, y);
+        Uint8 *dst = (Uint8 *)tint->pixels + y * tint->pitch;
+        for (int x = 0; x < map->w; x++) dst[x] = (Uint8)maskViewMaterial(view, x);
+    }
+    SDL_SetColorKey(tint, SDL_SRCCOLORKEY, MAT_EMPTY);
+    SDL_SetAlpha(tint, SDL_SRCALPHA, DEBUG_OVERLAY_ALPHA);
+    printf("Collision overlay built: %dx%d\n", map->w, map->h);
+    return tint;
+}
+
+static void fillBox(SDL_Surface *screen, int x, int y, int w, int h, Uint32 color) {
+    SDL_Rect rect = {x, y, w, h};
+    trackedFill(screen, &rect, color);
+}
+
+static void outlineBox(SDL_Surface *screen, SDL_Rect r, Uint32 color) {
+    fillBox(screen, r.x, r.y, r.w, 1, color);
+    fillBox(screen, r.x, r.y + r.h - 1, r.w, 1, color);
+    fillBox(screen, r.x, r.y, 1, r.h, color);
+    fillBox(screen, r.x + r.w - 1, r.y, 1, r.h, color);
+}
+
+// Dotted segment; rays can cross the whole screen, so one dot every 3 px is plenty
+static void drawSegment(SDL_Surface *screen, int x0, int y0, int x1, int y1, Uint32 color) {
+    int steps = abs(x1 - x0) > abs(y1 - y0) ? abs(x1 - x0) : abs(y1 - y0);
+    for (int i = 0; i <= steps; i += 3) {
+        int x = steps ? x0 + (x1 - x0) * i / steps : x0;
+        int y = steps ? y0 + (y1 - y0) * i / steps : y0;
+        fillBox(screen, x, y, 2, 2, color);
+    }
+}
+
+static void drawText(SDL_Surface *screen, TTF_Font *font, const char *text, int x, int y) {
+    blitText(screen, font, text, (SDL_Color){255, 255, 255, 0}, x, y);
+}
+
+void renderDebugOverlay(GAME *game, SDL_Surface *screen, int scroll_x) {
+    DebugOverlay *overlay = &game->debug;
+    const CollisionMap *map = &game->background.collision;
+    if (!overlay->visible || !screen || !map->bits) return;
+
+    if (!overlay->tint) overlay->tint = buildTint(map);
+    if (overlay->tint) {
+        SDL_Rect src = {scroll_x, 0, SCREEN_WIDTH, map->h};
+        SDL_Rect dest = {0, map->y_offset, SCREEN_WIDTH, map->h};
+        trackedBlit(overlay->tint, &src, screen, &dest);
+    }
+
+    // Trigger volumes (world x, screen y)
+    Uint32 triggerColor = SDL_MapRGB(screen->format, 255, 160, 0);
+    for (int i = 0; i < game->triggers.numOrdered; i++) {
+        SDL_Rect r = game->triggers.triggers[game->triggers.order[i]].rect;
+        r.x -= scroll_x;
+        outlineBox(screen, r, triggerColor);
+    }
+
+    // Probes are in mask coordinates
+    Uint32 colors[4] = {
+        SDL_MapRGB(screen->format, 255, 255, 0),    // PROBE_ROW
+        SDL_MapRGB(screen->format, 0, 255, 255),    // PROBE_COLUMN
+        SDL_MapRGB(screen->format, 255, 0, 255),    // PROBE_PIXEL
+        SDL_MapRGB(screen->format, 255, 64, 64)     // PROBE_RAY
+    };
+    const CollisionStats *stats = &collisionStats;
+    for (int i = 0; i < stats->numProbes; i++) {
+        const CollisionProbe *probe = &stats->probes[i];
+        int x0 = probe->x0 - scroll_x, y0 = probe->y0 + map->y_offset;
+        int x1 = probe->x1 - scroll_x, y1 = probe->y1 + map->y_offset;
+        Uint32 color = colors[probe->kind & 3];
+        switch (probe->kind) {
+            case PROBE_ROW:
+                fillBox(screen, x0, y0 - 1, x1 - x0 + 1, 3, color);
+                break;
+            case PROBE_COLUMN:
+                fillBox(screen, x0, y0, 1, y1 - y0 + 1, color);
+                fillBox(screen, x1 - 2, y1 - 2, 5, 5, color);
+                break;
+            case PROBE_PIXEL:
+                fillBox(screen, x0 - 2, y0 - 2, 5, 5, color);
+                break;
+            default:
+                drawSegment(screen, x0, y0, x1, y1, color);
+                break;
+        }
+    }
+
+    if (game->global.font) {
+        char line[128];
+        fillBox(screen, 0, SCREEN_HEIGHT - 52, 640, 52, SDL_MapRGB(screen->format, 0, 0, 0));
+        snprintf(line, sizeof(line), "Collision: %u samples  %u queries  %u locks  %d probes%s",
+                 stats->samples, stats->queries, stats->locks, stats->numProbes,
+                 stats->numProbes == COLMAP_MAX_PROBES ? "+" : "");
+        drawText(screen, game->global.font, line, 8, SCREEN_HEIGHT - 50);
+        snprintf(line, sizeof(line), "Peak: %u samples  %u queries  %u locks over %u frames",
+                 stats->peakSamples, stats->peakQueries, stats->peakLocks, stats->frames);
+        drawText(screen, game->global.font, line, 8, SCREEN_HEIGHT - 26);
+    }
+}
@@ -0,0 +1,165 @@
+#include "dirtyrect.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+DirtyRenderer dirtyRenderer;
+
+void initDirtyRenderer(SDL_Surface *screen, int enabled) {
+    memset(&dirtyRenderer, 0, sizeof(dirtyRenderer));
+    dirtyRenderer.screen = screen;
+    // SDL_UpdateRects() cannot present a page-flipped screen
+    if (enabled && screen && (screen->flags & SDL_DOUBLEBUF) == SDL_DOUBLEBUF) {
+        fprintf(stderr, "initDirtyRenderer: Screen is double-buffered, using full redraws\n");
+        enabled = 0;
+    }
+    dirtyRenderer.enabled = enabled;
+    dirtyRenderer.full = 1;
+    printf("Renderer: %s\n", enabled ? "dirty rectangles" : "full redraw");
+}
+
+void invalidateScreen(void) {
+    dirtyRenderer.full = 1;
+}
+
+int consumeFullRedraw(void) {
+    int full = dirtyRenderer.full || !dirtyRenderer.enabled;
+    if (dirtyRenderer.full) {
+        dirtyRenderer.full = 0;
+        dirtyRenderer.presentAll = 1;
+    }
+    return full;
+}
+
+static int clipToScreen(SDL_Rect *rect) {
+    const SDL_Surface *screen = dirtyRenderer.screen;
+    int x0 = rect->x > 0 ? rect->x : 0, y0 = rect->y > 0 ? rect->y : 0;
+    int x1 = rect->x + rect->w < screen->w ? rect->x + rect->w : screen->w;
+    int y1 = rect->y + rect->h < screen->h ? rect->y + rect->h : screen->h;
+    if (x1 <= x0 || y1 <= y0) return 0;
+    rect->x = x0;
+    rect->y = y0;
+    rect->w = x1 - x0;
+    rect->h = y1 - y0;
+    return 1;
+}
+
+// Adds rect to list, folding it into the first rect it overlaps; returns 0 when the list is full
+static int addRect(SDL_Rect *list, int *count, int capacity, SDL_Rect rect) {
+    for (int i = 0; i < *count; i++) {
+        SDL_Rect *r = &list[i];
+        if (rect.x > r->x + r->w || r->x > rect.x + rect.w || rect.y > r->y + r->h || r->y > rect.y + rect.h) continue;
+        int x1 = r->x + r->w > rect.x + rect.w ? r->x + r->w : rect.x + rect.w;
+        int y1 = r->y + r->h > rect.y + rect.h ? r->y + r->h : rect.y + rect.h;
+        if (rect.x < r->x) r->x = rect.x;
+        if (rect.y < r->y) r->y = rect.y;
+        r->w = x1 - r->x;
+        r->h = y1 - r->y;
+        return 1;
+    }
+    if (*count == capacity) return 0;
+    list[(*count)++] = rect;
+    return 1;
+}
+
+void markDirty(SDL_Rect rect) {
+    DirtyRenderer *r = &dirtyRenderer;
+    // Already repainting everything next frame
+    if (!r->enabled || r->full || !clipToScreen(&rect)) return;
+    if (!addRect(r->drawn, &r->numDrawn, MAX_DIRTY_RECTS, rect)) {
+        // Lost track of this frame's drawing: present it whole and repaint everything next frame
+        r->presentAll = 1;
+        r->full = 1;
+    }
+}
+
+int trackedBlit(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst, SDL_Rect *dstrect) {
+    SDL_Rect area = dstrect ? *dstrect : (SDL_Rect){0, 0, 0, 0};
+    if (!dstrect && src) {
+        area.w = src->w;
+        area.h = src->h;
+    }
+    int result = SDL_BlitSurface(src, srcrect, dst, dstrect ? dstrect : &area);
+    // SDL stores the clipped destination back into the rect
+    if (result == 0 && dst == dirtyRenderer.screen) markDirty(dstrect ? *dstrect : area);
+    return result;
+}
+
+int trackedFill(SDL_Surface *dst, SDL_Rect *dstrect, Uint32 color) {
+    int result = SDL_FillRect(dst, dstrect, color);
+    if (result == 0 && dst == dirtyRenderer.screen) {
+        if (dstrect) markDirty(*dstrect);
+        else markDirty((SDL_Rect){0, 0, dst->w, dst->h});
+    }
+    return result;
+}
+
+// Moves the screen contents left by delta px (right when negative), the way the camera moved
+static void shiftScreen(SDL_Surface *screen, int delta) {
+    if (SDL_MUSTLOCK(screen) && SDL_LockSurface(screen) < 0) return;
+    int bpp = screen->format->BytesPerPixel;
+    int keep = (screen->w - abs(delta)) * bpp;
+    for (int y = 0; y < screen->h; y++) {
+        Uint8 *row = (Uint8 *)screen->pixels + y * screen->pitch;
+        if (delta > 0) memmove(row, row + delta * bpp, keep);
+        else memmove(row - delta * bpp, row, keep);
+    }
+    if (SDL_MUSTLOCK(screen)) SDL_UnlockSurface(screen);
+}
+
+int beginDirtyFrame(int scroll_x) {
+    DirtyRenderer *r = &dirtyRenderer;
+    if (!r->enabled) return -1;
+
+    int delta = r->haveScroll ? scroll_x - r->scroll_x : r->screen->w;
+    r->scroll_x = scroll_x;
+    r->haveScroll = 1;
+    r->numRestore = 0;
+    r->numDrawn = 0;
+    r->presentAll = 0;
+    if (r->full || abs(delta) >= r->screen->w) {
+        r->full = 0;
+        r->presentAll = 1;
+        return -1;
+    }
+
+    // Scrolled: everything moves with the camera, leaving a strip of new background on one side.
+    // Every pixel changes, so the frame is presented whole, but only the strip and last frame's
+    // sprites (now shifted) are repainted.
+    if (delta != 0) {
+        shiftScreen(r->screen, delta);
+        SDL_Rect strip = {delta > 0 ? r->screen->w - delta : 0, 0, abs(delta), r->screen->h};
+        r->restore[r->numRestore++] = strip;
+        r->presentAll = 1;
+    }
+    for (int i = 0; i < r->numPrevious; i++) {
+        SDL_Rect rect = r->previous[i];
+        rect.x -= delta;
+        if (clipToScreen(&rect)) addRect(r->restore, &r->numRestore, MAX_DIRTY_RECTS + 1, rect);
+    }
+    return r->numRestore;
+}
+
+void presentDirtyFrame(void) {
+    DirtyRenderer *r = &dirtyRenderer;
+    if (!r->enabled) {
+        SDL_Flip(r->screen);
+        return;
+    }
+
+    if (r->presentAll) {
+        SDL_UpdateRect(r->screen, 0, 0, 0, 0);
+    } else {
+        SDL_Rect rects[2 * MAX_DIRTY_RECTS + 1];
+        int count = 0;
+        for (int i = 0; i < r->numRestore; i++) addRect(rects, &count, 2 * MAX_DIRTY_RECTS + 1, r->restore[i]);
+        for (int i = 0; i < r->numDrawn; i++) addRect(rects, &count, 2 * MAX_DIRTY_RECTS + 1, r->drawn[i]);
+        if (count) SDL_UpdateRects(r->screen, count, rects);
+    }
+
+    memcpy(r->previous, r->drawn, r->numDrawn * sizeof(SDL_Rect));
+    r->numPrevious = r->numDrawn;
+    r->numDrawn = 0;
+    r->numRestore = 0;
+    r->presentAll = 0;
+}
@@ -21,23 +21,14 @@ static const int FRAME_DELAY = 8;
 
 // Static sprite sheets
 static SDL_Surface *attack1Sheet = NULL;
-static SDL_Surface *attack1SheetFlipped = NULL;
 static SDL_Surface *attack2Sheet = NULL;
-static SDL_Surface *attack2SheetFlipped = NULL;
 static SDL_Surface *attack3Sheet = NULL;
-static SDL_Surface *attack3SheetFlipped = NULL;
 static SDL_Surface *deadSheet = NULL;
-static SDL_Surface *deadSheetFlipped = NULL;
 static SDL_Surface *enablingSheet = NULL;
-static SDL_Surface *enablingSheetFlipped = NULL;
 static SDL_Surface *hurtSheet = NULL;
-static SDL_Surface *hurtSheetFlipped = NULL;
 static SDL_Surface *idleSheet = NULL;
-static SDL_Surface *idleSheetFlipped = NULL;
 static SDL_Surface *walkSheet = NULL;
-static SDL_Surface *walkSheetFlipped = NULL;
 static SDL_Surface *shutdownSheet = NULL;
-static SDL_Surface *shutdownSheetFlipped = NULL;
 
 void initEnemy(Enemy *enemy, int x, int y) {
     if (!enemy) {
@@ -53,8 +44,7 @@ void initEnemy(Enemy *enemy, int x, int y) {
         SDL_SetColorKey(attack1Sheet, SDL_SRCCOLORKEY, SDL_MapRGB(attack1Sheet->format, 0, 0, 0));
         SDL_Surface *optimized = SDL_DisplayFormat(attack1Sheet);
         if (optimized) { SDL_FreeSurface(attack1Sheet); attack1Sheet = optimized; }
-        attack1SheetFlipped = flipHorizontally(attack1Sheet);
-        if (!attack1SheetFlipped) { fprintf(stderr, "Failed to flip attack_1_resized.png\n"); exit(1); }
+        packSpriteSheet(attack1Sheet, 256, 256);
     }
     if (!attack2Sheet) {
         attack2Sheet = IMG_Load("assets/enemies/Swordsman/attack_2_resized.png");
@@ -62,8 +52,7 @@ void initEnemy(Enemy *enemy, int x, int y) {
         SDL_SetColorKey(attack2Sheet, SDL_SRCCOLORKEY, SDL_MapRGB(attack2Sheet->format, 0, 0, 0));
         SDL_Surface *optimized = SDL_DisplayFormat(attack2Sheet);
         if (optimized) { SDL_FreeSurface(attack2Sheet); attack2Sheet = optimized; }
-        attack2SheetFlipped = flipHorizontally(attack2Sheet);
-        if (!attack2SheetFlipped) { fprintf(stderr, "Failed to flip attack_2_resized.png\n"); exit(1); }
+        packSpriteSheet(attack2Sheet, 256, 256);
     }
     if (!attack3Sheet) {
         attack3Sheet = IMG_Load("assets/enemies/Swordsman/attack_3_resized.png");
@@ -71,8 +60,7 @@ void initEnemy(Enemy *enemy, int x, int y) {
         SDL_SetColorKey(attack3Sheet, SDL_SRCCOLORKEY, SDL_MapRGB(attack3Sheet->format, 0, 0, 0));
         SDL_Surface *optimized = SDL_DisplayFormat(attack3Sheet);
         if (optimized) { SDL_FreeSurface(attack3Sheet); attack3Sheet = optimized; }
-        attack3SheetFlipped = flipHorizontally(attack3Sheet);
-        if (!attack3SheetFlipped) { fprintf(stderr, "Failed to flip attack_3_resized.png\n"); exit(1); }
+        packSpriteSheet(attack3Sheet, 256, 256);
     }
     if (!deadSheet) {
         deadSheet = IMG_Load("assets/enemies/Swordsman/dead_resized.png");
@@ -80,8 +68,7 @@ void initEnemy(Enemy *enemy, int x, int y) {
         SDL_SetColorKey(deadSheet, SDL_SRCCOLORKEY, SDL_MapRGB(deadSheet->format, 0, 0, 0));
         SDL_Surface *optimized = SDL_DisplayFormat(deadSheet);
         if (optimized) { SDL_FreeSurface(deadSheet); deadSheet = optimized; }
-        deadSheetFlipped = flipHorizontally(deadSheet);
-        if (!deadSheetFlipped) { fprintf(stderr, "Failed to flip dead_resized.png\n"); exit(1); }
+        packSpriteSheet(deadSheet, 256, 256);
     }
     if (!enablingSheet) {
         enablingSheet = IMG_Load("assets/enemies/Swordsman/enabling_resized.png");
@@ -89,8 +76,7 @@ void initEnemy(Enemy *enemy, int x, int y) {
         SDL_SetColorKey(enablingSheet, SDL_SRCCOLORKEY, SDL_MapRGB(enablingSheet->format, 0, 0, 0));
         SDL_Surface *optimized = SDL_DisplayFormat(enablingSheet);
         if (optimized) { SDL_FreeSurface(enablingSheet); enablingSheet = optimized; }
-        enablingSheetFlipped = flipHorizontally(enablingSheet);
-        if (!enablingSheetFlipped) { fprintf(stderr, "Failed to flip enabling_resized.png\n"); exit(1); }
+        packSpriteSheet(enablingSheet, 256, 256);
     }
     if (!hurtSheet) {
         hurtSheet = IMG_Load("assets/enemies/Swordsman/hurt_resized.png");
@@ -98,8 +84,7 @@ void initEnemy(Enemy *enemy, int x, int y) {
         SDL_SetColorKey(hurtSheet, SDL_SRCCOLORKEY, SDL_MapRGB(hurtSheet->format, 0, 0, 0));
         SDL_Surface *optimized = SDL_DisplayFormat(hurtSheet);
         if (optimized) { SDL_FreeSurface(hurtSheet); hurtSheet = optimized; }
-        hurtSheetFlipped = flipHorizontally(hurtSheet);
-        if (!hurtSheetFlipped) { fprintf(stderr, "Failed to flip hurt_resized.png\n"); exit(1); }
+        packSpriteSheet(hurtSheet, 256, 256);
     }
     if (!idleSheet) {
         idleSheet = IMG_Load("assets/enemies/Swordsman/idle_resized.png");
@@ -107,8 +92,7 @@ void initEnemy(Enemy *enemy, int x, int y) {
         SDL_SetColorKey(idleSheet, SDL_SRCCOLORKEY, SDL_MapRGB(idleSheet->format, 0, 0, 0));
         SDL_Surface *optimized = SDL_DisplayFormat(idleSheet);
         if (optimized) { SDL_FreeSurface(idleSheet); idleSheet = optimized; }
-        idleSheetFlipped = flipHorizontally(idleSheet);
-        if (!idleSheetFlipped) { fprintf(stderr, "Failed to flip idle_resized.png\n"); exit(1); }
+        packSpriteSheet(idleSheet, 256, 256);
     }
     if (!walkSheet) {
         walkSheet = IMG_Load("assets/enemies/Swordsman/walk_resized.png");
@@ -116,8 +100,7 @@ void initEnemy(Enemy *enemy, int x, int y) {
         SDL_SetColorKey(walkSheet, SDL_SRCCOLORKEY, SDL_MapRGB(walkSheet->format, 0, 0, 0));
         SDL_Surface *optimized = SDL_DisplayFormat(walkSheet);
         if (optimized) { SDL_FreeSurface(walkSheet); walkSheet = optimized; }
-        walkSheetFlipped = flipHorizontally(walkSheet);
-        if (!walkSheetFlipped) { fprintf(stderr, "Failed to flip walk_resized.png\n"); exit(1); }
+        packSpriteSheet(walkSheet, 256, 256);
     }
     if (!shutdownSheet) {
         shutdownSheet = IMG_Load("assets/enemies/Swordsman/shutdown_resized.png");
@@ -125,8 +108,7 @@ void initEnemy(Enemy *enemy, int x, int y) {
         SDL_SetColorKey(shutdownSheet, SDL_SRCCOLORKEY, SDL_MapRGB(shutdownSheet->format, 0, 0, 0));
         SDL_Surface *optimized = SDL_DisplayFormat(shutdownSheet);
         if (optimized) { SDL_FreeSurface(shutdownSheet); shutdownSheet = optimized; }
-        shutdownSheetFlipped = flipHorizontally(shutdownSheet);
-        if (!shutdownSheetFlipped) { fprintf(stderr, "Failed to flip shutdown_resized.png\n"); exit(1); }
+        packSpriteSheet(shutdownSheet, 256, 256);
     }
 
     // Initialize properties
@@ -315,26 +297,19 @@ void updateEnemy(Enemy *enemy, SDL_Rect playerPosition, int *playerHealth, int p
 void renderEnemy(SDL_Surface *screen, Enemy *enemy, int scroll_x) {
     if (!screen || !enemy || !enemy->active) return;
 
-    SDL_Surface *sheet = enemy->facingLeft ?
-        (enemy->state == ENEMY_IDLE ? idleSheetFlipped :
-         enemy->state == ENEMY_WALKING ? walkSheetFlipped :
-         enemy->state == ENEMY_ATTACKING ? (enemy->health <= LOW_HEALTH_THRESHOLD ? attack3SheetFlipped : attack1SheetFlipped) :
-         enemy->state == ENEMY_HURT ? hurtSheetFlipped :
-         enemy->state == ENEMY_DEAD ? deadSheetFlipped :
-         enemy->state == ENEMY_SHUTDOWN ? shutdownSheetFlipped :
-         enablingSheetFlipped) :
-        (enemy->state == ENEMY_IDLE ? idleSheet :
-         enemy->state == ENEMY_WALKING ? walkSheet :
-         enemy->state == ENEMY_ATTACKING ? (enemy->health <= LOW_HEALTH_THRESHOLD ? attack3Sheet : attack1Sheet) :
-         enemy->state == ENEMY_HURT ? hurtSheet :
-         enemy->state == ENEMY_DEAD ? deadSheet :
-         enemy->state == ENEMY_SHUTDOWN ? shutdownSheet :
-         enablingSheet);
+    SDL_Surface *sheet =
+        enemy->state == ENEMY_IDLE ? idleSheet :
+        enemy->state == ENEMY_WALKING ? walkSheet :
+        enemy->state == ENEMY_ATTACKING ? (enemy->health <= LOW_HEALTH_THRESHOLD ? attack3Sheet : attack1Sheet) :
+        enemy->state == ENEMY_HURT ? hurtSheet :
+        enemy->state == ENEMY_DEAD ? deadSheet :
+        enemy->state == ENEMY_SHUTDOWN ? shutdownSheet :
+        enablingSheet;
 
     SDL_Rect srcRect = {enemy->frame * 256, 0, 256, 256};
     if (srcRect.x >= sheet->w) srcRect.x = 0;
     SDL_Rect destRect = {enemy->position.x - scroll_x, enemy->position.y, 258, 258};
-    SDL_BlitSurface(sheet, &srcRect, screen, &destRect);
+    blitSprite(sheet, &srcRect, screen, &destRect, enemy->facingLeft);
 
     // Render health bar
     if (enemy->state != ENEMY_DEAD && enemy->health > 0) {
@@ -343,10 +318,10 @@ void renderEnemy(SDL_Surface *screen, Enemy *enemy, int scroll_x) {
         int hb_width = 100;
         int hb_height = 10;
         SDL_Rect bgRect = {hb_x, hb_y, hb_width, hb_height};
-        SDL_FillRect(screen, &bgRect, SDL_MapRGB(screen->format, 0, 0, 0));
+        trackedFill(screen, &bgRect, SDL_MapRGB(screen->format, 0, 0, 0));
         int health_width = (int)((enemy->health / (float)enemy->maxHealth) * hb_width);
         SDL_Rect healthRect = {hb_x, hb_y, health_width, hb_height};
-        SDL_FillRect(screen, &healthRect, SDL_MapRGB(screen->format, 255, 0, 0));
+        trackedFill(screen, &healthRect, SDL_MapRGB(screen->format, 255, 0, 0));
     }
 }
 
@@ -356,22 +331,13 @@ void freeEnemy(Enemy *enemy) {
 }
 
 void freeEnemySprites(void) {
-    SDL_FreeSurface(attack1Sheet); attack1Sheet = NULL;
-    SDL_FreeSurface(attack1SheetFlipped); attack1SheetFlipped = NULL;
-    SDL_FreeSurface(attack2Sheet); attack2Sheet = NULL;
-    SDL_FreeSurface(attack2SheetFlipped); attack2SheetFlipped = NULL;
-    SDL_FreeSurface(attack3Sheet); attack3Sheet = NULL;
-    SDL_FreeSurface(attack3SheetFlipped); attack3SheetFlipped = NULL;
-    SDL_FreeSurface(deadSheet); deadSheet = NULL;
-    SDL_FreeSurface(deadSheetFlipped); deadSheetFlipped = NULL;
-    SDL_FreeSurface(enablingSheet); enablingSheet = NULL;
-    SDL_FreeSurface(enablingSheetFlipped); enablingSheetFlipped = NULL;
-    SDL_FreeSurface(hurtSheet); hurtSheet = NULL;
-    SDL_FreeSurface(hurtSheetFlipped); hurtSheetFlipped = NULL;
-    SDL_FreeSurface(idleSheet); idleSheet = NULL;
-    SDL_FreeSurface(idleSheetFlipped); idleSheetFlipped = NULL;
-    SDL_FreeSurface(walkSheet); walkSheet = NULL;
-    SDL_FreeSurface(walkSheetFlipped); walkSheetFlipped = NULL;
-    SDL_FreeSurface(shutdownSheet); shutdownSheet = NULL;
-    SDL_FreeSurface(shutdownSheetFlipped); shutdownSheetFlipped = NULL;
+    unpackSpriteSheet(attack1Sheet); SDL_FreeSurface(attack1Sheet); attack1Sheet = NULL;
+    unpackSpriteSheet(attack2Sheet); SDL_FreeSurface(attack2Sheet); attack2Sheet = NULL;
+    unpackSpriteSheet(attack3Sheet); SDL_FreeSurface(attack3Sheet); attack3Sheet = NULL;
+    unpackSpriteSheet(deadSheet); SDL_FreeSurface(deadSheet); deadSheet = NULL;
+    unpackSpriteSheet(enablingSheet); SDL_FreeSurface(enablingSheet); enablingSheet = NULL;
+    unpackSpriteSheet(hurtSheet); SDL_FreeSurface(hurtSheet); hurtSheet = NULL;
+    unpackSpriteSheet(idleSheet); SDL_FreeSurface(idleSheet); idleSheet = NULL;
+    unpackSpriteSheet(walkSheet); SDL_FreeSurface(walkSheet); walkSheet = NULL;
+    unpackSpriteSheet(shutdownSheet); SDL_FreeSurface(shutdownSheet); shutdownSheet = NULL;
 }
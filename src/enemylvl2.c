@@ -6,6 +6,7 @@
 #include "collision.h"
 #include "mouvement.h"
 #include "utils.h"
+#include "spritemask.h"
 #include "game.h"
 
 #define MOVE_SPEED 2.0f
@@ -86,59 +87,34 @@
 
 // Sprite sheets
 static SDL_Surface *mummyIdleSheet = NULL;
-static SDL_Surface *mummyIdleSheetFlipped = NULL;
 static SDL_Surface *mummyWalkSheet = NULL;
-static SDL_Surface *mummyWalkSheetFlipped = NULL;
 static SDL_Surface *mummyAttackSheet = NULL;
-static SDL_Surface *mummyAttackSheetFlipped = NULL;
 static SDL_Surface *mummyHurtSheet = NULL;
-static SDL_Surface *mummyHurtSheetFlipped = NULL;
 static SDL_Surface *mummyDyingSheet = NULL;
-static SDL_Surface *mummyDyingSheetFlipped = NULL;
 
 static SDL_Surface *deceasedIdleSheet = NULL;
-static SDL_Surface *deceasedIdleSheetFlipped = NULL;
 static SDL_Surface *deceasedWalkSheet = NULL;
-static SDL_Surface *deceasedWalkSheetFlipped = NULL;
 static SDL_Surface *deceasedAttackSheet = NULL;
-static SDL_Surface *deceasedAttackSheetFlipped = NULL;
 static SDL_Surface *deceasedHurtSheet = NULL;
-static SDL_Surface *deceasedHurtSheetFlipped = NULL;
 static SDL_Surface *deceasedDyingSheet = NULL;
-static SDL_Surface *deceasedDyingSheetFlipped = NULL;
 static SDL_Surface *deceasedProjectileSheet = NULL;
 
 static SDL_Surface *gorgonIdleSheet = NULL;
-static SDL_Surface *gorgonIdleSheetFlipped = NULL;
 static SDL_Surface *gorgonWalkSheet = NULL;
-static SDL_Surface *gorgonWalkSheetFlipped = NULL;
 static SDL_Surface *gorgonRunSheet = NULL;
-static SDL_Surface *gorgonRunSheetFlipped = NULL;
 static SDL_Surface *gorgonAttackSheet = NULL;
-static SDL_Surface *gorgonAttackSheetFlipped = NULL;
 static SDL_Surface *gorgonHurtSheet = NULL;
-static SDL_Surface *gorgonHurtSheetFlipped = NULL;
 static SDL_Surface *gorgonDyingSheet = NULL;
-static SDL_Surface *gorgonDyingSheetFlipped = NULL;
 static SDL_Surface *gorgonSpecialSheet = NULL;
-static SDL_Surface *gorgonSpecialSheetFlipped = NULL;
 
 static SDL_Surface *spearmanIdleSheet = NULL;
-static SDL_Surface *spearmanIdleSheetFlipped = NULL;
 static SDL_Surface *spearmanWalkSheet = NULL;
-static SDL_Surface *spearmanWalkSheetFlipped = NULL;
 static SDL_Surface *spearmanRunSheet = NULL;
-static SDL_Surface *spearmanRunSheetFlipped = NULL;
 static SDL_Surface *spearmanAttackSheet = NULL;
-static SDL_Surface *spearmanAttackSheetFlipped = NULL;
 static SDL_Surface *spearmanHurtSheet = NULL;
-static SDL_Surface *spearmanHurtSheetFlipped = NULL;
 static SDL_Surface *spearmanDyingSheet = NULL;
-static SDL_Surface *spearmanDyingSheetFlipped = NULL;
 static SDL_Surface *spearmanFallSheet = NULL;
-static SDL_Surface *spearmanFallSheetFlipped = NULL;
 static SDL_Surface *spearmanRunAttackSheet = NULL;
-static SDL_Surface *spearmanRunAttackSheetFlipped = NULL;
 
 // Utility functions
 static SDL_Surface* loadSprite(const char* path) {
@@ -148,10 +124,18 @@ static SDL_Surface* loadSprite(const char* path) {
         return NULL;
     }
     Uint32 colorkey = SDL_MapRGB(surface->format, 255, 255, 255);
-    SDL_SetColorKey(surface, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+    SDL_SetColorKey(surface, SDL_SRCCOLORKEY, colorkey);
+    registerSpriteMask(surface);
+    packSpriteSheet(surface, SPRITE_WIDTH, SPRITE_HEIGHT);
     return surface;
 }
 
+static void freeSprite(SDL_Surface *sheet) {
+    releaseSpriteMask(sheet);
+    unpackSpriteSheet(sheet);
+    SDL_FreeSurface(sheet);
+}
+
 static void initParticles(Particle* particles, int count, float x, float y, SDL_Color color) {
     for (int i = 0; i < count; i++) {
         particles[i].x = x;
@@ -180,7 +164,7 @@ static void renderParticles(SDL_Surface* screen, Particle* particles, int count,
     for (int i = 0; i < count; i++) {
         if (!particles[i].active) continue;
         SDL_Rect rect = {(int)particles[i].x - scroll_x, (int)particles[i].y, 2, 2};
-        SDL_FillRect(screen, &rect, SDL_MapRGB(screen->format, particles[i].color.r, particles[i].color.g, particles[i].color.b));
+        trackedFill(screen, &rect, SDL_MapRGB(screen->format, particles[i].color.r, particles[i].color.g, particles[i].color.b));
     }
 }
 
@@ -190,15 +174,10 @@ void initMummy(Mummy *mummy, int x, int y, struct GAME *game) {
 
     if (!mummyIdleSheet) {
         mummyIdleSheet = loadSprite("assets/characters/5Mummy/mummy_idle.png");
-        mummyIdleSheetFlipped = flipHorizontally(mummyIdleSheet);
         mummyWalkSheet = loadSprite("assets/characters/5Mummy/mummy_walk.png");
-        mummyWalkSheetFlipped = flipHorizontally(mummyWalkSheet);
         mummyAttackSheet = loadSprite("assets/characters/5Mummy/mummy_attack.png");
-        mummyAttackSheetFlipped = flipHorizontally(mummyAttackSheet);
         mummyHurtSheet = loadSprite("assets/characters/5Mummy/mummy_hurt.png");
-        mummyHurtSheetFlipped = flipHorizontally(mummyHurtSheet);
         mummyDyingSheet = loadSprite("assets/characters/5Mummy/mummy_death.png");
-        mummyDyingSheetFlipped = flipHorizontally(mummyDyingSheet);
     }
 
     mummy->position = (SDL_Rect){x, y, SPRITE_WIDTH, SPRITE_HEIGHT};
@@ -213,6 +192,8 @@ void initMummy(Mummy *mummy, int x, int y, struct GAME *game) {
     mummy->health = 50;
     mummy->maxHealth = 50;
     mummy->active = 1;
+    mummy->nav.timer = 0;
+    mummy->nav.mode = NAV_AGENT_DIRECT;
     mummy->lastFrameTime = SDL_GetTicks();
     mummy->attackCooldown = 0;
 
@@ -227,15 +208,15 @@ void updateMummy(Mummy *mummy, int *playerHealth, int playerMaxHealth, struct GA
     float distance = fabs(dx);
     if (distance > ACTIVATION_ZONE) return;
 
-    // Update gravity and ground status
-    mummy->onGround = onGroundEnemyLvl2(game, &mummy->position, mummy->world_x);
+    // Update gravity (onGround comes from onGroundBatch())
     if (!mummy->onGround) {
         mummy->yVelocity += GRAVITY;
         if (mummy->yVelocity > MAX_FALL_SPEED) mummy->yVelocity = MAX_FALL_SPEED;
     } else {
         mummy->yVelocity = 0.0f;
     }
-    mummy->position.y += (int)mummy->yVelocity;
+    mummy->position.y += sweepMove(game, mummy->world_x, mummy->position.w,
+                                   mummy->position.y + mummy->position.h, (int)mummy->yVelocity);
     if (mummy->onGround) placeEnemyLvl2OnGround(game, &mummy->position, mummy->world_x);
 
     // Update facing direction
@@ -254,7 +235,8 @@ void updateMummy(Mummy *mummy, int *playerHealth, int playerMaxHealth, struct GA
         mummy->xVelocity = 0.0f;
     } else if (distance < CHASE_DISTANCE) {
         mummy->state = ENEMY2_WALKING;
-        mummy->xVelocity = mummy->direction * MOVE_SPEED;
+        mummy->xVelocity = MOVE_SPEED * chaseDirection(game, &mummy->nav, mummy->world_x, mummy->position.w,
+                                                       mummy->position.y + mummy->position.h, game->player2.world_x, game->player2.position.y + game->player2.position.h);
     } else {
         mummy->state = ENEMY2_IDLE;
         mummy->xVelocity = 0.0f;
@@ -270,18 +252,18 @@ void updateMummy(Mummy *mummy, int *playerHealth, int playerMaxHealth, struct GA
     if (game->player2.etat == P2_ATTACK_1 && mummy->state != ENEMY2_HURT) {
         SDL_Rect attackRect = {game->player2.world_x + (game->player2.lookingRight ? 50 : -50), game->player2.position.y, 100, 100};
         SDL_Rect mummyRect = {mummy->world_x, mummy->position.y, mummy->position.w, mummy->position.h};
-        SDL_Surface *playerSheet = game->player2.lookingRight ? game->player2.spriteSheet : game->player2.spriteSheetFlipped;
+        SDL_Surface *playerSheet = game->player2.spriteSheet;
         SDL_Rect srcRectPlayer = game->player2.frame;
         if (!game->player2.lookingRight) {
             srcRectPlayer.x = (playerSheet->w - srcRectPlayer.x) - srcRectPlayer.w;
         }
-        SDL_Surface *mummySheet = mummy->state == ENEMY2_IDLE ? (mummy->direction > 0 ? mummyIdleSheet : mummyIdleSheetFlipped) :
-                                  mummy->state == ENEMY2_WALKING ? (mummy->direction > 0 ? mummyWalkSheet : mummyWalkSheetFlipped) :
-                                  mummy->state == ENEMY2_ATTACKING ? (mummy->direction > 0 ? mummyAttackSheet : mummyAttackSheetFlipped) :
-                                  (mummy->direction > 0 ? mummyHurtSheet : mummyHurtSheetFlipped);
+        SDL_Surface *mummySheet = mummy->state == ENEMY2_IDLE ? mummyIdleSheet :
+                                  mummy->state == ENEMY2_WALKING ? mummyWalkSheet :
+                                  mummy->state == ENEMY2_ATTACKING ? mummyAttackSheet :
+                                  mummyHurtSheet;
         SDL_Rect srcRectMummy = {mummy->frame * SPRITE_WIDTH, 0, SPRITE_WIDTH, SPRITE_HEIGHT};
 
-        if (pixelPerfectCollision(playerSheet, &attackRect, &srcRectPlayer, mummySheet, &mummyRect, &srcRectMummy)) {
+        if (mirroredPixelCollision(playerSheet, !game->player2.lookingRight, &attackRect, &srcRectPlayer, mummySheet, mummy->direction <= 0, &mummyRect, &srcRectMummy)) {
             mummy->health -= 10;
             mummy->state = ENEMY2_HURT;
             mummy->frame = 0;
@@ -293,15 +275,15 @@ void updateMummy(Mummy *mummy, int *playerHealth, int playerMaxHealth, struct GA
     if (mummy->state == ENEMY2_ATTACKING && mummy->frame == 2 && mummy->attackCooldown == 0) {
         SDL_Rect mummyRect = {mummy->world_x, mummy->position.y, mummy->position.w, mummy->position.h};
         SDL_Rect playerRect = {game->player2.world_x, game->player2.position.y, game->player2.position.w, game->player2.position.h};
-        SDL_Surface *mummySheet = mummy->direction > 0 ? mummyAttackSheet : mummyAttackSheetFlipped;
-        SDL_Surface *playerSheet = game->player2.lookingRight ? game->player2.spriteSheet : game->player2.spriteSheetFlipped;
+        SDL_Surface *mummySheet = mummyAttackSheet;
+        SDL_Surface *playerSheet = game->player2.spriteSheet;
         SDL_Rect srcRectMummy = {mummy->frame * SPRITE_WIDTH, 0, SPRITE_WIDTH, SPRITE_HEIGHT};
         SDL_Rect srcRectPlayer = game->player2.frame;
         if (!game->player2.lookingRight) {
             srcRectPlayer.x = (playerSheet->w - srcRectPlayer.x) - srcRectPlayer.w;
         }
 
-        if (pixelPerfectCollision(mummySheet, &mummyRect, &srcRectMummy, playerSheet, &playerRect, &srcRectPlayer)) {
+        if (mirroredPixelCollision(mummySheet, mummy->direction <= 0, &mummyRect, &srcRectMummy, playerSheet, !game->player2.lookingRight, &playerRect, &srcRectPlayer)) {
             *playerHealth -= 5;
             mummy->attackCooldown = 1000;
             if (*playerHealth <= 0) game->player2.etat = P2_DEAD;
@@ -350,27 +332,21 @@ void updateMummy(Mummy *mummy, int *playerHealth, int playerMaxHealth, struct GA
 void renderMummy(SDL_Surface *screen, Mummy *mummy, int scroll_x) {
     if (!screen || !mummy || !mummy->active) return;
 
-    SDL_Surface *sheet = mummy->direction > 0 ?
-        (mummy->state == ENEMY2_IDLE ? mummyIdleSheet :
-         mummy->state == ENEMY2_WALKING ? mummyWalkSheet :
-         mummy->state == ENEMY2_ATTACKING ? mummyAttackSheet :
-         mummy->state == ENEMY2_HURT ? mummyHurtSheet :
-         mummyDyingSheet) :
-        (mummy->state == ENEMY2_IDLE ? mummyIdleSheetFlipped :
-         mummy->state == ENEMY2_WALKING ? mummyWalkSheetFlipped :
-         mummy->state == ENEMY2_ATTACKING ? mummyAttackSheetFlipped :
-         mummy->state == ENEMY2_HURT ? mummyHurtSheetFlipped :
-         mummyDyingSheetFlipped);
+    SDL_Surface *sheet = mummy->state == ENEMY2_IDLE ? mummyIdleSheet :
+                         mummy->state == ENEMY2_WALKING ? mummyWalkSheet :
+                         mummy->state == ENEMY2_ATTACKING ? mummyAttackSheet :
+                         mummy->state == ENEMY2_HURT ? mummyHurtSheet :
+                         mummyDyingSheet;
 
     SDL_Rect srcRect = {mummy->frame * SPRITE_WIDTH, 0, SPRITE_WIDTH, SPRITE_HEIGHT};
     SDL_Rect destRect = {mummy->world_x - scroll_x, mummy->position.y, SPRITE_WIDTH, SPRITE_HEIGHT};
-    SDL_BlitSurface(sheet, &srcRect, screen, &destRect);
+    blitSprite(sheet, &srcRect, screen, &destRect, mummy->direction <= 0);
 
     if (mummy->health > 0) {
         SDL_Rect healthBarBg = {mummy->world_x - scroll_x, mummy->position.y - 20, 50, 5};
-        SDL_FillRect(screen, &healthBarBg, SDL_MapRGB(screen->format, 255, 0, 0));
+        trackedFill(screen, &healthBarBg, SDL_MapRGB(screen->format, 255, 0, 0));
         SDL_Rect healthBar = {mummy->world_x - scroll_x, mummy->position.y - 20, (50 * mummy->health) / mummy->maxHealth, 5};
-        SDL_FillRect(screen, &healthBar, SDL_MapRGB(screen->format, 0, 255, 0));
+        trackedFill(screen, &healthBar, SDL_MapRGB(screen->format, 0, 255, 0));
     }
 }
 
@@ -384,15 +360,10 @@ void initDeceased(Deceased *deceased, int x, int y, struct GAME *game) {
 
     if (!deceasedIdleSheet) {
         deceasedIdleSheet = loadSprite("assets/characters/6Deceased/deceased_idle.png");
-        deceasedIdleSheetFlipped = flipHorizontally(deceasedIdleSheet);
         deceasedWalkSheet = loadSprite("assets/characters/6Deceased/deceased_walk.png");
-        deceasedWalkSheetFlipped = flipHorizontally(deceasedWalkSheet);
         deceasedAttackSheet = loadSprite("assets/characters/6Deceased/deceased_attack.png");
-        deceasedAttackSheetFlipped = flipHorizontally(deceasedAttackSheet);
         deceasedHurtSheet = loadSprite("assets/characters/6Deceased/deceased_hurt.png");
-        deceasedHurtSheetFlipped = flipHorizontally(deceasedHurtSheet);
         deceasedDyingSheet = loadSprite("assets/characters/6Deceased/deceased_death.png");
-        deceasedDyingSheetFlipped = flipHorizontally(deceasedDyingSheet);
         deceasedProjectileSheet = loadSprite("assets/characters/6Deceased/fireball.png");
     }
 
@@ -408,6 +379,8 @@ void initDeceased(Deceased *deceased, int x, int y, struct GAME *game) {
     deceased->health = 40;
     deceased->maxHealth = 40;
     deceased->active = 1;
+    deceased->nav.timer = 0;
+    deceased->nav.mode = NAV_AGENT_DIRECT;
     deceased->lastFrameTime = SDL_GetTicks();
     deceased->attackCooldown = 0;
     deceased->projectilePos = (SDL_Rect){0, 0, 32, 32};
@@ -428,15 +401,15 @@ void updateDeceased(Deceased *deceased, int *playerHealth, int playerMaxHealth,
     float distance = sqrt(dx * dx + dy * dy);
     if (distance > ACTIVATION_ZONE) return;
 
-    // Update gravity and ground status
-    deceased->onGround = onGroundEnemyLvl2(game, &deceased->position, deceased->world_x);
+    // Update gravity (onGround comes from onGroundBatch())
     if (!deceased->onGround) {
         deceased->yVelocity += GRAVITY;
         if (deceased->yVelocity > MAX_FALL_SPEED) deceased->yVelocity = MAX_FALL_SPEED;
     } else {
         deceased->yVelocity = 0.0f;
     }
-    deceased->position.y += (int)deceased->yVelocity;
+    deceased->position.y += sweepMove(game, deceased->world_x, deceased->position.w,
+                                      deceased->position.y + deceased->position.h, (int)deceased->yVelocity);
     if (deceased->onGround) placeEnemyLvl2OnGround(game, &deceased->position, deceased->world_x);
 
     // Update facing direction
@@ -462,7 +435,9 @@ void updateDeceased(Deceased *deceased, int *playerHealth, int playerMaxHealth,
         deceased->attackCooldown = 1000;
     } else if (distance < CHASE_DISTANCE) {
         deceased->state = ENEMY2_WALKING;
-        deceased->xVelocity = (dx / distance) * MOVE_SPEED;
+        deceased->xVelocity = fabsf(dx / distance) * MOVE_SPEED *
+                              chaseDirection(game, &deceased->nav, deceased->world_x, deceased->position.w,
+                                             deceased->position.y + deceased->position.h, game->player2.world_x, game->player2.position.y + game->player2.position.h);
         if (deceased->attackCooldown > 0) deceased->xVelocity = -deceased->xVelocity; // Retreat after attack
     } else {
         deceased->state = ENEMY2_IDLE;
@@ -477,17 +452,24 @@ void updateDeceased(Deceased *deceased, int *playerHealth, int playerMaxHealth,
 
     // Update projectile
     if (deceased->projectileActive) {
+        int prevCenterX = deceased->projectilePos.x + deceased->projectilePos.w / 2;
+        int prevCenterY = deceased->projectilePos.y + deceased->projectilePos.h / 2;
         deceased->projectilePos.x += (int)deceased->projectileDx;
         deceased->projectilePos.y += (int)deceased->projectileDy;
         deceased->projectileDistance += 5.0f;
+        int hitsTerrain = projectileHitsTerrain(game, prevCenterX, prevCenterY,
+                                                deceased->projectilePos.x + deceased->projectilePos.w / 2,
+                                                deceased->projectilePos.y + deceased->projectilePos.h / 2);
         SDL_Rect playerRect = {game->player2.world_x, game->player2.position.y, game->player2.position.w, game->player2.position.h};
-        SDL_Surface *playerSheet = game->player2.lookingRight ? game->player2.spriteSheet : game->player2.spriteSheetFlipped;
+        SDL_Surface *playerSheet = game->player2.spriteSheet;
         SDL_Rect srcRectPlayer = game->player2.frame;
         if (!game->player2.lookingRight) {
             srcRectPlayer.x = (playerSheet->w - srcRectPlayer.x) - srcRectPlayer.w;
         }
         SDL_Rect projSrc = {0, 0, deceasedProjectileSheet->w, deceasedProjectileSheet->h};
-        if (pixelPerfectCollision(deceasedProjectileSheet, &deceased->projectilePos, &projSrc, playerSheet, &playerRect, &srcRectPlayer)) {
+        if (hitsTerrain) {
+            deceased->projectileActive = 0;
+        } else if (mirroredPixelCollision(deceasedProjectileSheet, 0, &deceased->projectilePos, &projSrc, playerSheet, !game->player2.lookingRight, &playerRect, &srcRectPlayer)) {
             *playerHealth -= 8;
             deceased->projectileActive = 0;
             if (*playerHealth <= 0) game->player2.etat = P2_DEAD;
@@ -501,18 +483,18 @@ void updateDeceased(Deceased *deceased, int *playerHealth, int playerMaxHealth,
     if (game->player2.etat == P2_ATTACK_1 && deceased->state != ENEMY2_HURT) {
         SDL_Rect attackRect = {game->player2.world_x + (game->player2.lookingRight ? 50 : -50), game->player2.position.y, 100, 100};
         SDL_Rect deceasedRect = {deceased->world_x, deceased->position.y, deceased->position.w, deceased->position.h};
-        SDL_Surface *playerSheet = game->player2.lookingRight ? game->player2.spriteSheet : game->player2.spriteSheetFlipped;
+        SDL_Surface *playerSheet = game->player2.spriteSheet;
         SDL_Rect srcRectPlayer = game->player2.frame;
         if (!game->player2.lookingRight) {
             srcRectPlayer.x = (playerSheet->w - srcRectPlayer.x) - srcRectPlayer.w;
         }
-        SDL_Surface *deceasedSheet = deceased->state == ENEMY2_IDLE ? (deceased->direction > 0 ? deceasedIdleSheet : deceasedIdleSheetFlipped) :
-                                    deceased->state == ENEMY2_WALKING ? (deceased->direction > 0 ? deceasedWalkSheet : deceasedWalkSheetFlipped) :
-                                    deceased->state == ENEMY2_ATTACKING ? (deceased->direction > 0 ? deceasedAttackSheet : deceasedAttackSheetFlipped) :
-                                    (deceased->direction > 0 ? deceasedHurtSheet : deceasedHurtSheetFlipped);
+        SDL_Surface *deceasedSheet = deceased->state == ENEMY2_IDLE ? deceasedIdleSheet :
+                                    deceased->state == ENEMY2_WALKING ? deceasedWalkSheet :
+                                    deceased->state == ENEMY2_ATTACKING ? deceasedAttackSheet :
+                                    deceasedHurtSheet;
         SDL_Rect srcRectDeceased = {deceased->frame * SPRITE_WIDTH, 0, SPRITE_WIDTH, SPRITE_HEIGHT};
 
-        if (pixelPerfectCollision(playerSheet, &attackRect, &srcRectPlayer, deceasedSheet, &deceasedRect, &srcRectDeceased)) {
+        if (mirroredPixelCollision(playerSheet, !game->player2.lookingRight, &attackRect, &srcRectPlayer, deceasedSheet, deceased->direction <= 0, &deceasedRect, &srcRectDeceased)) {
             deceased->health -= 10;
             deceased->state = ENEMY2_HURT;
             deceased->frame = 0;
@@ -561,32 +543,26 @@ void updateDeceased(Deceased *deceased, int *playerHealth, int playerMaxHealth,
 void renderDeceased(SDL_Surface *screen, Deceased *deceased, int scroll_x) {
     if (!screen || !deceased || !deceased->active) return;
 
-    SDL_Surface *sheet = deceased->direction > 0 ?
-        (deceased->state == ENEMY2_IDLE ? deceasedIdleSheet :
-         deceased->state == ENEMY2_WALKING ? deceasedWalkSheet :
-         deceased->state == ENEMY2_ATTACKING ? deceasedAttackSheet :
-         deceased->state == ENEMY2_HURT ? deceasedHurtSheet :
-         deceasedDyingSheet) :
-        (deceased->state == ENEMY2_IDLE ? deceasedIdleSheetFlipped :
-         deceased->state == ENEMY2_WALKING ? deceasedWalkSheetFlipped :
-         deceased->state == ENEMY2_ATTACKING ? deceasedAttackSheetFlipped :
-         deceased->state == ENEMY2_HURT ? deceasedHurtSheetFlipped :
-         deceasedDyingSheetFlipped);
+    SDL_Surface *sheet = deceased->state == ENEMY2_IDLE ? deceasedIdleSheet :
+                         deceased->state == ENEMY2_WALKING ? deceasedWalkSheet :
+                         deceased->state == ENEMY2_ATTACKING ? deceasedAttackSheet :
+                         deceased->state == ENEMY2_HURT ? deceasedHurtSheet :
+                         deceasedDyingSheet;
 
     SDL_Rect srcRect = {deceased->frame * SPRITE_WIDTH, 0, SPRITE_WIDTH, SPRITE_HEIGHT};
     SDL_Rect destRect = {deceased->world_x - scroll_x, deceased->position.y, SPRITE_WIDTH, SPRITE_HEIGHT};
-    SDL_BlitSurface(sheet, &srcRect, screen, &destRect);
+    blitSprite(sheet, &srcRect, screen, &destRect, deceased->direction <= 0);
 
     if (deceased->projectileActive) {
         SDL_Rect projDest = {deceased->projectilePos.x - scroll_x, deceased->projectilePos.y, 32, 32};
-        SDL_BlitSurface(deceasedProjectileSheet, NULL, screen, &projDest);
+        blitSprite(deceasedProjectileSheet, NULL, screen, &projDest, 0);
     }
 
     if (deceased->health > 0) {
         SDL_Rect healthBarBg = {deceased->world_x - scroll_x, deceased->position.y - 20, 50, 5};
-        SDL_FillRect(screen, &healthBarBg, SDL_MapRGB(screen->format, 255, 0, 0));
+        trackedFill(screen, &healthBarBg, SDL_MapRGB(screen->format, 255, 0, 0));
         SDL_Rect healthBar = {deceased->world_x - scroll_x, deceased->position.y - 20, (50 * deceased->health) / deceased->maxHealth, 5};
-        SDL_FillRect(screen, &healthBar, SDL_MapRGB(screen->format, 0, 255, 0));
+        trackedFill(screen, &healthBar, SDL_MapRGB(screen->format, 0, 255, 0));
     }
 }
 
@@ -600,19 +576,12 @@ void initGorgon(Gorgon *gorgon, int x, int y, struct GAME *game) {
 
     if (!gorgonIdleSheet) {
         gorgonIdleSheet = loadSprite("assets/characters/Gorgon_3/idle.png");
-        gorgonIdleSheetFlipped = flipHorizontally(gorgonIdleSheet);
         gorgonWalkSheet = loadSprite("assets/characters/Gorgon_3/walk.png");
-        gorgonWalkSheetFlipped = flipHorizontally(gorgonWalkSheet);
         gorgonRunSheet = loadSprite("assets/characters/Gorgon_3/run.png");
-        gorgonRunSheetFlipped = flipHorizontally(gorgonRunSheet);
         gorgonAttackSheet = loadSprite("assets/characters/Gorgon_3/attack_1.png");
-        gorgonAttackSheetFlipped = flipHorizontally(gorgonAttackSheet);
         gorgonHurtSheet = loadSprite("assets/characters/Gorgon_3/hurt.png");
-        gorgonHurtSheetFlipped = flipHorizontally(gorgonHurtSheet);
         gorgonDyingSheet = loadSprite("assets/characters/Gorgon_3/dead.png");
-        gorgonDyingSheetFlipped = flipHorizontally(gorgonDyingSheet);
         gorgonSpecialSheet = loadSprite("assets/characters/Gorgon_3/special.png");
-        gorgonSpecialSheetFlipped = flipHorizontally(gorgonSpecialSheet);
     }
 
     gorgon->position = (SDL_Rect){x, y, SPRITE_WIDTH, SPRITE_HEIGHT};
@@ -627,6 +596,8 @@ void initGorgon(Gorgon *gorgon, int x, int y, struct GAME *game) {
     gorgon->health = 60;
     gorgon->maxHealth = 60;
     gorgon->active = 1;
+    gorgon->nav.timer = 0;
+    gorgon->nav.mode = NAV_AGENT_DIRECT;
     gorgon->lastFrameTime = SDL_GetTicks();
     gorgon->attackCooldown = 0;
     gorgon->hasPetrified = 0;
@@ -646,15 +617,15 @@ void updateGorgon(Gorgon *gorgon, int *playerHealth, int playerMaxHealth, struct
     float distance = sqrt(dx * dx + dy * dy);
     if (distance > ACTIVATION_ZONE) return;
 
-    // Update gravity and ground status
-    gorgon->onGround = onGroundEnemyLvl2(game, &gorgon->position, gorgon->world_x);
+    // Update gravity (onGround comes from onGroundBatch())
     if (!gorgon->onGround) {
         gorgon->yVelocity += GRAVITY;
         if (gorgon->yVelocity > MAX_FALL_SPEED) gorgon->yVelocity = MAX_FALL_SPEED;
     } else {
         gorgon->yVelocity = 0.0f;
     }
-    gorgon->position.y += (int)gorgon->yVelocity;
+    gorgon->position.y += sweepMove(game, gorgon->world_x, gorgon->position.w,
+                                    gorgon->position.y + gorgon->position.h, (int)gorgon->yVelocity);
     if (gorgon->onGround) placeEnemyLvl2OnGround(game, &gorgon->position, gorgon->world_x);
 
     // Update facing direction
@@ -688,12 +659,16 @@ void updateGorgon(Gorgon *gorgon, int *playerHealth, int playerMaxHealth, struct
         } else {
             gorgon->state = ENEMY2_WALKING;
         }
-        gorgon->xVelocity = (dx / distance) * speed;
+        gorgon->xVelocity = fabsf(dx / distance) * speed *
+                            chaseDirection(game, &gorgon->nav, gorgon->world_x, gorgon->position.w,
+                                           gorgon->position.y + gorgon->position.h, game->player2.world_x, game->player2.position.y + game->player2.position.h);
     } else {
         gorgon->state = ENEMY2_IDLE;
         Uint32 patrolTime = currentTime / 2000;
         gorgon->direction = (patrolTime % 2 == 0) ? 1 : -1;
-        gorgon->xVelocity = gorgon->direction * MOVE_SPEED * 0.5f;
+        // The timed patrol waits at a ledge or wall until it turns back
+        gorgon->xVelocity = patrolBlocked(game, gorgon->world_x, gorgon->position.w, gorgon->position.y + gorgon->position.h,
+                                          gorgon->direction) ? 0.0f : gorgon->direction * MOVE_SPEED * 0.5f;
     }
 
     // Update position
@@ -706,20 +681,20 @@ void updateGorgon(Gorgon *gorgon, int *playerHealth, int playerMaxHealth, struct
     if (game->player2.etat == P2_ATTACK_1 && gorgon->state != ENEMY2_HURT) {
         SDL_Rect attackRect = {game->player2.world_x + (game->player2.lookingRight ? 50 : -50), game->player2.position.y, 100, 100};
         SDL_Rect gorgonRect = {gorgon->world_x, gorgon->position.y, gorgon->position.w, gorgon->position.h};
-        SDL_Surface *playerSheet = game->player2.lookingRight ? game->player2.spriteSheet : game->player2.spriteSheetFlipped;
+        SDL_Surface *playerSheet = game->player2.spriteSheet;
         SDL_Rect srcRectPlayer = game->player2.frame;
         if (!game->player2.lookingRight) {
             srcRectPlayer.x = (playerSheet->w - srcRectPlayer.x) - srcRectPlayer.w;
         }
-        SDL_Surface *gorgonSheet = gorgon->state == ENEMY2_IDLE ? (gorgon->direction > 0 ? gorgonIdleSheet : gorgonIdleSheetFlipped) :
-                                   gorgon->state == ENEMY2_WALKING ? (gorgon->direction > 0 ? gorgonWalkSheet : gorgonWalkSheetFlipped) :
-                                   gorgon->state == ENEMY2_RUNNING ? (gorgon->direction > 0 ? gorgonRunSheet : gorgonRunSheetFlipped) :
-                                   gorgon->state == ENEMY2_ATTACKING ? (gorgon->direction > 0 ? gorgonAttackSheet : gorgonAttackSheetFlipped) :
-                                   gorgon->state == ENEMY2_SPECIAL ? (gorgon->direction > 0 ? gorgonSpecialSheet : gorgonSpecialSheetFlipped) :
-                                   (gorgon->direction > 0 ? gorgonHurtSheet : gorgonHurtSheetFlipped);
+        SDL_Surface *gorgonSheet = gorgon->state == ENEMY2_IDLE ? gorgonIdleSheet :
+                                   gorgon->state == ENEMY2_WALKING ? gorgonWalkSheet :
+                                   gorgon->state == ENEMY2_RUNNING ? gorgonRunSheet :
+                                   gorgon->state == ENEMY2_ATTACKING ? gorgonAttackSheet :
+                                   gorgon->state == ENEMY2_SPECIAL ? gorgonSpecialSheet :
+                                   gorgonHurtSheet;
         SDL_Rect srcRectGorgon = {gorgon->frame * SPRITE_WIDTH, 0, SPRITE_WIDTH, SPRITE_HEIGHT};
 
-        if (pixelPerfectCollision(playerSheet, &attackRect, &srcRectPlayer, gorgonSheet, &gorgonRect, &srcRectGorgon)) {
+        if (mirroredPixelCollision(playerSheet, !game->player2.lookingRight, &attackRect, &srcRectPlayer, gorgonSheet, gorgon->direction <= 0, &gorgonRect, &srcRectGorgon)) {
             gorgon->health -= 10;
             gorgon->state = ENEMY2_HURT;
             gorgon->frame = 0;
@@ -731,15 +706,15 @@ void updateGorgon(Gorgon *gorgon, int *playerHealth, int playerMaxHealth, struct
     if (gorgon->state == ENEMY2_ATTACKING && gorgon->frame == 2 && gorgon->attackCooldown == 0) {
         SDL_Rect gorgonRect = {gorgon->world_x, gorgon->position.y, gorgon->position.w, gorgon->position.h};
         SDL_Rect playerRect = {game->player2.world_x, game->player2.position.y, game->player2.position.w, game->player2.position.h};
-        SDL_Surface *gorgonSheet = gorgon->direction > 0 ? gorgonAttackSheet : gorgonAttackSheetFlipped;
-        SDL_Surface *playerSheet = game->player2.lookingRight ? game->player2.spriteSheet : game->player2.spriteSheetFlipped;
+        SDL_Surface *gorgonSheet = gorgonAttackSheet;
+        SDL_Surface *playerSheet = game->player2.spriteSheet;
         SDL_Rect srcRectGorgon = {gorgon->frame * SPRITE_WIDTH, 0, SPRITE_WIDTH, SPRITE_HEIGHT};
         SDL_Rect srcRectPlayer = game->player2.frame;
         if (!game->player2.lookingRight) {
             srcRectPlayer.x = (playerSheet->w - srcRectPlayer.x) - srcRectPlayer.w;
         }
 
-        if (pixelPerfectCollision(gorgonSheet, &gorgonRect, &srcRectGorgon, playerSheet, &playerRect, &srcRectPlayer)) {
+        if (mirroredPixelCollision(gorgonSheet, gorgon->direction <= 0, &gorgonRect, &srcRectGorgon, playerSheet, !game->player2.lookingRight, &playerRect, &srcRectPlayer)) {
             *playerHealth -= 10;
             gorgon->attackCooldown = 1000;
             if (*playerHealth <= 0) game->player2.etat = P2_DEAD;
@@ -792,33 +767,25 @@ void updateGorgon(Gorgon *gorgon, int *playerHealth, int playerMaxHealth, struct
 void renderGorgon(SDL_Surface *screen, Gorgon *gorgon, int scroll_x) {
     if (!screen || !gorgon || !gorgon->active) return;
 
-    SDL_Surface *sheet = gorgon->direction > 0 ?
-        (gorgon->state == ENEMY2_IDLE ? gorgonIdleSheet :
-         gorgon->state == ENEMY2_WALKING ? gorgonWalkSheet :
-         gorgon->state == ENEMY2_RUNNING ? gorgonRunSheet :
-         gorgon->state == ENEMY2_ATTACKING ? gorgonAttackSheet :
-         gorgon->state == ENEMY2_HURT ? gorgonHurtSheet :
-         gorgon->state == ENEMY2_SPECIAL ? gorgonSpecialSheet :
-         gorgonDyingSheet) :
-        (gorgon->state == ENEMY2_IDLE ? gorgonIdleSheetFlipped :
-         gorgon->state == ENEMY2_WALKING ? gorgonWalkSheetFlipped :
-         gorgon->state == ENEMY2_RUNNING ? gorgonRunSheetFlipped :
-         gorgon->state == ENEMY2_ATTACKING ? gorgonAttackSheetFlipped :
-         gorgon->state == ENEMY2_HURT ? gorgonHurtSheetFlipped :
-         gorgon->state == ENEMY2_SPECIAL ? gorgonSpecialSheetFlipped :
-         gorgonDyingSheetFlipped);
+    SDL_Surface *sheet = gorgon->state == ENEMY2_IDLE ? gorgonIdleSheet :
+                         gorgon->state == ENEMY2_WALKING ? gorgonWalkSheet :
+                         gorgon->state == ENEMY2_RUNNING ? gorgonRunSheet :
+                         gorgon->state == ENEMY2_ATTACKING ? gorgonAttackSheet :
+                         gorgon->state == ENEMY2_HURT ? gorgonHurtSheet :
+                         gorgon->state == ENEMY2_SPECIAL ? gorgonSpecialSheet :
+                         gorgonDyingSheet;
 
     SDL_Rect srcRect = {gorgon->frame * SPRITE_WIDTH, 0, SPRITE_WIDTH, SPRITE_HEIGHT};
     SDL_Rect destRect = {gorgon->world_x - scroll_x, gorgon->position.y, SPRITE_WIDTH, SPRITE_HEIGHT};
-    SDL_BlitSurface(sheet, &srcRect, screen, &destRect);
+    blitSprite(sheet, &srcRect, screen, &destRect, gorgon->direction <= 0);
 
     renderParticles(screen, gorgon->particles, MAX_PARTICLES, scroll_x);
 
     if (gorgon->health > 0) {
         SDL_Rect healthBarBg = {gorgon->world_x - scroll_x, gorgon->position.y - 20, 50, 5};
-        SDL_FillRect(screen, &healthBarBg, SDL_MapRGB(screen->format, 255, 0, 0));
+        trackedFill(screen, &healthBarBg, SDL_MapRGB(screen->format, 255, 0, 0));
         SDL_Rect healthBar = {gorgon->world_x - scroll_x, gorgon->position.y - 20, (50 * gorgon->health) / gorgon->maxHealth, 5};
-        SDL_FillRect(screen, &healthBar, SDL_MapRGB(screen->format, 0, 255, 0));
+        trackedFill(screen, &healthBar, SDL_MapRGB(screen->format, 0, 255, 0));
     }
 }
 
@@ -832,21 +799,13 @@ void initSkeletonSpearman(SkeletonSpearman *spearman, int x, int y, struct GAME
 
     if (!spearmanIdleSheet) {
         spearmanIdleSheet = loadSprite("assets/characters/Skeleton_Spearman/idle.png");
-        spearmanIdleSheetFlipped = flipHorizontally(spearmanIdleSheet);
         spearmanWalkSheet = loadSprite("assets/characters/Skeleton_Spearman/walk.png");
-        spearmanWalkSheetFlipped = flipHorizontally(spearmanWalkSheet);
         spearmanRunSheet = loadSprite("assets/characters/Skeleton_Spearman/run.png");
-        spearmanRunSheetFlipped = flipHorizontally(spearmanRunSheet);
         spearmanAttackSheet = loadSprite("assets/characters/Skeleton_Spearman/attack_1.png");
-        spearmanAttackSheetFlipped = flipHorizontally(spearmanAttackSheet);
         spearmanHurtSheet = loadSprite("assets/characters/Skeleton_Spearman/hurt.png");
-        spearmanHurtSheetFlipped = flipHorizontally(spearmanHurtSheet);
         spearmanDyingSheet = loadSprite("assets/characters/Skeleton_Spearman/dead.png");
-        spearmanDyingSheetFlipped = flipHorizontally(spearmanDyingSheet);
         spearmanFallSheet = loadSprite("assets/characters/Skeleton_Spearman/fall.png");
-        spearmanFallSheetFlipped = flipHorizontally(spearmanFallSheet);
         spearmanRunAttackSheet = loadSprite("assets/characters/Skeleton_Spearman/run_attack.png");
-        spearmanRunAttackSheetFlipped = flipHorizontally(spearmanRunAttackSheet);
     }
 
     spearman->position = (SDL_Rect){x, y, SPRITE_WIDTH, SPRITE_HEIGHT};
@@ -861,6 +820,8 @@ void initSkeletonSpearman(SkeletonSpearman *spearman, int x, int y, struct GAME
     spearman->health = 45;
     spearman->maxHealth = 45;
     spearman->active = 1;
+    spearman->nav.timer = 0;
+    spearman->nav.mode = NAV_AGENT_DIRECT;
     spearman->lastFrameTime = SDL_GetTicks();
     spearman->attackCooldown = 0;
     spearman->hasFallen = 0;
@@ -877,15 +838,15 @@ void updateSkeletonSpearman(SkeletonSpearman *spearman, int *playerHealth, int p
     float distance = sqrt(dx * dx + dy * dy);
     if (distance > ACTIVATION_ZONE) return;
 
-    // Update gravity and ground status
-    spearman->onGround = onGroundEnemyLvl2(game, &spearman->position, spearman->world_x);
+    // Update gravity (onGround comes from onGroundBatch())
     if (!spearman->onGround) {
         spearman->yVelocity += GRAVITY;
         if (spearman->yVelocity > MAX_FALL_SPEED) spearman->yVelocity = MAX_FALL_SPEED;
     } else {
         spearman->yVelocity = 0.0f;
     }
-    spearman->position.y += (int)spearman->yVelocity;
+    spearman->position.y += sweepMove(game, spearman->world_x, spearman->position.w,
+                                      spearman->position.y + spearman->position.h, (int)spearman->yVelocity);
     if (spearman->onGround) placeEnemyLvl2OnGround(game, &spearman->position, spearman->world_x);
 
     // Update facing direction
@@ -918,12 +879,16 @@ void updateSkeletonSpearman(SkeletonSpearman *spearman, int *playerHealth, int p
         } else {
             spearman->state = ENEMY2_WALKING;
         }
-        spearman->xVelocity = (dx / distance) * speed;
+        spearman->xVelocity = fabsf(dx / distance) * speed *
+                              chaseDirection(game, &spearman->nav, spearman->world_x, spearman->position.w,
+                                             spearman->position.y + spearman->position.h, game->player2.world_x, game->player2.position.y + game->player2.position.h);
     } else {
         spearman->state = ENEMY2_IDLE;
         Uint32 patrolTime = currentTime / 2000;
         spearman->direction = (patrolTime % 2 == 0) ? 1 : -1;
-        spearman->xVelocity = spearman->direction * MOVE_SPEED * 0.5f;
+        // The timed patrol waits at a ledge or wall until it turns back
+        spearman->xVelocity = patrolBlocked(game, spearman->world_x, spearman->position.w, spearman->position.y + spearman->position.h,
+                                            spearman->direction) ? 0.0f : spearman->direction * MOVE_SPEED * 0.5f;
     }
 
     // Update position
@@ -936,21 +901,21 @@ void updateSkeletonSpearman(SkeletonSpearman *spearman, int *playerHealth, int p
     if (game->player2.etat == P2_ATTACK_1 && spearman->state != ENEMY2_HURT) {
         SDL_Rect attackRect = {game->player2.world_x + (game->player2.lookingRight ? 50 : -50), game->player2.position.y, 100, 100};
         SDL_Rect spearmanRect = {spearman->world_x, spearman->position.y, spearman->position.w, spearman->position.h};
-        SDL_Surface *playerSheet = game->player2.lookingRight ? game->player2.spriteSheet : game->player2.spriteSheetFlipped;
+        SDL_Surface *playerSheet = game->player2.spriteSheet;
         SDL_Rect srcRectPlayer = game->player2.frame;
         if (!game->player2.lookingRight) {
             srcRectPlayer.x = (playerSheet->w - srcRectPlayer.x) - srcRectPlayer.w;
         }
-        SDL_Surface *spearmanSheet = spearman->state == ENEMY2_IDLE ? (spearman->direction > 0 ? spearmanIdleSheet : spearmanIdleSheetFlipped) :
-                                     spearman->state == ENEMY2_WALKING ? (spearman->direction > 0 ? spearmanWalkSheet : spearmanWalkSheetFlipped) :
-                                     spearman->state == ENEMY2_RUNNING ? (spearman->direction > 0 ? spearmanRunSheet : spearmanRunSheetFlipped) :
-                                     spearman->state == ENEMY2_ATTACKING ? (spearman->direction > 0 ? spearmanAttackSheet : spearmanAttackSheetFlipped) :
-                                     spearman->state == ENEMY2_RUN_ATTACK ? (spearman->direction > 0 ? spearmanRunAttackSheet : spearmanRunAttackSheetFlipped) :
-                                     spearman->state == ENEMY2_FALL ? (spearman->direction > 0 ? spearmanFallSheet : spearmanFallSheetFlipped) :
-                                     (spearman->direction > 0 ? spearmanHurtSheet : spearmanHurtSheetFlipped);
+        SDL_Surface *spearmanSheet = spearman->state == ENEMY2_IDLE ? spearmanIdleSheet :
+                                     spearman->state == ENEMY2_WALKING ? spearmanWalkSheet :
+                                     spearman->state == ENEMY2_RUNNING ? spearmanRunSheet :
+                                     spearman->state == ENEMY2_ATTACKING ? spearmanAttackSheet :
+                                     spearman->state == ENEMY2_RUN_ATTACK ? spearmanRunAttackSheet :
+                                     spearman->state == ENEMY2_FALL ? spearmanFallSheet :
+                                     spearmanHurtSheet;
         SDL_Rect srcRectSpearman = {spearman->frame * SPRITE_WIDTH, 0, SPRITE_WIDTH, SPRITE_HEIGHT};
 
-        if (pixelPerfectCollision(playerSheet, &attackRect, &srcRectPlayer, spearmanSheet, &spearmanRect, &srcRectSpearman)) {
+        if (mirroredPixelCollision(playerSheet, !game->player2.lookingRight, &attackRect, &srcRectPlayer, spearmanSheet, spearman->direction <= 0, &spearmanRect, &srcRectSpearman)) {
             spearman->health -= 10;
             spearman->state = ENEMY2_HURT;
             spearman->frame = 0;
@@ -962,15 +927,15 @@ void updateSkeletonSpearman(SkeletonSpearman *spearman, int *playerHealth, int p
     if (spearman->state == ENEMY2_ATTACKING && spearman->frame == 2 && spearman->attackCooldown == 0) {
         SDL_Rect spearmanRect = {spearman->world_x, spearman->position.y, spearman->position.w, spearman->position.h};
         SDL_Rect playerRect = {game->player2.world_x, game->player2.position.y, game->player2.position.w, game->player2.position.h};
-        SDL_Surface *spearmanSheet = spearman->direction > 0 ? spearmanAttackSheet : spearmanAttackSheetFlipped;
-        SDL_Surface *playerSheet = game->player2.lookingRight ? game->player2.spriteSheet : game->player2.spriteSheetFlipped;
+        SDL_Surface *spearmanSheet = spearmanAttackSheet;
+        SDL_Surface *playerSheet = game->player2.spriteSheet;
         SDL_Rect srcRectSpearman = {spearman->frame * SPRITE_WIDTH, 0, SPRITE_WIDTH, SPRITE_HEIGHT};
         SDL_Rect srcRectPlayer = game->player2.frame;
         if (!game->player2.lookingRight) {
             srcRectPlayer.x = (playerSheet->w - srcRectPlayer.x) - srcRectPlayer.w;
         }
 
-        if (pixelPerfectCollision(spearmanSheet, &spearmanRect, &srcRectSpearman, playerSheet, &playerRect, &srcRectPlayer)) {
+        if (mirroredPixelCollision(spearmanSheet, spearman->direction <= 0, &spearmanRect, &srcRectSpearman, playerSheet, !game->player2.lookingRight, &playerRect, &srcRectPlayer)) {
             *playerHealth -= 7;
             spearman->attackCooldown = 1000;
             if (*playerHealth <= 0) game->player2.etat = P2_DEAD;
@@ -979,15 +944,15 @@ void updateSkeletonSpearman(SkeletonSpearman *spearman, int *playerHealth, int p
     } else if (spearman->state == ENEMY2_RUN_ATTACK && spearman->frame == 2 && spearman->attackCooldown == 0) {
         SDL_Rect spearmanRect = {spearman->world_x, spearman->position.y, spearman->position.w, spearman->position.h};
         SDL_Rect playerRect = {game->player2.world_x, game->player2.position.y, game->player2.position.w, game->player2.position.h};
-        SDL_Surface *spearmanSheet = spearman->direction > 0 ? spearmanRunAttackSheet : spearmanRunAttackSheetFlipped;
-        SDL_Surface *playerSheet = game->player2.lookingRight ? game->player2.spriteSheet : game->player2.spriteSheetFlipped;
+        SDL_Surface *spearmanSheet = spearmanRunAttackSheet;
+        SDL_Surface *playerSheet = game->player2.spriteSheet;
         SDL_Rect srcRectSpearman = {spearman->frame * SPRITE_WIDTH, 0, SPRITE_WIDTH, SPRITE_HEIGHT};
         SDL_Rect srcRectPlayer = game->player2.frame;
         if (!game->player2.lookingRight) {
             srcRectPlayer.x = (playerSheet->w - srcRectPlayer.x) - srcRectPlayer.w;
         }
 
-        if (pixelPerfectCollision(spearmanSheet, &spearmanRect, &srcRectSpearman, playerSheet, &playerRect, &srcRectPlayer)) {
+        if (mirroredPixelCollision(spearmanSheet, spearman->direction <= 0, &spearmanRect, &srcRectSpearman, playerSheet, !game->player2.lookingRight, &playerRect, &srcRectPlayer)) {
             *playerHealth -= 10;
             spearman->attackCooldown = 1000;
             if (*playerHealth <= 0) game->player2.etat = P2_DEAD;
@@ -1039,33 +1004,24 @@ void updateSkeletonSpearman(SkeletonSpearman *spearman, int *playerHealth, int p
 void renderSkeletonSpearman(SDL_Surface *screen, SkeletonSpearman *spearman, int scroll_x) {
     if (!screen || !spearman || !spearman->active) return;
 
-    SDL_Surface *sheet = spearman->direction > 0 ?
-        (spearman->state == ENEMY2_IDLE ? spearmanIdleSheet :
-         spearman->state == ENEMY2_WALKING ? spearmanWalkSheet :
-         spearman->state == ENEMY2_RUNNING ? spearmanRunSheet :
-         spearman->state == ENEMY2_ATTACKING ? spearmanAttackSheet :
-         spearman->state == ENEMY2_HURT ? spearmanHurtSheet :
-         spearman->state == ENEMY2_FALL ? spearmanFallSheet :
-         spearman->state == ENEMY2_RUN_ATTACK ? spearmanRunAttackSheet :
-         spearmanDyingSheet) :
-        (spearman->state == ENEMY2_IDLE ? spearmanIdleSheetFlipped :
-         spearman->state == ENEMY2_WALKING ? spearmanWalkSheetFlipped :
-         spearman->state == ENEMY2_RUNNING ? spearmanRunSheetFlipped :
-         spearman->state == ENEMY2_ATTACKING ? spearmanAttackSheetFlipped :
-         spearman->state == ENEMY2_HURT ? spearmanHurtSheetFlipped :
-         spearman->state == ENEMY2_FALL ? spearmanFallSheetFlipped :
-         spearman->state == ENEMY2_RUN_ATTACK ? spearmanRunAttackSheetFlipped :
-         spearmanDyingSheetFlipped);
+    SDL_Surface *sheet = spearman->state == ENEMY2_IDLE ? spearmanIdleSheet :
+                         spearman->state == ENEMY2_WALKING ? spearmanWalkSheet :
+                         spearman->state == ENEMY2_RUNNING ? spearmanRunSheet :
+                         spearman->state == ENEMY2_ATTACKING ? spearmanAttackSheet :
+                         spearman->state == ENEMY2_HURT ? spearmanHurtSheet :
+                         spearman->state == ENEMY2_FALL ? spearmanFallSheet :
+                         spearman->state == ENEMY2_RUN_ATTACK ? spearmanRunAttackSheet :
+                         spearmanDyingSheet;
 
     SDL_Rect srcRect = {spearman->frame * SPRITE_WIDTH, 0, SPRITE_WIDTH, SPRITE_HEIGHT};
     SDL_Rect destRect = {spearman->world_x - scroll_x, spearman->position.y, SPRITE_WIDTH, SPRITE_HEIGHT};
-    SDL_BlitSurface(sheet, &srcRect, screen, &destRect);
+    blitSprite(sheet, &srcRect, screen, &destRect, spearman->direction <= 0);
 
     if (spearman->health > 0) {
         SDL_Rect healthBarBg = {spearman->world_x - scroll_x, spearman->position.y - 20, 50, 5};
-        SDL_FillRect(screen, &healthBarBg, SDL_MapRGB(screen->format, 255, 0, 0));
+        trackedFill(screen, &healthBarBg, SDL_MapRGB(screen->format, 255, 0, 0));
         SDL_Rect healthBar = {spearman->world_x - scroll_x, spearman->position.y - 20, (50 * spearman->health) / spearman->maxHealth, 5};
-        SDL_FillRect(screen, &healthBar, SDL_MapRGB(screen->format, 0, 255, 0));
+        trackedFill(screen, &healthBar, SDL_MapRGB(screen->format, 0, 255, 0));
     }
 }
 
@@ -1075,74 +1031,42 @@ void freeSkeletonSpearman(SkeletonSpearman *spearman) {
 
 // --- Free all enemy sprites ---
 void freeEnemyLvl2Sprites() {
-    if (mummyIdleSheet) SDL_FreeSurface(mummyIdleSheet);
-    if (mummyIdleSheetFlipped) SDL_FreeSurface(mummyIdleSheetFlipped);
-    if (mummyWalkSheet) SDL_FreeSurface(mummyWalkSheet);
-    if (mummyWalkSheetFlipped) SDL_FreeSurface(mummyWalkSheetFlipped);
-    if (mummyAttackSheet) SDL_FreeSurface(mummyAttackSheet);
-    if (mummyAttackSheetFlipped) SDL_FreeSurface(mummyAttackSheetFlipped);
-    if (mummyHurtSheet) SDL_FreeSurface(mummyHurtSheet);
-    if (mummyHurtSheetFlipped) SDL_FreeSurface(mummyHurtSheetFlipped);
-    if (mummyDyingSheet) SDL_FreeSurface(mummyDyingSheet);
-    if (mummyDyingSheetFlipped) SDL_FreeSurface(mummyDyingSheetFlipped);
-
-    if (deceasedIdleSheet) SDL_FreeSurface(deceasedIdleSheet);
-    if (deceasedIdleSheetFlipped) SDL_FreeSurface(deceasedIdleSheetFlipped);
-    if (deceasedWalkSheet) SDL_FreeSurface(deceasedWalkSheet);
-    if (deceasedWalkSheetFlipped) SDL_FreeSurface(deceasedWalkSheetFlipped);
-    if (deceasedAttackSheet) SDL_FreeSurface(deceasedAttackSheet);
-    if (deceasedAttackSheetFlipped) SDL_FreeSurface(deceasedAttackSheetFlipped);
-    if (deceasedHurtSheet) SDL_FreeSurface(deceasedHurtSheet);
-    if (deceasedHurtSheetFlipped) SDL_FreeSurface(deceasedHurtSheetFlipped);
-    if (deceasedDyingSheet) SDL_FreeSurface(deceasedDyingSheet);
-    if (deceasedDyingSheetFlipped) SDL_FreeSurface(deceasedDyingSheetFlipped);
-    if (deceasedProjectileSheet) SDL_FreeSurface(deceasedProjectileSheet);
-
-    if (gorgonIdleSheet) SDL_FreeSurface(gorgonIdleSheet);
-    if (gorgonIdleSheetFlipped) SDL_FreeSurface(gorgonIdleSheetFlipped);
-    if (gorgonWalkSheet) SDL_FreeSurface(gorgonWalkSheet);
-    if (gorgonWalkSheetFlipped) SDL_FreeSurface(gorgonWalkSheetFlipped);
-    if (gorgonRunSheet) SDL_FreeSurface(gorgonRunSheet);
-    if (gorgonRunSheetFlipped) SDL_FreeSurface(gorgonRunSheetFlipped);
-    if (gorgonAttackSheet) SDL_FreeSurface(gorgonAttackSheet);
-    if (gorgonAttackSheetFlipped) SDL_FreeSurface(gorgonAttackSheetFlipped);
-    if (gorgonHurtSheet) SDL_FreeSurface(gorgonHurtSheet);
-    if (gorgonHurtSheetFlipped) SDL_FreeSurface(gorgonHurtSheetFlipped);
-    if (gorgonDyingSheet) SDL_FreeSurface(gorgonDyingSheet);
-    if (gorgonDyingSheetFlipped) SDL_FreeSurface(gorgonDyingSheetFlipped);
-    if (gorgonSpecialSheet) SDL_FreeSurface(gorgonSpecialSheet);
-    if (gorgonSpecialSheetFlipped) SDL_FreeSurface(gorgonSpecialSheetFlipped);
-
-    if (spearmanIdleSheet) SDL_FreeSurface(spearmanIdleSheet);
-    if (spearmanIdleSheetFlipped) SDL_FreeSurface(spearmanIdleSheetFlipped);
-    if (spearmanWalkSheet) SDL_FreeSurface(spearmanWalkSheet);
-    if (spearmanWalkSheetFlipped) SDL_FreeSurface(spearmanWalkSheetFlipped);
-    if (spearmanRunSheet) SDL_FreeSurface(spearmanRunSheet);
-    if (spearmanRunSheetFlipped) SDL_FreeSurface(spearmanRunSheetFlipped);
-    if (spearmanAttackSheet) SDL_FreeSurface(spearmanAttackSheet);
-    if (spearmanAttackSheetFlipped) SDL_FreeSurface(spearmanAttackSheetFlipped);
-    if (spearmanHurtSheet) SDL_FreeSurface(spearmanHurtSheet);
-    if (spearmanHurtSheetFlipped) SDL_FreeSurface(spearmanHurtSheetFlipped);
-    if (spearmanDyingSheet) SDL_FreeSurface(spearmanDyingSheet);
-    if (spearmanDyingSheetFlipped) SDL_FreeSurface(spearmanDyingSheetFlipped);
-    if (spearmanFallSheet) SDL_FreeSurface(spearmanFallSheet);
-    if (spearmanFallSheetFlipped) SDL_FreeSurface(spearmanFallSheetFlipped);
-    if (spearmanRunAttackSheet) SDL_FreeSurface(spearmanRunAttackSheet);
-    if (spearmanRunAttackSheetFlipped) SDL_FreeSurface(spearmanRunAttackSheetFlipped);
+    if (mummyIdleSheet) freeSprite(mummyIdleSheet);
+    if (mummyWalkSheet) freeSprite(mummyWalkSheet);
+    if (mummyAttackSheet) freeSprite(mummyAttackSheet);
+    if (mummyHurtSheet) freeSprite(mummyHurtSheet);
+    if (mummyDyingSheet) freeSprite(mummyDyingSheet);
+
+    if (deceasedIdleSheet) freeSprite(deceasedIdleSheet);
+    if (deceasedWalkSheet) freeSprite(deceasedWalkSheet);
+    if (deceasedAttackSheet) freeSprite(deceasedAttackSheet);
+    if (deceasedHurtSheet) freeSprite(deceasedHurtSheet);
+    if (deceasedDyingSheet) freeSprite(deceasedDyingSheet);
+    if (deceasedProjectileSheet) freeSprite(deceasedProjectileSheet);
+
+    if (gorgonIdleSheet) freeSprite(gorgonIdleSheet);
+    if (gorgonWalkSheet) freeSprite(gorgonWalkSheet);
+    if (gorgonRunSheet) freeSprite(gorgonRunSheet);
+    if (gorgonAttackSheet) freeSprite(gorgonAttackSheet);
+    if (gorgonHurtSheet) freeSprite(gorgonHurtSheet);
+    if (gorgonDyingSheet) freeSprite(gorgonDyingSheet);
+    if (gorgonSpecialSheet) freeSprite(gorgonSpecialSheet);
+
+    if (spearmanIdleSheet) freeSprite(spearmanIdleSheet);
+    if (spearmanWalkSheet) freeSprite(spearmanWalkSheet);
+    if (spearmanRunSheet) freeSprite(spearmanRunSheet);
+    if (spearmanAttackSheet) freeSprite(spearmanAttackSheet);
+    if (spearmanHurtSheet) freeSprite(spearmanHurtSheet);
+    if (spearmanDyingSheet) freeSprite(spearmanDyingSheet);
+    if (spearmanFallSheet) freeSprite(spearmanFallSheet);
+    if (spearmanRunAttackSheet) freeSprite(spearmanRunAttackSheet);
 
     // Reset pointers to NULL
-    mummyIdleSheet = mummyIdleSheetFlipped = mummyWalkSheet = mummyWalkSheetFlipped = NULL;
-    mummyAttackSheet = mummyAttackSheetFlipped = mummyHurtSheet = mummyHurtSheetFlipped = NULL;
-    mummyDyingSheet = mummyDyingSheetFlipped = NULL;
-    deceasedIdleSheet = deceasedIdleSheetFlipped = deceasedWalkSheet = deceasedWalkSheetFlipped = NULL;
-    deceasedAttackSheet = deceasedAttackSheetFlipped = deceasedHurtSheet = deceasedHurtSheetFlipped = NULL;
-    deceasedDyingSheet = deceasedDyingSheetFlipped = deceasedProjectileSheet = NULL;
-    gorgonIdleSheet = gorgonIdleSheetFlipped = gorgonWalkSheet = gorgonWalkSheetFlipped = NULL;
-    gorgonRunSheet = gorgonRunSheetFlipped = gorgonAttackSheet = gorgonAttackSheetFlipped = NULL;
-    gorgonHurtSheet = gorgonHurtSheetFlipped = gorgonDyingSheet = gorgonDyingSheetFlipped = NULL;
-    gorgonSpecialSheet = gorgonSpecialSheetFlipped = NULL;
-    spearmanIdleSheet = spearmanIdleSheetFlipped = spearmanWalkSheet = spearmanWalkSheetFlipped = NULL;
-    spearmanRunSheet = spearmanRunSheetFlipped = spearmanAttackSheet = spearmanAttackSheetFlipped = NULL;
-    spearmanHurtSheet = spearmanHurtSheetFlipped = spearmanDyingSheet = spearmanDyingSheetFlipped = NULL;
-    spearmanFallSheet = spearmanFallSheetFlipped = spearmanRunAttackSheet = spearmanRunAttackSheetFlipped = NULL;
+    mummyIdleSheet = mummyWalkSheet = mummyAttackSheet = mummyHurtSheet = mummyDyingSheet = NULL;
+    deceasedIdleSheet = deceasedWalkSheet = deceasedAttackSheet = NULL;
+    deceasedHurtSheet = deceasedDyingSheet = deceasedProjectileSheet = NULL;
+    gorgonIdleSheet = gorgonWalkSheet = gorgonRunSheet = gorgonAttackSheet = NULL;
+    gorgonHurtSheet = gorgonDyingSheet = gorgonSpecialSheet = NULL;
+    spearmanIdleSheet = spearmanWalkSheet = spearmanRunSheet = spearmanAttackSheet = NULL;
+    spearmanHurtSheet = spearmanDyingSheet = spearmanFallSheet = spearmanRunAttackSheet = NULL;
 }
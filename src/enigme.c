@@ -9,9 +9,11 @@
 #include <SDL/SDL_mixer.h>
 #include <SDL/SDL_rotozoom.h>
 #include "enigme.h"
+#include "textcache.h"
 
 SDL_Color color_correct = {0, 255, 0, 255};
 SDL_Color color_incorrect = {255, 0, 0, 255};
+static TTF_Font *questionFont = NULL;  // afficherEnigme()'s font, opened on first use
 
 int initialiserBackg(Bg *b) {
     fprintf(stderr, "DEBUG: Initializing background\n");
@@ -33,7 +35,7 @@ void afficherBackg(Bg b, SDL_Surface *ecran) {
         fprintf(stderr, "ERROR: Invalid background or screen surface\n");
         return;
     }
-    SDL_BlitSurface(b.Bg, NULL, ecran, &b.posAff);
+    trackedBlit(b.Bg, NULL, ecran, &b.posAff);
     fprintf(stderr, "DEBUG: Background blitted\n");
 }
 
@@ -67,10 +69,10 @@ void afficherA(A a, SDL_Surface *ecran, int isHovered) {
         return;
     }
     if (isHovered && a.choixAGlow) {
-        SDL_BlitSurface(a.choixAGlow, NULL, ecran, &a.posA);
+        trackedBlit(a.choixAGlow, NULL, ecran, &a.posA);
         fprintf(stderr, "DEBUG: Button A glow blitted\n");
     } else if (a.choixA) {
-        SDL_BlitSurface(a.choixA, NULL, ecran, &a.posA);
+        trackedBlit(a.choixA, NULL, ecran, &a.posA);
         fprintf(stderr, "DEBUG: Button A blitted\n");
     }
 }
@@ -110,10 +112,10 @@ void afficherB(B b, SDL_Surface *ecran, int isHovered) {
         return;
     }
     if (isHovered && b.choixBGlow) {
-        SDL_BlitSurface(b.choixBGlow, NULL, ecran, &b.posB);
+        trackedBlit(b.choixBGlow, NULL, ecran, &b.posB);
         fprintf(stderr, "DEBUG: Button B glow blitted\n");
     } else if (b.choixB) {
-        SDL_BlitSurface(b.choixB, NULL, ecran, &b.posB);
+        trackedBlit(b.choixB, NULL, ecran, &b.posB);
         fprintf(stderr, "DEBUG: Button B blitted\n");
     }
 }
@@ -153,10 +155,10 @@ void afficherC(C c, SDL_Surface *ecran, int isHovered) {
         return;
     }
     if (isHovered && c.choixCGlow) {
-        SDL_BlitSurface(c.choixCGlow, NULL, ecran, &c.posC);
+        trackedBlit(c.choixCGlow, NULL, ecran, &c.posC);
         fprintf(stderr, "DEBUG: Button C glow blitted\n");
     } else if (c.choixC) {
-        SDL_BlitSurface(c.choixC, NULL, ecran, &c.posC);
+        trackedBlit(c.choixC, NULL, ecran, &c.posC);
         fprintf(stderr, "DEBUG: Button C blitted\n");
     }
 }
@@ -236,45 +238,30 @@ void afficherEnigme(SDL_Surface *screen, Enigme *e) {
         return;
     }
     fprintf(stderr, "DEBUG: Displaying enigme\n");
-    TTF_Font *font = TTF_OpenFont("assets/enigma/arial.ttf", 28);
-    if (!font) {
-        fprintf(stderr, "ERROR: Failed to load font: %s\n", TTF_GetError());
-        return;
+    if (!questionFont) {
+        questionFont = TTF_OpenFont("assets/enigma/arial.ttf", 28);
+        if (!questionFont) {
+            fprintf(stderr, "ERROR: Failed to load font: %s\n", TTF_GetError());
+            return;
+        }
     }
     SDL_Color color = {255, 255, 255, 255};
 
-    SDL_Surface *texte_question = TTF_RenderUTF8_Blended(font, e->question, color);
-    SDL_Surface *texte_reponse1 = TTF_RenderUTF8_Blended(font, e->answers[0], color);
-    SDL_Surface *texte_reponse2 = TTF_RenderUTF8_Blended(font, e->answers[1], color);
-    SDL_Surface *texte_reponse3 = TTF_RenderUTF8_Blended(font, e->answers[2], color);
-
-    SDL_Rect position_question = {100, 100, 0, 0};
-    SDL_Rect position_reponse1 = {400, 180, 0, 0};
-    SDL_Rect position_reponse2 = {400, 340, 0, 0};
-    SDL_Rect position_reponse3 = {400, 500, 0, 0};
-
+    // Each cached surface is blitted before the next lookup, which may evict it
+    SDL_Surface *texte_question = cachedText(questionFont, e->question, color, TEXT_UTF8_BLENDED);
     if (texte_question) {
-        SDL_BlitSurface(texte_question, NULL, screen, &position_question);
+        SDL_Rect position_question = {100, 100, 0, 0};
+        trackedBlit(texte_question, NULL, screen, &position_question);
         fprintf(stderr, "DEBUG: Question blitted\n");
     }
-    if (texte_reponse1) {
-        SDL_BlitSurface(texte_reponse1, NULL, screen, &position_reponse1);
-        fprintf(stderr, "DEBUG: Answer 1 blitted\n");
-    }
-    if (texte_reponse2) {
-        SDL_BlitSurface(texte_reponse2, NULL, screen, &position_reponse2);
-        fprintf(stderr, "DEBUG: Answer 2 blitted\n");
-    }
-    if (texte_reponse3) {
-        SDL_BlitSurface(texte_reponse3, NULL, screen, &position_reponse3);
-        fprintf(stderr, "DEBUG: Answer 3 blitted\n");
+    for (int i = 0; i < 3; i++) {
+        SDL_Surface *texte_reponse = cachedText(questionFont, e->answers[i], color, TEXT_UTF8_BLENDED);
+        if (texte_reponse) {
+            SDL_Rect position_reponse = {400, 180 + i * 160, 0, 0};
+            trackedBlit(texte_reponse, NULL, screen, &position_reponse);
+            fprintf(stderr, "DEBUG: Answer %d blitted\n", i + 1);
+        }
     }
-
-    SDL_FreeSurface(texte_question);
-    SDL_FreeSurface(texte_reponse1);
-    SDL_FreeSurface(texte_reponse2);
-    SDL_FreeSurface(texte_reponse3);
-    TTF_CloseFont(font);
 }
 
 int checkEnigme(SDL_Event *event, Enigme *e) {
@@ -338,7 +325,7 @@ void displayScoreMessage(SDL_Surface *screen, int score, int isCorrect) {
         return;
     }
     SDL_Color bgColor = isCorrect ? color_correct : color_incorrect;
-    SDL_FillRect(message, NULL, SDL_MapRGB(message->format, bgColor.r, bgColor.g, bgColor.b));
+    trackedFill(message, NULL, SDL_MapRGB(message->format, bgColor.r, bgColor.g, bgColor.b));
 
     SDL_Surface *mask = createMask(SCREEN_WIDTH, SCREEN_HEIGHT, MASK_OPACITY);
     if (!mask) {
@@ -346,7 +333,7 @@ void displayScoreMessage(SDL_Surface *screen, int score, int isCorrect) {
         SDL_FreeSurface(message);
         return;
     }
-    SDL_BlitSurface(mask, NULL, message, NULL);
+    trackedBlit(mask, NULL, message, NULL);
     SDL_FreeSurface(mask);
 
     TTF_Font *font = TTF_OpenFont("assets/enigma/arial.ttf", 36);
@@ -361,11 +348,11 @@ void displayScoreMessage(SDL_Surface *screen, int score, int isCorrect) {
     SDL_Surface *text = TTF_RenderUTF8_Blended(font, scoreText, textColor);
     if (text) {
         SDL_Rect textPos = {(SCREEN_WIDTH - text->w)/2, (SCREEN_HEIGHT - text->h)/2, 0, 0};
-        SDL_BlitSurface(text, NULL, message, &textPos);
+        trackedBlit(text, NULL, message, &textPos);
         SDL_FreeSurface(text);
         fprintf(stderr, "DEBUG: Score text blitted\n");
     }
-    SDL_BlitSurface(message, NULL, screen, NULL);
+    trackedBlit(message, NULL, screen, NULL);
     SDL_Flip(screen);
     SDL_Delay(1500);
     SDL_FreeSurface(message);
@@ -383,11 +370,11 @@ void displayGameOver(SDL_Surface *screen, int score, int triesLeft) {
         fprintf(stderr, "ERROR: Failed to create game over surface\n");
         return;
     }
-    SDL_FillRect(message, NULL, SDL_MapRGB(message->format, 0, 0, 0));
+    trackedFill(message, NULL, SDL_MapRGB(message->format, 0, 0, 0));
 
     SDL_Surface *mask = createMask(SCREEN_WIDTH, SCREEN_HEIGHT, MASK_OPACITY);
     if (mask) {
-        SDL_BlitSurface(mask, NULL, message, NULL);
+        trackedBlit(mask, NULL, message, NULL);
         SDL_FreeSurface(mask);
     }
 
@@ -407,11 +394,11 @@ void displayGameOver(SDL_Surface *screen, int score, int triesLeft) {
     SDL_Surface *text = TTF_RenderUTF8_Blended(font, gameOverText, textColor);
     if (text) {
         SDL_Rect textPos = {(SCREEN_WIDTH - text->w)/2, (SCREEN_HEIGHT - text->h)/2, 0, 0};
-        SDL_BlitSurface(text, NULL, message, &textPos);
+        trackedBlit(text, NULL, message, &textPos);
         SDL_FreeSurface(text);
         fprintf(stderr, "DEBUG: Game over text blitted\n");
     }
-    SDL_BlitSurface(message, NULL, screen, NULL);
+    trackedBlit(message, NULL, screen, NULL);
     SDL_Flip(screen);
     SDL_Delay(3000);
     SDL_FreeSurface(message);
@@ -426,7 +413,7 @@ SDL_Surface* createMask(int width, int height, Uint8 opacity) {
         fprintf(stderr, "ERROR: Failed to create mask surface\n");
         return NULL;
     }
-    SDL_FillRect(mask, NULL, SDL_MapRGBA(mask->format, 0, 0, 0, opacity));
+    trackedFill(mask, NULL, SDL_MapRGBA(mask->format, 0, 0, 0, opacity));
     return mask;
 }
 
@@ -452,9 +439,9 @@ void showRotozoomAnimation(SDL_Surface *screen, const char *imagePath, int durat
 
         SDL_Surface *rotated = rotozoomSurface(image, angle, zoom, 1);
         if (rotated) {
-            SDL_FillRect(screen, NULL, SDL_MapRGB(screen->format, 0, 0, 0));
+            trackedFill(screen, NULL, SDL_MapRGB(screen->format, 0, 0, 0));
             SDL_Rect pos = {(SCREEN_WIDTH - rotated->w)/2, (SCREEN_HEIGHT - rotated->h)/2};
-            SDL_BlitSurface(rotated, NULL, screen, &pos);
+            trackedBlit(rotated, NULL, screen, &pos);
             SDL_Flip(screen);
             SDL_FreeSurface(rotated);
         }
@@ -481,9 +468,9 @@ void showChestAnimation(SDL_Surface *screen) {
 
     Uint32 startTime = SDL_GetTicks();
     while (SDL_GetTicks() - startTime < 3000) {
-        SDL_FillRect(screen, NULL, SDL_MapRGB(screen->format, 0, 0, 0));
+        trackedFill(screen, NULL, SDL_MapRGB(screen->format, 0, 0, 0));
         srcRect.x = frame * 64;
-        SDL_BlitSurface(spriteSheet, &srcRect, screen, &destRect);
+        trackedBlit(spriteSheet, &srcRect, screen, &destRect);
         SDL_Flip(screen);
         frame = (frame + 1) % numFrames;
         SDL_Delay(200);
@@ -640,7 +627,7 @@ void renderEnigme(GAME *game) {
     }
 
     EnigmaData *enigmaData = (EnigmaData *)game->enigma;
-    SDL_FillRect(game->screen, NULL, SDL_MapRGB(game->screen->format, 0, 0, 0));
+    trackedFill(game->screen, NULL, SDL_MapRGB(game->screen->format, 0, 0, 0));
     afficherBackg(enigmaData->background, game->screen);
     afficherEnigme(game->screen, &enigmaData->enigme);
     afficherA(enigmaData->boutonA, game->screen, enigmaData->hoverA);
@@ -648,7 +635,7 @@ void renderEnigme(GAME *game) {
     afficherC(enigmaData->boutonC, game->screen, enigmaData->hoverC);
 
     if (enigmaData->chronoImages[enigmaData->currentImage]) {
-        SDL_BlitSurface(enigmaData->chronoImages[enigmaData->currentImage], NULL, game->screen, &enigmaData->chronoPos);
+        trackedBlit(enigmaData->chronoImages[enigmaData->currentImage], NULL, game->screen, &enigmaData->chronoPos);
         fprintf(stderr, "DEBUG: Chrono image %d blitted at (%d, %d)\n", enigmaData->currentImage, enigmaData->chronoPos.x, enigmaData->chronoPos.y);
     }
 
@@ -657,11 +644,10 @@ void renderEnigme(GAME *game) {
         sprintf(infoText, "Essais: %d/%d | Score: %d | Combo: x%d",
                 enigmaData->triesLeft, MAX_TRIES, enigmaData->score, enigmaData->combo);
         SDL_Color white = {255, 255, 255, 255};
-        SDL_Surface *text = TTF_RenderText_Blended(enigmaData->font, infoText, white);
+        SDL_Surface *text = cachedText(enigmaData->font, infoText, white, TEXT_BLENDED);
         if (text) {
             SDL_Rect textPos = {20, 20, 0, 0};
-            SDL_BlitSurface(text, NULL, game->screen, &textPos);
-            SDL_FreeSurface(text);
+            trackedBlit(text, NULL, game->screen, &textPos);
             fprintf(stderr, "DEBUG: Info text blitted\n");
         }
     }
@@ -696,9 +682,15 @@ void freeEnigme(GAME *game) {
         enigmaData->buttonSound = NULL;
     }
     if (enigmaData->font) {
+        releaseTextFont(enigmaData->font);
         TTF_CloseFont(enigmaData->font);
         enigmaData->font = NULL;
     }
+    if (questionFont) {
+        releaseTextFont(questionFont);
+        TTF_CloseFont(questionFont);
+        questionFont = NULL;
+    }
     libererMusique(NULL);
     free(enigmaData);
     game->enigma = NULL;
@@ -66,6 +66,9 @@ void handleEvents(GAME *game) {
                     case SDLK_k:
                         game->input.skip = 1;
                         break;
+                    case SDLK_F3:
+                        toggleDebugOverlay(&game->debug);
+                        break;
                     case SDLK_f:
                         game->inventory.selectedSlot = (game->inventory.selectedSlot + 1) % MAX_ITEMS; // Cycle selected slot
                         printf("Selected slot %d\n", game->inventory.selectedSlot);
@@ -36,6 +36,9 @@ void handleEventsPlayer2(GAME *game) {
                     case SDLK_ESCAPE:
                         game->running = 0;
                         break;
+                    case SDLK_F3:
+                        toggleDebugOverlay(&game->debug);
+                        break;
                     default:
                         break;
                 }
@@ -0,0 +1,163 @@
+#include "glyphatlas.h"
+#include "atlas.h"
+#include "spriteblit.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    TTF_Font *font;
+    SDL_Color color;
+    SDL_Surface *sheet;             // GLYPH_COLUMNS-wide grid of cellW x cellH cells, one per glyph
+    int cellW, cellH;
+    Sint16 minx[GLYPH_COUNT], maxx[GLYPH_COUNT], advance[GLYPH_COUNT];
+    Uint32 lastUsed;
+} GlyphSet;
+
+static GlyphSet glyphSets[MAX_GLYPH_SETS];
+static Uint32 useClock = 0;
+
+static void freeGlyphSet(GlyphSet *set) {
+    if (set->sheet) {
+        unpackSpriteSheet(set->sheet);
+        SDL_FreeSurface(set->sheet);
+    }
+    memset(set, 0, sizeof(*set));
+}
+
+// Solid glyphs are 8-bit with the background as colorkey; every other index is drawn opaque
+static void copyGlyph(SDL_Surface *glyph, SDL_Surface *sheet, int x, int y) {
+    if (glyph->format->BytesPerPixel != 1 || !glyph->format->palette) return;
+    if (SDL_MUSTLOCK(glyph)) SDL_LockSurface(glyph);
+    for (int gy = 0; gy < glyph->h; gy++) {
+        const Uint8 *src = (const Uint8 *)glyph->pixels + gy * glyph->pitch;
+        Uint32 *dst = (Uint32 *)((Uint8 *)sheet->pixels + (y + gy) * sheet->pitch) + x;
+        for (int gx = 0; gx < glyph->w; gx++) {
+            if ((glyph->flags & SDL_SRCCOLORKEY) && src[gx] == glyph->format->colorkey) continue;
+            SDL_Color c = glyph->format->palette->colors[src[gx]];
+            dst[gx] = SDL_MapRGBA(sheet->format, c.r, c.g, c.b, SDL_ALPHA_OPAQUE);
+        }
+    }
+    if (SDL_MUSTLOCK(glyph)) SDL_UnlockSurface(glyph);
+}
+
+// Renders every glyph of the set once, each as TTF_RenderText_Solid() draws it on its own,
+// into a per-pixel alpha sheet that then goes into the sprite atlas
+static int buildGlyphSet(GlyphSet *set, TTF_Font *font, SDL_Color color) {
+    SDL_Surface *glyphs[GLYPH_COUNT] = {NULL};
+    int cellW = 1, cellH = TTF_FontHeight(font);
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        Uint16 ch = GLYPH_FIRST + i;
+        int minx, maxx, miny, maxy, advance;
+        set->minx[i] = set->maxx[i] = set->advance[i] = 0;
+        if (ch >= 127 && ch < 160) continue;    // Control characters
+        if (TTF_GlyphMetrics(font, ch, &minx, &maxx, &miny, &maxy, &advance) < 0) continue;
+        set->minx[i] = minx;
+        set->maxx[i] = maxx;
+        set->advance[i] = advance;
+        char text[2] = {(char)ch, '\0'};
+        glyphs[i] = TTF_RenderText_Solid(font, text, color);
+        if (glyphs[i] && glyphs[i]->w > cellW) cellW = glyphs[i]->w;
+        if (glyphs[i] && glyphs[i]->h > cellH) cellH = glyphs[i]->h;
+    }
+
+    int rows = (GLYPH_COUNT + GLYPH_COLUMNS - 1) / GLYPH_COLUMNS;
+    SDL_Surface *sheet = SDL_CreateRGBSurface(SDL_SWSURFACE, cellW * GLYPH_COLUMNS, cellH * rows, 32,
+                                              0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+    if (sheet) {
+        SDL_FillRect(sheet, NULL, 0);
+        for (int i = 0; i < GLYPH_COUNT; i++) {
+            if (glyphs[i]) copyGlyph(glyphs[i], sheet, (i % GLYPH_COLUMNS) * cellW, (i / GLYPH_COLUMNS) * cellH);
+        }
+    } else {
+        fprintf(stderr, "buildGlyphSet: Failed to create %dx%d glyph sheet: %s\n",
+                cellW * GLYPH_COLUMNS, cellH * rows, SDL_GetError());
+    }
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        if (glyphs[i]) SDL_FreeSurface(glyphs[i]);
+    }
+    if (!sheet) return 0;
+
+    // An unpacked sheet still draws, through SDL's per-pixel alpha blitter
+    packSpriteSheet(sheet, cellW, cellH);
+    set->font = font;
+    set->color = color;
+    set->sheet = sheet;
+    set->cellW = cellW;
+    set->cellH = cellH;
+    printf("Glyph set built: %d glyphs in %dx%d cells\n", GLYPH_COUNT, cellW, cellH);
+    return 1;
+}
+
+// The set for (font, colour), built on first use; the least recently used set makes room
+static GlyphSet *findGlyphSet(TTF_Font *font, SDL_Color color) {
+    GlyphSet *slot = NULL;
+    for (int i = 0; i < MAX_GLYPH_SETS; i++) {
+        GlyphSet *set = &glyphSets[i];
+        if (set->font == font && set->color.r == color.r && set->color.g == color.g && set->color.b == color.b) {
+            set->lastUsed = ++useClock;
+            return set;
+        }
+        if (!slot || (slot->font && (!set->font || set->lastUsed < slot->lastUsed))) slot = set;
+    }
+    if (slot->font) freeGlyphSet(slot);
+    if (!buildGlyphSet(slot, font, color)) return NULL;
+    slot->lastUsed = ++useClock;
+    return slot;
+}
+
+// TTF_SizeText()'s arithmetic: the string runs from the leftmost glyph edge to the furthest of
+// each glyph's advance and right edge
+static void measureText(const GlyphSet *set, const char *text, int *left, int *right) {
+    int x = 0, minx = 0, maxx = 0;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        if (*p < GLYPH_FIRST) continue;
+        int i = *p - GLYPH_FIRST;
+        int z = x + set->minx[i];
+        if (z < minx) minx = z;
+        z = x + (set->advance[i] > set->maxx[i] ? set->advance[i] : set->maxx[i]);
+        if (z > maxx) maxx = z;
+        x += set->advance[i];
+    }
+    *left = minx;
+    *right = maxx;
+}
+
+int blitText(SDL_Surface *dst, TTF_Font *font, const char *text, SDL_Color color, int x, int y) {
+    if (!dst || !font || !text) return -1;
+    GlyphSet *set = findGlyphSet(font, color);
+    if (!set) return -1;
+
+    int left, right, result = 0;
+    measureText(set, text, &left, &right);
+    int pen = x - left;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        if (*p < GLYPH_FIRST) continue;
+        int i = *p - GLYPH_FIRST;
+        // A glyph reaching left of its pen position was rendered that much further right in its cell
+        SDL_Rect src = {(i % GLYPH_COLUMNS) * set->cellW, (i / GLYPH_COLUMNS) * set->cellH, set->cellW, set->cellH};
+        SDL_Rect to = {pen + (set->minx[i] < 0 ? set->minx[i] : 0), y, 0, 0};
+        if (blitSprite(set->sheet, &src, dst, &to, 0) < 0) result = -1;
+        pen += set->advance[i];
+    }
+    return result;
+}
+
+int textWidth(TTF_Font *font, const char *text) {
+    if (!font || !text) return 0;
+    // Metrics do not depend on the colour, so any set of the font will do
+    GlyphSet *set = NULL;
+    for (int i = 0; i < MAX_GLYPH_SETS && !set; i++) {
+        if (glyphSets[i].font == font) set = &glyphSets[i];
+    }
+    if (!set) set = findGlyphSet(font, (SDL_Color){255, 255, 255, 0});
+    if (!set) return 0;
+    int left, right;
+    measureText(set, text, &left, &right);
+    return right - left;
+}
+
+void releaseGlyphFont(TTF_Font *font) {
+    for (int i = 0; i < MAX_GLYPH_SETS; i++) {
+        if (glyphSets[i].font == font) freeGlyphSet(&glyphSets[i]);
+    }
+}
@@ -2,8 +2,11 @@
 #include <SDL/SDL_image.h>
 #include <SDL/SDL_ttf.h>
 #include "game.h"
+#include "textcache.h"
 #include <stdio.h>
 
+static TTF_Font *countFont = NULL;     // Opened on the first count drawn
+
 void initInventory(Inventory *inventory) {
     printf("Starting initInventory...\n");
 
@@ -13,6 +16,7 @@ void initInventory(Inventory *inventory) {
         exit(1);
     }
     SDL_SetColorKey(inventory->uiImage, SDL_SRCCOLORKEY, SDL_MapRGB(inventory->uiImage->format, 255, 0, 255));
+    packSpriteSheet(inventory->uiImage, inventory->uiImage->w, inventory->uiImage->h);
     printf("Loaded inventory UI image: assets/inventory/inventory.png (%dx%d)\n", inventory->uiImage->w, inventory->uiImage->h);
 
     inventory->frameImage = IMG_Load("assets/inventory/frame.png");
@@ -21,6 +25,7 @@ void initInventory(Inventory *inventory) {
         exit(1);
     }
     SDL_SetColorKey(inventory->frameImage, SDL_SRCCOLORKEY, SDL_MapRGB(inventory->frameImage->format, 255, 0, 255));
+    packSpriteSheet(inventory->frameImage, inventory->frameImage->w, inventory->frameImage->h);
     printf("Loaded frame image: assets/inventory/frame.png (%dx%d)\n", inventory->frameImage->w, inventory->frameImage->h);
 
     inventory->items[0].icon = IMG_Load("assets/inventory/item0.png");
@@ -28,6 +33,7 @@ void initInventory(Inventory *inventory) {
         fprintf(stderr, "Failed to load assets/inventory/item0.png: %s\n", SDL_GetError());
         exit(1);
     }
+    packSpriteSheet(inventory->items[0].icon, inventory->items[0].icon->w, inventory->items[0].icon->h);
     inventory->items[0].have = 1;
     printf("Loaded paper icon (item0.png) in slot 0: 40x40\n");
 
@@ -36,6 +42,7 @@ void initInventory(Inventory *inventory) {
         fprintf(stderr, "Failed to load assets/inventory/item1.png: %s\n", SDL_GetError());
         exit(1);
     }
+    packSpriteSheet(inventory->items[1].icon, inventory->items[1].icon->w, inventory->items[1].icon->h);
     inventory->items[1].have = 1;
     printf("Loaded item1.png in slot 1\n");
 
@@ -80,20 +87,20 @@ void renderInventory(Inventory *inventory, SDL_Surface *screen, int showInventor
 
     if (inventory->uiImage) {
         SDL_Rect invPos = {playerPos.x + 30, playerPos.y - 90, 0, 0};
-        SDL_BlitSurface(inventory->uiImage, NULL, screen, &invPos);
+        blitSprite(inventory->uiImage, NULL, screen, &invPos, 0);
         printf("Rendering inventory UI at (%d, %d)\n", invPos.x, invPos.y);
 
         for (int i = 0; i < MAX_ITEMS; i++) {
             if (inventory->items[i].have && inventory->items[i].icon) {
                 SDL_Rect itemPos = {invPos.x + 10 + i * 50, invPos.y + 10, 0, 0};
-                SDL_BlitSurface(inventory->items[i].icon, NULL, screen, &itemPos);
+                blitSprite(inventory->items[i].icon, NULL, screen, &itemPos, 0);
                 printf("Rendering item %d icon at (%d, %d)\n", i, itemPos.x, itemPos.y);
             }
         }
 
         if (inventory->frameImage) {
             SDL_Rect framePos = {invPos.x + 10 + inventory->selectedSlot * 50, invPos.y + 10, 0, 0};
-            SDL_BlitSurface(inventory->frameImage, NULL, screen, &framePos);
+            blitSprite(inventory->frameImage, NULL, screen, &framePos, 0);
             printf("Rendering frame.png on slot %d at (%d, %d)\n", inventory->selectedSlot, framePos.x, framePos.y);
         } else {
             fprintf(stderr, "Warning: frameImage is NULL\n");
@@ -105,38 +112,46 @@ void renderInventory(Inventory *inventory, SDL_Surface *screen, int showInventor
 
     char countText[20];
     sprintf(countText, "%d/%d", inventory->count, MAX_ITEMS);
-    TTF_Font *font = TTF_OpenFont("assets/fonts/arial.ttf", 16);
-    if (!font) {
-        fprintf(stderr, "Failed to load font for inventory count: %s\n", TTF_GetError());
-        return;
+    if (!countFont) {
+        countFont = TTF_OpenFont("assets/fonts/arial.ttf", 16);
+        if (!countFont) {
+            fprintf(stderr, "Failed to load font for inventory count: %s\n", TTF_GetError());
+            return;
+        }
     }
     SDL_Color textColor = {255, 255, 255, 255};
-    SDL_Surface *textSurface = TTF_RenderText_Solid(font, countText, textColor);
+    SDL_Surface *textSurface = cachedText(countFont, countText, textColor, TEXT_SOLID);
     if (textSurface) {
         SDL_Rect textRect = {playerPos.x + 30, playerPos.y - 110, 0, 0};
-        SDL_BlitSurface(textSurface, NULL, screen, &textRect);
-        SDL_FreeSurface(textSurface);
+        trackedBlit(textSurface, NULL, screen, &textRect);
     } else {
         fprintf(stderr, "Failed to render inventory count text: %s\n", TTF_GetError());
     }
-    TTF_CloseFont(font);
 }
 
 void freeInventory(Inventory *inventory) {
     if (inventory->uiImage) {
+        unpackSpriteSheet(inventory->uiImage);
         SDL_FreeSurface(inventory->uiImage);
         inventory->uiImage = NULL;
     }
     if (inventory->frameImage) {
+        unpackSpriteSheet(inventory->frameImage);
         SDL_FreeSurface(inventory->frameImage);
         inventory->frameImage = NULL;
     }
     for (int i = 0; i < MAX_ITEMS; i++) {
         if (inventory->items[i].icon) {
+            unpackSpriteSheet(inventory->items[i].icon);
             SDL_FreeSurface(inventory->items[i].icon);
             inventory->items[i].icon = NULL;
         }
     }
+    if (countFont) {
+        releaseTextFont(countFont);
+        TTF_CloseFont(countFont);
+        countFont = NULL;
+    }
     inventory->count = 0;
     inventory->selectedSlot = 0;
     printf("Inventory freed.\n");
@@ -1,4 +1,5 @@
 #include "jet.h"
+#include "utils.h"
 #include <SDL/SDL_image.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -20,8 +21,8 @@ void initJet(Jet* jet) {
         exit(1);
     }
     Uint32 colorkey = SDL_MapRGB(jet->spriteSheet->format, 255, 255, 255);
-    SDL_SetColorKey(jet->spriteSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-    SDL_Surface* optimized = SDL_DisplayFormatAlpha(jet->spriteSheet);
+    SDL_SetColorKey(jet->spriteSheet, SDL_SRCCOLORKEY, colorkey);
+    SDL_Surface* optimized = keyedDisplayFormatAlpha(jet->spriteSheet);
     if (!optimized) {
         fprintf(stderr, "SDL_DisplayFormatAlpha failed for jet.png: %s\n", SDL_GetError());
         SDL_FreeSurface(jet->spriteSheet);
@@ -29,6 +30,7 @@ void initJet(Jet* jet) {
     }
     SDL_FreeSurface(jet->spriteSheet);
     jet->spriteSheet = optimized;
+    packSpriteSheet(jet->spriteSheet, 256, 256);
 
     jet->bomb.spriteSheet = IMG_Load("assets/enemies/jet/bomb.png");
     if (!jet->bomb.spriteSheet) {
@@ -36,9 +38,9 @@ void initJet(Jet* jet) {
         SDL_FreeSurface(jet->spriteSheet);
         exit(1);
     }
-    SDL_SetColorKey(jet->bomb.spriteSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL,
+    SDL_SetColorKey(jet->bomb.spriteSheet, SDL_SRCCOLORKEY,
                     SDL_MapRGB(jet->bomb.spriteSheet->format, 255, 255, 255));
-    optimized = SDL_DisplayFormatAlpha(jet->bomb.spriteSheet);
+    optimized = keyedDisplayFormatAlpha(jet->bomb.spriteSheet);
     if (!optimized) {
         fprintf(stderr, "SDL_DisplayFormatAlpha failed for bomb.png: %s\n", SDL_GetError());
         SDL_FreeSurface(jet->spriteSheet);
@@ -47,6 +49,7 @@ void initJet(Jet* jet) {
     }
     SDL_FreeSurface(jet->bomb.spriteSheet);
     jet->bomb.spriteSheet = optimized;
+    packSpriteSheet(jet->bomb.spriteSheet, 16, 16);
 
     char filename[50];
     for (int i = 0; i < 27; i++) {
@@ -61,9 +64,9 @@ void initJet(Jet* jet) {
             SDL_FreeSurface(jet->bomb.spriteSheet);
             exit(1);
         }
-        SDL_SetColorKey(jet->bomb.fire.frames[i], SDL_SRCCOLORKEY | SDL_RLEACCEL,
+        SDL_SetColorKey(jet->bomb.fire.frames[i], SDL_SRCCOLORKEY,
                         SDL_MapRGB(jet->bomb.fire.frames[i]->format, 255, 255, 255));
-        optimized = SDL_DisplayFormatAlpha(jet->bomb.fire.frames[i]);
+        optimized = keyedDisplayFormatAlpha(jet->bomb.fire.frames[i]);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for %s: %s\n", filename, SDL_GetError());
             for (int j = 0; j < i; j++) {
@@ -76,6 +79,7 @@ void initJet(Jet* jet) {
         }
         SDL_FreeSurface(jet->bomb.fire.frames[i]);
         jet->bomb.fire.frames[i] = optimized;
+        packSpriteSheet(optimized, optimized->w, optimized->h);
     }
 
     jet->position.x = -256;
@@ -198,18 +202,18 @@ void renderJet(SDL_Surface* screen, Jet* jet, int scroll_x) {
     if (jet->active && jet->state == JET_FLYING) {
         SDL_Rect srcRect = {jet->frame * 256, 0, 256, 256};
         SDL_Rect destRect = {jet->position.x - scroll_x, jet->position.y, 256, 256};
-        SDL_BlitSurface(jet->spriteSheet, &srcRect, screen, &destRect);
+        blitSprite(jet->spriteSheet, &srcRect, screen, &destRect, 0);
     }
 
     if (jet->bomb.active) {
         SDL_Rect bombSrcRect = {jet->bomb.frame * 16, 0, 16, 16};
         SDL_Rect bombDestRect = {jet->bomb.position.x - scroll_x, jet->bomb.position.y, 16, 16};
-        SDL_BlitSurface(jet->bomb.spriteSheet, &bombSrcRect, screen, &bombDestRect);
+        blitSprite(jet->bomb.spriteSheet, &bombSrcRect, screen, &bombDestRect, 0);
     }
 
     if (jet->bomb.fire.active) {
         SDL_Rect fireDestRect = {jet->bomb.fire.position.x - scroll_x, jet->bomb.fire.position.y, 547, 483};
-        SDL_BlitSurface(jet->bomb.fire.frames[jet->bomb.fire.currentFrame], NULL, screen, &fireDestRect);
+        blitSprite(jet->bomb.fire.frames[jet->bomb.fire.currentFrame], NULL, screen, &fireDestRect, 0);
     }
 
     LOG("Jet rendered: x=%d, y=%d, state=%d, frame=%d, active=%d, bomb.active=%d\n",
@@ -223,15 +227,18 @@ void freeJet(Jet* jet) {
     }
 
     if (jet->spriteSheet) {
+        unpackSpriteSheet(jet->spriteSheet);
         SDL_FreeSurface(jet->spriteSheet);
         jet->spriteSheet = NULL;
     }
     if (jet->bomb.spriteSheet) {
+        unpackSpriteSheet(jet->bomb.spriteSheet);
         SDL_FreeSurface(jet->bomb.spriteSheet);
         jet->bomb.spriteSheet = NULL;
     }
     for (int i = 0; i < 27; i++) {
         if (jet->bomb.fire.frames[i]) {
+            unpackSpriteSheet(jet->bomb.fire.frames[i]);
             SDL_FreeSurface(jet->bomb.fire.frames[i]);
             jet->bomb.fire.frames[i] = NULL;
         }
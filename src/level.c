@@ -8,6 +8,7 @@
 #include "inventory.h"
 #include "jet.h"
 #include "ui.h"
+#include "glyphatlas.h"
 #include "soldier.h"
 #include "soldier2.h"
 #include "robot.h"
@@ -24,6 +25,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <stdlib.h>
+#include <sys/stat.h>
 
 static int level1_width = 6244;
 static int level1_height = 720;
@@ -32,19 +34,25 @@ static int level2_height = 672;
 static int level3_width = 5000;
 static int level3_height = 720;
 
+// Level 2 doors prompt when the feet come within this many px of door pixels
+#define LEVEL2_DOOR_RADIUS 30
+// Level 2 teleport destinations (world x, ground y), taken in order
+static const int level2_green_zones[3][2] = {{1900, 400}, {4080, 400}, {7800, 400}};
+
+// Platform reach of a running jump: apex height, and run distance back down to take-off height
+#define NAV_JUMP_HEIGHT (int)(JUMP_POWER * JUMP_POWER / (2 * GRAVITY))
+#define NAV_JUMP_REACH (int)(2 * JUMP_POWER / GRAVITY * RUN_SPEED)
+
 void freeResources(GAME *game) {
     if (!game) {
         fprintf(stderr, "freeResources: Game pointer is NULL\n");
         return;
     }
-    if (game->background.image) {
-        SDL_FreeSurface(game->background.image);
-        game->background.image = NULL;
-    }
-    if (game->background.levelCollision) {
-        SDL_FreeSurface(game->background.levelCollision);
-        game->background.levelCollision = NULL;
-    }
+    freeTiledBackground(&game->background.tiles);
+    freeCollisionMap(&game->background.collision);
+    freeNavGraph(&game->background.nav);
+    freeTriggers(&game->triggers);
+    freeDebugOverlay(&game->debug);
     for (int i = 0; i < MAX_SOLDIERS; i++) {
         if (game->soldiers[i].active) {
             freeSoldier(&game->soldiers[i]);
@@ -83,10 +91,6 @@ void freeResources(GAME *game) {
         freePortal(&game->portal);
         game->portal.active = 0;
     }
-    if (game->global.messageSurface) {
-        SDL_FreeSurface(game->global.messageSurface);
-        game->global.messageSurface = NULL;
-    }
     for (int i = 0; i < game->numMummies; i++) {
         if (game->mummies[i].active) {
             freeMummy(&game->mummies[i]);
@@ -124,63 +128,229 @@ void freeResources(GAME *game) {
     printf("Resources freed\n");
 }
 
+// A cooked asset is only trusted if it is at least as new as the source it was built from
+static int cookedIsCurrent(const char *cooked_path, const char *source_path, const char *make_target) {
+    struct stat cookedStat, sourceStat;
+    if (stat(cooked_path, &cookedStat) != 0) return 0;
+    if (stat(source_path, &sourceStat) == 0 && sourceStat.st_mtime > cookedStat.st_mtime) {
+        printf("%s is older than %s, run \"make %s\"\n", cooked_path, source_path, make_target);
+        return 0;
+    }
+    return 1;
+}
+
+// Hides the prompt if it still belongs to the volume that set it (messagePosition.w / h tag the owner)
+static void clearPrompt(GAME *game, int ownerX, int ownerId) {
+    if (game->global.showMessage &&
+        game->global.messagePosition.w == ownerX &&
+        game->global.messagePosition.h == ownerId) {
+        game->global.showMessage = 0;
+        game->global.messagePosition.w = -1;
+        game->global.messagePosition.h = -1;
+    }
+}
+
+// Centres the prompt above a talk volume, measuring the text when a font is loaded
+static void showTalkPrompt(GAME *game, SDL_Rect rect, int promptY, int ownerId) {
+    int scroll_x = game->background.scroll_x;
+    game->global.showMessage = 1;
+    game->global.messagePosition.x = (rect.x - scroll_x) + (rect.w / 2) - 50;
+    if (game->global.font) {
+        int textW = textWidth(game->global.font, game->global.message);
+        game->global.messagePosition.x = (rect.x - scroll_x) + (rect.w / 2) - (textW / 2);
+    }
+    game->global.messagePosition.y = promptY;
+    game->global.messagePosition.w = rect.x;
+    game->global.messagePosition.h = ownerId;
+}
+
+// Level 1 door to level 2, and the level 2 doors that teleport between green zones (handled on E below)
+static void doorTrigger(GAME *game, int id, SDL_Rect rect, TriggerEvent event) {
+    (void)id;
+    if (event == TRIGGER_EXIT) {
+        game->player.nearDoor = -1;
+        clearPrompt(game, rect.x, -1);
+        return;
+    }
+    int scroll_x = game->background.scroll_x;
+    game->player.nearDoor = 1;
+    game->global.showMessage = 1;
+    if (game->level == 1) {
+        strcpy(game->global.message, "Press E to enter Level 2");
+        game->global.messagePosition.x = game->player.world_x + game->player.position.w / 2 - scroll_x - 50;
+    } else {
+        sprintf(game->global.message, "Press E to teleport to Zone %d", game->global.currentGreenZone + 1);
+        game->global.messagePosition.x = rect.x + LEVEL2_DOOR_RADIUS - scroll_x - 50;
+    }
+    game->global.messagePosition.y = game->player.position.y - 50;
+    game->global.messagePosition.w = rect.x;
+    game->global.messagePosition.h = -1;
+}
+
+static void npcTrigger(GAME *game, int i, SDL_Rect rect, TriggerEvent event) {
+    NPC *npc = &game->npcs[i];
+    if (event == TRIGGER_EXIT) {
+        clearPrompt(game, rect.x, i);
+        return;
+    }
+    if (!npc->active) return;
+
+    strcpy(game->global.message, i == 0 ? "Press E to buy ammo" : "Press E to restore health");
+    showTalkPrompt(game, rect, npc->position.y - 40, i);
+    if (game->input.enter && !npc->dealing) {
+        npc->state = NPC_DIALOGUE;
+        npc->frame = 0;
+        npc->dealing = 1;
+        game->input.enter = 0;
+        if (i == 0) {
+            game->player.ammo += 5;
+            printf("NPC %d: Traded 5 ammo, player ammo=%d\n", i, game->player.ammo);
+        } else {
+            game->player.health = game->player.maxHealth;
+            game->global.showHealthIcon = 1;
+            game->global.healthIconTimer = SDL_GetTicks();
+            printf("NPC %d: Restored health, player health=%d, showing icon28\n", i, game->player.health);
+        }
+        npc->state = NPC_APPROVAL;
+        npc->frame = 0;
+    }
+}
+
+static void npc2Trigger(GAME *game, int i, SDL_Rect rect, TriggerEvent event) {
+    NPC2 *npc = &game->npc2s[i];
+    if (event == TRIGGER_EXIT) {
+        clearPrompt(game, rect.x, i + MAX_NPCS);
+        return;
+    }
+    if (!npc->active || npc->dialogueActive) return;
+
+    strcpy(game->global.message, "Press E to talk");
+    showTalkPrompt(game, rect, npc->position.y - 40, i + MAX_NPCS);
+}
+
+static void deactivatePortal(GAME *game) {
+    removeTrigger(&game->triggers, game->portal.trigger);
+    game->portal.trigger = -1;
+    game->portal.active = 0;
+    freePortal(&game->portal);
+}
+
+static void portalTrigger(GAME *game, int id, SDL_Rect rect, TriggerEvent event) {
+    (void)id;
+    if (event == TRIGGER_EXIT) {
+        clearPrompt(game, rect.x, -1);
+        return;
+    }
+    int scroll_x = game->background.scroll_x;
+    game->global.showMessage = 1;
+    strcpy(game->global.message, "Press E to solve the enigma");
+    game->global.messagePosition.x = rect.x - scroll_x - 50;
+    game->global.messagePosition.y = rect.y - 50;
+    game->global.messagePosition.w = rect.x;
+    game->global.messagePosition.h = -1;
+    if (game->input.enter) {
+        game->global.quizActive = 1;
+        initEnigme(game);
+        game->input.enter = 0;
+        deactivatePortal(game);
+        printf("Enigma activated\n");
+    }
+}
+
+static void activatePortal(GAME *game, int x, int y) {
+    initPortal(&game->portal, x, y);
+    game->portal.active = 1;
+    game->portal.trigger = addTrigger(&game->triggers, game->portal.position, 0, 0, portalTrigger);
+}
+
+// Volumes fixed for the whole level; the portal and level-up icon add theirs when they appear
+static void buildLevelTriggers(GAME *game) {
+    resetTriggers(&game->triggers);
+    if (game->level == 1) {
+        addZoneTriggers(&game->triggers, &game->background.collision, MAT_DOOR, 0, doorTrigger);
+    } else if (game->level == 2) {
+        addZoneTriggers(&game->triggers, &game->background.collision, MAT_DOOR, LEVEL2_DOOR_RADIUS, doorTrigger);
+    }
+    for (int i = 0; i < game->numNPCs; i++) {
+        NPC *npc = &game->npcs[i];
+        SDL_Rect rect = {npc->world_x, npc->position.y, npc->position.w, npc->position.h};
+        if (npc->active) addTrigger(&game->triggers, rect, 0, i, npcTrigger);
+    }
+    for (int i = 0; i < game->numNPC2s; i++) {
+        NPC2 *npc = &game->npc2s[i];
+        SDL_Rect rect = {npc->world_x, npc->position.y, npc->position.w, npc->position.h};
+        npc->trigger = npc->active ? addTrigger(&game->triggers, rect, 0, i, npc2Trigger) : -1;
+    }
+    game->portal.trigger = -1;
+    game->boss.levelUpTrigger = -1;
+    printf("Level %d triggers: %d volumes\n", game->level, game->triggers.count);
+}
+
 void load_level(GAME *game, int level) {
     if (!game) {
         fprintf(stderr, "load_level: Game pointer is NULL\n");
         exit(1);
     }
 
-    char bg_path[50], mask_path[50];
+    char bg_path[50], tiles_path[50], mask_path[50], colmap_path[50];
     sprintf(bg_path, "assets/levels/level%d.png", level);
+    sprintf(tiles_path, "assets/levels/level%d.tiles", level);
     sprintf(mask_path, "assets/levels/level%d_mask.png", level);
+    sprintf(colmap_path, "assets/levels/level%d_mask.colmap", level);
 
     freeResources(game);
 
-    game->background.image = IMG_Load(bg_path);
-    if (!game->background.image) {
-        fprintf(stderr, "Failed to load %s: %s\n", bg_path, IMG_GetError());
-        exit(1);
-    }
-    SDL_Surface *optimized = SDL_DisplayFormat(game->background.image);
-    if (!optimized) {
-        fprintf(stderr, "SDL_DisplayFormat failed for %s: %s\n", bg_path, SDL_GetError());
-        SDL_FreeSurface(game->background.image);
-        game->background.image = NULL;
-        exit(1);
-    }
-    SDL_FreeSurface(game->background.image);
-    game->background.image = optimized;
-
-    game->background.levelCollision = IMG_Load(mask_path);
-    if (!game->background.levelCollision) {
-        fprintf(stderr, "Failed to load %s: %s\n", mask_path, IMG_GetError());
-        SDL_FreeSurface(game->background.image);
-        game->background.image = NULL;
-        exit(1);
+    // Prefer the cooked columns from "make tiles", decoded as the camera reaches them; otherwise decode
+    // the whole PNG here and keep every column
+    if (cookedIsCurrent(tiles_path, bg_path, "tiles") && loadTiledBackground(&game->background.tiles, tiles_path)) {
+        printf("Using cooked background %s\n", tiles_path);
+    } else {
+        SDL_Surface *image = IMG_Load(bg_path);
+        if (!image) {
+            fprintf(stderr, "Failed to load %s: %s\n", bg_path, IMG_GetError());
+            exit(1);
+        }
+        if (!splitTiledBackground(&game->background.tiles, image, BG_TILE_WIDTH)) {
+            fprintf(stderr, "Failed to split %s into columns\n", bg_path);
+            SDL_FreeSurface(image);
+            exit(1);
+        }
+        SDL_FreeSurface(image);
     }
-    optimized = SDL_DisplayFormat(game->background.levelCollision);
-    if (!optimized) {
-        fprintf(stderr, "SDL_DisplayFormat failed for %s: %s\n", mask_path, SDL_GetError());
-        SDL_FreeSurface(game->background.image);
-        SDL_FreeSurface(game->background.levelCollision);
-        game->background.image = NULL;
-        game->background.levelCollision = NULL;
-        exit(1);
+
+    // Prefer the compiled map from "make masks"; otherwise pack the mask PNG here and drop the surface
+    if (cookedIsCurrent(colmap_path, mask_path, "masks") && loadCollisionMap(&game->background.collision, colmap_path)) {
+        printf("Using compiled collision map %s\n", colmap_path);
+    } else {
+        SDL_Surface *mask = IMG_Load(mask_path);
+        if (!mask) {
+            fprintf(stderr, "Failed to load %s: %s\n", mask_path, IMG_GetError());
+            freeTiledBackground(&game->background.tiles);
+            exit(1);
+        }
+        if (!initCollisionMap(&game->background.collision, mask, (SCREEN_HEIGHT - mask->h) / 2)) {
+            fprintf(stderr, "Failed to build collision map from %s\n", mask_path);
+            SDL_FreeSurface(mask);
+            freeTiledBackground(&game->background.tiles);
+            exit(1);
+        }
+        SDL_FreeSurface(mask);
     }
-    SDL_FreeSurface(game->background.levelCollision);
-    game->background.levelCollision = optimized;
 
     // Verify collision map dimensions for level 2
-    if (level == 2 && (game->background.levelCollision->w != level2_width || game->background.levelCollision->h != level2_height)) {
+    if (level == 2 && (game->background.collision.w != level2_width || game->background.collision.h != level2_height)) {
         fprintf(stderr, "Level 2 collision map size mismatch: expected %dx%d, got %dx%d\n",
-                level2_width, level2_height, game->background.levelCollision->w, game->background.levelCollision->h);
-        SDL_FreeSurface(game->background.image);
-        SDL_FreeSurface(game->background.levelCollision);
-        game->background.image = NULL;
-        game->background.levelCollision = NULL;
+                level2_width, level2_height, game->background.collision.w, game->background.collision.h);
+        freeTiledBackground(&game->background.tiles);
+        freeCollisionMap(&game->background.collision);
         exit(1);
     }
 
+    // Enemy chase routes; without a graph chaseDirection() just walks straight at the player
+    if (!buildNavGraph(&game->background.nav, &game->background.collision, NAV_JUMP_HEIGHT, NAV_JUMP_REACH)) {
+        fprintf(stderr, "Failed to build navigation graph, enemies chase without routes\n");
+    }
+
     // Load background music
     game->global.backgroundMusic = Mix_LoadMUS("assets/sounds/background_music.mp3");
     if (!game->global.backgroundMusic) {
@@ -189,6 +359,7 @@ void load_level(GAME *game, int level) {
         printf("Background music loaded\n");
     }
 
+    SDL_Surface *optimized;
     // Load health icon28
     game->global.healthIcon28 = IMG_Load("assets/ui/icon28.png");
     if (!game->global.healthIcon28) {
@@ -379,7 +550,7 @@ void load_level(GAME *game, int level) {
             if (x >= 0 && x <= game->background.width - 48) {
                 printf("Attempting to initialize NPC2 %d at x=%d, y=%d\n", i, x, y);
                 initNPC2(&game->npc2s[i], x, y, game);
-                placeNPCOnGround(game, (NPC*)&game->npc2s[i]);
+                placeNPC2OnGround(game, &game->npc2s[i]);
                 game->npc2s[i].world_x = x;
                 game->npc2s[i].position.x = x;
                 game->npc2s[i].active = 1;
@@ -537,11 +708,110 @@ void load_level(GAME *game, int level) {
     game->global.showHealthIcon = 0;
     game->global.healthIconTimer = 0;
     placePlayerOnGround(game);
+    buildLevelTriggers(game);
+    invalidateScreen();
     printf("Level %d loaded, player at x=%d, y=%d\n", level, game->player.world_x, game->player.position.y);
 }
 
+#define MAX_GROUND_PROBES (1 + MAX_SOLDIERS + MAX_SOLDIERS2 + MAX_ROBOTS + 1 + \
+                           MAX_MUMMIES + MAX_DECEASEDS + MAX_GORGONS + MAX_SPEARMEN)
+
+static void addGroundProbe(GroundProbe *probes, int *count, int world_x, int bottom_y, int width, int *onGround) {
+    probes[*count].world_x = world_x;
+    probes[*count].bottom_y = bottom_y;
+    probes[*count].width = width;
+    probes[*count].onGround = onGround;
+    (*count)++;
+}
+
+// Refreshes the ground flag of the player and every live enemy in one batched pass
+static void updateGroundFlags(GAME *game) {
+    GroundProbe probes[MAX_GROUND_PROBES];
+    int count = 0;
+
+    if (game->level == 3) {
+        Player2 *p = &game->player2;
+        addGroundProbe(probes, &count, p->world_x, p->position.y + p->position.h, p->position.w, &p->onGround);
+    } else {
+        Player *p = &game->player;
+        addGroundProbe(probes, &count, p->world_x, p->position.y + p->position.h, p->position.w, &p->onGround);
+    }
+    for (int i = 0; i < game->numSoldiers; i++) {
+        Soldier *s = &game->soldiers[i];
+        if (s->active) addGroundProbe(probes, &count, s->world_x, s->position.y + s->position.h, s->position.w, &s->onGround);
+    }
+    for (int i = 0; i < game->numSoldiers2; i++) {
+        Soldier2 *s = &game->soldiers2[i];
+        if (s->active) addGroundProbe(probes, &count, s->world_x, s->position.y + s->position.h, s->position.w, &s->onGround);
+    }
+    for (int i = 0; i < game->numRobots; i++) {
+        Robot *r = &game->robots[i];
+        if (r->active) addGroundProbe(probes, &count, r->world_x, r->position.y + r->position.h, r->position.w, &r->onGround);
+    }
+    if (game->bossActive) {
+        Boss *b = &game->boss;
+        addGroundProbe(probes, &count, b->world_x, b->y + b->position.h, b->position.w, &b->onGround);
+    }
+    for (int i = 0; i < game->numMummies; i++) {
+        Mummy *m = &game->mummies[i];
+        if (m->active) addGroundProbe(probes, &count, m->world_x, m->position.y + m->position.h, m->position.w, &m->onGround);
+    }
+    for (int i = 0; i < game->numDeceaseds; i++) {
+        Deceased *d = &game->deceaseds[i];
+        if (d->active) addGroundProbe(probes, &count, d->world_x, d->position.y + d->position.h, d->position.w, &d->onGround);
+    }
+    for (int i = 0; i < game->numGorgons; i++) {
+        Gorgon *g = &game->gorgons[i];
+        if (g->active) addGroundProbe(probes, &count, g->world_x, g->position.y + g->position.h, g->position.w, &g->onGround);
+    }
+    for (int i = 0; i < game->numSpearmen; i++) {
+        SkeletonSpearman *s = &game->spearmen[i];
+        if (s->active) addGroundProbe(probes, &count, s->world_x, s->position.y + s->position.h, s->position.w, &s->onGround);
+    }
+
+    onGroundBatch(game, probes, count);
+}
+
+// Sorts this frame's colliders by world x so player and bullet tests only run on overlapping intervals
+static void updateBroadphase(GAME *game) {
+    Broadphase *bp = &game->broadphase;
+    resetBroadphase(bp);
+
+    // The player's interval also covers its melee hitbox, which starts PLAYER_MELEE_REACH behind world_x
+    addCollider(bp, COLLIDER_PLAYER, 0, game->player.world_x - PLAYER_MELEE_REACH,
+                game->player.position.w + PLAYER_MELEE_REACH);
+    if (game->player.bulletActive) {
+        addCollider(bp, COLLIDER_BULLET, 0, game->player.bullet.x, game->player.bullet_w);
+    }
+    for (int i = 0; i < game->numSoldiers; i++) {
+        if (game->soldiers[i].active) addCollider(bp, COLLIDER_SOLDIER, i, game->soldiers[i].world_x, game->soldiers[i].position.w);
+    }
+    for (int i = 0; i < game->numSoldiers2; i++) {
+        if (game->soldiers2[i].active) addCollider(bp, COLLIDER_SOLDIER2, i, game->soldiers2[i].world_x, game->soldiers2[i].position.w);
+    }
+    for (int i = 0; i < game->numRobots; i++) {
+        if (game->robots[i].active) addCollider(bp, COLLIDER_ROBOT, i, game->robots[i].world_x, game->robots[i].position.w);
+    }
+    if (game->bossActive) {
+        addCollider(bp, COLLIDER_BOSS, 0, game->boss.position.x, game->boss.position.w);
+    }
+
+    sweepBroadphase(bp);
+}
+
+// Repaints one screen rect with the background slice under it, black where the level image ends
+static void restoreBackground(GAME *game, SDL_Rect rect, int scroll_x) {
+    SDL_Rect fill = rect;
+    SDL_FillRect(game->screen, &fill, SDL_MapRGB(game->screen->format, 0, 0, 0));
+    SDL_Rect src = {scroll_x + rect.x, rect.y, rect.w, rect.h};
+    if (src.x + src.w > game->background.width) src.w = game->background.width - src.x;
+    if (src.y + src.h > game->background.height) src.h = game->background.height - src.y;
+    if (src.w <= 0 || src.h <= 0) return;
+    blitTiledBackground(&game->background.tiles, src, game->screen, rect.x, rect.y);
+}
+
 void playLevel(GAME *game) {
-    if (!game || !game->screen || !game->background.image || !game->background.levelCollision) {
+    if (!game || !game->screen || !game->background.tiles.tiles || !game->background.collision.bits) {
         fprintf(stderr, "playLevel: Game, screen, or background is NULL\n");
         exit(1);
     }
@@ -595,6 +865,7 @@ void playLevel(GAME *game) {
             }
 
             SDL_Flip(game->screen);
+            invalidateScreen();
             Uint32 frameTime = SDL_GetTicks() - currentTime;
             const Uint32 targetFrameTime = 16;
             if (frameTime < targetFrameTime) {
@@ -618,10 +889,7 @@ void playLevel(GAME *game) {
                 game->global.quizActive = 1;
                 initEnigme(game);
                 game->input.skip = 0;
-                if (game->portal.active) {
-                    game->portal.active = 0;
-                    freePortal(&game->portal);
-                }
+                if (game->portal.active) deactivatePortal(game);
                 game->global.showMessage = 0;
                 printf("Skip button pressed, enigma activated\n");
             }
@@ -630,13 +898,13 @@ void playLevel(GAME *game) {
                 game->player.freezeYMovement = 0;
             }
 
+            updateGroundFlags(game);
+
             // Update Player2 for level 3, Player otherwise
             if (game->level == 3) {
-                game->player2.onGround = onGroundPlayer2(game, &game->player2);
                 movementPlayer2(game);
                 updatePlayer2(&game->player2, game);
             } else {
-                game->player.onGround = onGround(game, &game->player);
                 movement(game);
                 updatePlayer(&game->player, game);
             }
@@ -648,6 +916,9 @@ void playLevel(GAME *game) {
                 updateJet(&game->jet, &game->player, scroll_x);
             }
 
+            // Player and bullet are final for this frame; enemies below move less than BROADPHASE_MARGIN
+            updateBroadphase(game);
+
             for (int i = 0; i < game->numSoldiers; i++) {
                 if (game->soldiers[i].active) {
                     int soldierWorldX = game->soldiers[i].world_x;
@@ -706,57 +977,6 @@ void playLevel(GAME *game) {
                     int distance = abs(dx);
                     if (distance <= updateDistance) {
                         updateNPC(&game->npcs[i], deltaTime);
-                        SDL_Rect playerRect = {game->player.world_x, game->player.position.y, game->player.position.w, game->player.position.h};
-                        SDL_Rect npcRect = {game->npcs[i].world_x, game->npcs[i].position.y, game->npcs[i].position.w, game->npcs[i].position.h};
-                        if (rectIntersect(&playerRect, &npcRect)) {
-                            game->global.showMessage = 1;
-                            if (i == 0) {
-                                strcpy(game->global.message, "Press E to buy ammo");
-                            } else {
-                                strcpy(game->global.message, "Press E to restore health");
-                            }
-                            if (game->global.font) {
-                                SDL_Surface *tempSurface = TTF_RenderText_Solid(game->global.font, game->global.message, (SDL_Color){255, 255, 255});
-                                if (tempSurface) {
-                                    game->global.messagePosition.x = (npcWorldX - scroll_x) + (npcRect.w / 2) - (tempSurface->w / 2);
-                                    game->global.messagePosition.y = game->npcs[i].position.y - 40;
-                                    SDL_FreeSurface(tempSurface);
-                                } else {
-                                    game->global.messagePosition.x = (npcWorldX - scroll_x) + (npcRect.w / 2) - 50;
-                                    game->global.messagePosition.y = game->npcs[i].position.y - 40;
-                                }
-                            } else {
-                                game->global.messagePosition.x = (npcWorldX - scroll_x) + (npcRect.w / 2) - 50;
-                                game->global.messagePosition.y = game->npcs[i].position.y - 40;
-                            }
-                            game->global.messagePosition.w = npcWorldX;
-                            game->global.messagePosition.h = i;
-                            if (game->input.enter && !game->npcs[i].dealing) {
-                                game->npcs[i].state = NPC_DIALOGUE;
-                                game->npcs[i].frame = 0;
-                                game->npcs[i].dealing = 1;
-                                game->input.enter = 0;
-                                if (i == 0) {
-                                    game->player.ammo += 5;
-                                    printf("NPC %d: Traded 5 ammo, player ammo=%d\n", i, game->player.ammo);
-                                } else {
-                                    game->player.health = game->player.maxHealth;
-                                    game->global.showHealthIcon = 1;
-                                    game->global.healthIconTimer = currentTime;
-                                    printf("NPC %d: Restored health, player health=%d, showing icon28\n", i, game->player.health);
-                                }
-                                game->npcs[i].state = NPC_APPROVAL;
-                                game->npcs[i].frame = 0;
-                            }
-                        } else {
-                            if (game->global.showMessage && 
-                                game->global.messagePosition.w == game->npcs[i].world_x &&
-                                game->global.messagePosition.h == i) {
-                                game->global.showMessage = 0;
-                                game->global.messagePosition.w = -1;
-                                game->global.messagePosition.h = -1;
-                            }
-                        }
                     }
                 }
             }
@@ -770,34 +990,7 @@ void playLevel(GAME *game) {
                     if (distance <= updateDistance) {
                         updateNPC2(&game->npc2s[i], deltaTime, &playerRect);
                         SDL_Rect npc2Rect = {game->npc2s[i].world_x, game->npc2s[i].position.y, game->npc2s[i].position.w, game->npc2s[i].position.h};
-                        if (rectIntersect(&playerRect, &npc2Rect) && !game->npc2s[i].dialogueActive) {
-                            game->global.showMessage = 1;
-                            strcpy(game->global.message, "Press E to talk");
-                            if (game->global.font) {
-                                SDL_Surface *tempSurface = TTF_RenderText_Solid(game->global.font, game->global.message, (SDL_Color){255, 255, 255});
-                                if (tempSurface) {
-                                    game->global.messagePosition.x = (npc2WorldX - scroll_x) + (npc2Rect.w / 2) - (tempSurface->w / 2);
-                                    game->global.messagePosition.y = game->npc2s[i].position.y - 40;
-                                    SDL_FreeSurface(tempSurface);
-                                } else {
-                                    game->global.messagePosition.x = (npc2WorldX - scroll_x) + (npc2Rect.w / 2) - 50;
-                                    game->global.messagePosition.y = game->npc2s[i].position.y - 40;
-                                }
-                            } else {
-                                game->global.messagePosition.x = (npc2WorldX - scroll_x) + (npc2Rect.w / 2) - 50;
-                                game->global.messagePosition.y = game->npc2s[i].position.y - 40;
-                            }
-                            game->global.messagePosition.w = npc2WorldX;
-                            game->global.messagePosition.h = i + MAX_NPCS;
-                        } else if (!rectIntersect(&playerRect, &npc2Rect)) {
-                            if (game->global.showMessage && 
-                                game->global.messagePosition.w == game->npc2s[i].world_x &&
-                                game->global.messagePosition.h == i + MAX_NPCS) {
-                                game->global.showMessage = 0;
-                                game->global.messagePosition.w = -1;
-                                game->global.messagePosition.h = -1;
-                            }
-                        }
+                        moveTrigger(&game->triggers, game->npc2s[i].trigger, npc2Rect);
                     }
                 }
             }
@@ -816,8 +1009,7 @@ void playLevel(GAME *game) {
             }
             // Free boss resources only when level-up icon is no longer active
             if (!game->boss.active && game->bossActive && !game->boss.levelUpIconActive) {
-                initPortal(&game->portal, 9000, 400);
-                game->portal.active = 1;
+                activatePortal(game, 9000, 400);
                 freeBoss(&game->boss);
                 game->bossActive = 0;
                 game->player.score += 1000;
@@ -920,109 +1112,13 @@ void playLevel(GAME *game) {
 
             if (game->portal.active) {
                 updatePortal(&game->portal);
-                SDL_Rect playerRect = {game->player.world_x, game->player.position.y, game->player.position.w, game->player.position.h};
-                SDL_Rect portalRect = {game->portal.position.x, game->portal.position.y, game->portal.position.w, game->portal.position.h};
-                if (rectIntersect(&playerRect, &portalRect)) {
-                    game->global.showMessage = 1;
-                    strcpy(game->global.message, "Press E to solve the enigma");
-                    game->global.messagePosition.x = game->portal.position.x - scroll_x - 50;
-                    game->global.messagePosition.y = game->portal.position.y - 50;
-                    game->global.messagePosition.w = game->portal.position.x;
-                    game->global.messagePosition.h = -1;
-                    if (game->input.enter) {
-                        game->global.quizActive = 1;
-                        initEnigme(game);
-                        game->input.enter = 0;
-                        game->portal.active = 0;
-                        freePortal(&game->portal);
-                        printf("Enigma activated\n");
-                    }
-                } else {
-                    if (game->global.showMessage && 
-                        game->global.messagePosition.w == game->portal.position.x &&
-                        game->global.messagePosition.h == -1) {
-                        game->global.showMessage = 0;
-                        game->global.messagePosition.w = -1;
-                        game->global.messagePosition.h = -1;
-                    }
-                }
             }
 
-            int x = game->player.world_x + game->player.position.w / 2;
-            int y = game->player.position.y + game->player.position.h;
-            int y_offset = (SCREEN_HEIGHT - game->background.height) / 2;
-            y -= y_offset;
-
-            if (x >= 0 && x < game->background.levelCollision->w && y >= 0 && y < game->background.levelCollision->h) {
-                if (game->level == 1) {
-                    Color col = collision_color(game, x, y);
-                    if (col == DOOR_RED) {
-                        game->player.nearDoor = 1;
-                        game->global.showMessage = 1;
-                        strcpy(game->global.message, "Press E to enter Level 2");
-                        game->global.messagePosition.x = x - scroll_x - 50;
-                        game->global.messagePosition.y = game->player.position.y - 50;
-                        game->global.messagePosition.w = x;
-                        game->global.messagePosition.h = -1;
-                    } else if (!game->portal.active) {
-                        if (game->global.showMessage && 
-                            game->global.messagePosition.w == x &&
-                            game->global.messagePosition.h == -1) {
-                            game->global.showMessage = 0;
-                            game->global.messagePosition.w = -1;
-                            game->global.messagePosition.h = -1;
-                        }
-                    }
-                } else if (game->level == 2) {
-                    int radius = 30;
-                    int foundDoor = 0;
-                    int doorWorldX = 0;
-                    for (int dx = -radius; dx <= radius && !foundDoor; dx += 2) {
-                        for (int dy = -radius; dy <= radius; dy += 2) {
-                            if (dx * dx + dy * dy <= radius * radius) {
-                                int check_x = x + dx;
-                                int check_y = y + dy;
-                                if (check_x >= 0 && check_x < game->background.levelCollision->w &&
-                                    check_y >= 0 && check_y < game->background.levelCollision->h) {
-                                    Color col = collision_color(game, check_x, check_y);
-                                    if (col == DOOR_RED) {
-                                        foundDoor = 1;
-                                        doorWorldX = check_x;
-                                        break;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    if (foundDoor) {
-                        game->player.nearDoor = 1;
-                        game->global.showMessage = 1;
-                        sprintf(game->global.message, "Press E to teleport to Zone %d", game->global.currentGreenZone + 1);
-                        game->global.messagePosition.x = doorWorldX - scroll_x - 50;
-                        game->global.messagePosition.y = game->player.position.y - 50;
-                        game->global.messagePosition.w = doorWorldX;
-                        game->global.messagePosition.h = -1;
-                    } else if (!game->portal.active) {
-                        if (game->global.showMessage && 
-                            game->global.messagePosition.w == doorWorldX &&
-                            game->global.messagePosition.h == -1) {
-                            game->player.nearDoor = -1;
-                            game->global.showMessage = 0;
-                            game->global.messagePosition.w = -1;
-                            game->global.messagePosition.h = -1;
-                        }
-                    }
-                }
-            } else if (!game->portal.active) {
-                game->player.nearDoor = -1;
-                if (game->global.showMessage && 
-                    game->global.messagePosition.w == game->player.world_x &&
-                    game->global.messagePosition.h == -1) {
-                    game->global.showMessage = 0;
-                    game->global.messagePosition.w = -1;
-                    game->global.messagePosition.h = -1;
-                }
-            }
+            // Doors, NPC counters and the portal raise their prompts from trigger callbacks
+            SDL_Rect playerBody = {game->player.world_x, game->player.position.y, game->player.position.w, game->player.position.h};
+            int feetX = game->player.world_x + game->player.position.w / 2;
+            int feetY = game->player.position.y + game->player.position.h;
+            updateTriggers(&game->triggers, game, playerBody, feetX, feetY);
 
             if (game->player.nearDoor >= 0 && game->input.enter) {
                 game->global.showMessage = 0;
@@ -1039,10 +1135,9 @@ void playLevel(GAME *game) {
                     printf("Teleported to Level 2, Zone 1, player at screen_x=%d, world_x=%d\n",
                            game->player.position.x, game->player.world_x);
                 } else if (game->level == 2 && game->player.nearDoor == 1 && game->global.currentGreenZone < 3) {
-                    int greenZones[3][2] = {{1900, 400}, {4080, 400}, {7800, 400}};
                     int zoneIndex = game->global.currentGreenZone;
-                    int greenZoneX = greenZones[zoneIndex][0];
-                    int greenZoneY = greenZones[zoneIndex][1];
+                    int greenZoneX = level2_green_zones[zoneIndex][0];
+                    int greenZoneY = level2_green_zones[zoneIndex][1];
                     int true_x = greenZoneX;
                     game->player.position.y = greenZoneY - game->player.position.h - 10;
                     game->player.world_x = true_x;
@@ -1060,10 +1155,6 @@ void playLevel(GAME *game) {
                            zoneIndex + 1, game->player.position.x, game->player.world_x, game->player.position.y);
                 }
                 game->player.nearDoor = -1;
-                if (game->global.messageSurface) {
-                    SDL_FreeSurface(game->global.messageSurface);
-                    game->global.messageSurface = NULL;
-                }
             }
 
             // Respawn logic for Player2 in level 3
@@ -1093,6 +1184,9 @@ void playLevel(GAME *game) {
         }
 
         if (game->global.quizActive) {
+            // The quiz covers the level; repaint whole so the frame after it does too
+            invalidateScreen();
+            beginDirtyFrame(scroll_x);
             renderEnigme(game);
         } else {
             if (game->global.gameOver && game->input.restart) {
@@ -1125,10 +1219,6 @@ void playLevel(GAME *game) {
                 game->global.currentGreenZone = 0;
                 game->global.showHealthIcon = 0;
                 game->global.healthIconTimer = 0;
-                if (game->global.messageSurface) {
-                    SDL_FreeSurface(game->global.messageSurface);
-                    game->global.messageSurface = NULL;
-                }
                 load_level(game, 1);
                 placePlayerOnGround(game);
                 printf("Game restarted, player at x=%d, y=%d\n", game->player.world_x, game->player.position.y);
@@ -1138,17 +1228,20 @@ void playLevel(GAME *game) {
                 fprintf(stderr, "playLevel: Screen is NULL before rendering\n");
                 exit(1);
             }
-            SDL_FillRect(game->screen, NULL, SDL_MapRGB(game->screen->format, 0, 0, 0));
-            SDL_Rect src = {scroll_x, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-            SDL_Rect dest = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
-            if (src.w > game->background.width - scroll_x) src.w = game->background.width - scroll_x;
-            if (src.h > game->background.height) src.h = game->background.height;
-            if (game->background.image) {
-                SDL_BlitSurface(game->background.image, &src, game->screen, &dest);
-            } else {
+            if (!game->background.tiles.tiles) {
                 fprintf(stderr, "playLevel: Background image is NULL\n");
                 exit(1);
             }
+            updateTiledBackground(&game->background.tiles, scroll_x, SCREEN_WIDTH);
+            // Only what was drawn last frame (and any strip scrolled into view) needs the background back
+            int numRestore = beginDirtyFrame(scroll_x);
+            if (numRestore < 0) {
+                SDL_Rect whole = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
+                restoreBackground(game, whole, scroll_x);
+            }
+            for (int i = 0; i < numRestore; i++) {
+                restoreBackground(game, dirtyRenderer.restore[i], scroll_x);
+            }
 
             if (game->level == 1) {
                 renderJet(game->screen, &game->jet, scroll_x);
@@ -1299,7 +1392,7 @@ void playLevel(GAME *game) {
                     }
                     iconDest.w = game->global.healthIcon28->w;
                     iconDest.h = game->global.healthIcon28->h;
-                    SDL_BlitSurface(game->global.healthIcon28, NULL, game->screen, &iconDest);
+                    trackedBlit(game->global.healthIcon28, NULL, game->screen, &iconDest);
                     printf("Rendering icon28 at x=%d, y=%d\n", iconDest.x, iconDest.y);
                 } else {
                     game->global.showHealthIcon = 0;
@@ -1314,37 +1407,35 @@ void playLevel(GAME *game) {
             }
 
             if (game->global.showMessage && game->global.font) {
-                if (game->global.messageSurface) {
-                    SDL_FreeSurface(game->global.messageSurface);
-                    game->global.messageSurface = NULL;
-                }
-                game->global.messageSurface = TTF_RenderText_Solid(game->global.font, game->global.message, (SDL_Color){255, 255, 255});
-                if (game->global.messageSurface) {
-                    SDL_Rect renderPos = game->global.messagePosition;
-                    if (game->global.messagePosition.h >= 0 && game->global.messagePosition.h < game->numNPCs) {
-                        int npcIndex = game->global.messagePosition.h;
-                        if (game->npcs[npcIndex].active) {
-                            int npcWorldX = game->npcs[npcIndex].world_x;
-                            renderPos.x = (npcWorldX - scroll_x) + (game->npcs[npcIndex].position.w / 2) - (game->global.messageSurface->w / 2);
-                        }
-                    } else if (game->global.messagePosition.h >= MAX_NPCS && game->global.messagePosition.h < MAX_NPCS + game->numNPC2s) {
-                        int npc2Index = game->global.messagePosition.h - MAX_NPCS;
-                        if (game->npc2s[npc2Index].active) {
-                            int npc2WorldX = game->npc2s[npc2Index].world_x;
-                            renderPos.x = (npc2WorldX - scroll_x) + (game->npc2s[npc2Index].position.w / 2) - (game->global.messageSurface->w / 2);
-                        }
-                    } else {
-                        int messageWorldX = game->global.messagePosition.w;
-                        renderPos.x = (messageWorldX - scroll_x) - (game->global.messageSurface->w / 2);
+                int textW = textWidth(game->global.font, game->global.message);
+                SDL_Rect renderPos = game->global.messagePosition;
+                if (game->global.messagePosition.h >= 0 && game->global.messagePosition.h < game->numNPCs) {
+                    int npcIndex = game->global.messagePosition.h;
+                    if (game->npcs[npcIndex].active) {
+                        int npcWorldX = game->npcs[npcIndex].world_x;
+                        renderPos.x = (npcWorldX - scroll_x) + (game->npcs[npcIndex].position.w / 2) - (textW / 2);
+                    }
+                } else if (game->global.messagePosition.h >= MAX_NPCS && game->global.messagePosition.h < MAX_NPCS + game->numNPC2s) {
+                    int npc2Index = game->global.messagePosition.h - MAX_NPCS;
+                    if (game->npc2s[npc2Index].active) {
+                        int npc2WorldX = game->npc2s[npc2Index].world_x;
+                        renderPos.x = (npc2WorldX - scroll_x) + (game->npc2s[npc2Index].position.w / 2) - (textW / 2);
                     }
-                    SDL_BlitSurface(game->global.messageSurface, NULL, game->screen, &renderPos);
                 } else {
-                    fprintf(stderr, "Failed to render message surface: %s\n", TTF_GetError());
+                    int messageWorldX = game->global.messagePosition.w;
+                    renderPos.x = (messageWorldX - scroll_x) - (textW / 2);
+                }
+                if (blitText(game->screen, game->global.font, game->global.message, (SDL_Color){255, 255, 255, 0},
+                             renderPos.x, renderPos.y) < 0) {
+                    fprintf(stderr, "Failed to render message text: %s\n", SDL_GetError());
                 }
             }
         }
 
-        SDL_Flip(game->screen);
+        if (game->debug.visible) renderDebugOverlay(game, game->screen, (int)game->background.scroll_x);
+
+        presentDirtyFrame();
+        collisionStatsEndFrame();
         Uint32 frameTime = SDL_GetTicks() - currentTime;
         const Uint32 targetFrameTime = 16; // ~60 FPS
         if (frameTime < targetFrameTime) {
@@ -21,12 +21,14 @@
 #include "enemy.h"
 #include "enigme.h"
 #include "enemylvl2.h"
+#include "glyphatlas.h"
 #include <SDL/SDL.h>
 #include <SDL/SDL_image.h>
 #include <SDL/SDL_ttf.h>
 #include <SDL/SDL_mixer.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define FPS 60
 #define SCREEN_WIDTH 1280
@@ -143,6 +145,7 @@ void freeGame(GAME *game) {
     freeInventory(&game->inventory);
     freeJet(&game->jet);
     freeResources(game); // From level.c
+    collisionStatsDump(getenv(DEBUG_STATS_ENV));
     // Do not free game->screen, as it’s managed by main
 }
 
@@ -177,7 +180,11 @@ int main() {
         return 1;
     }
 
-    SDL_Surface *screen = SDL_SetVideoMode(SCREEN_WIDTH, SCREEN_HEIGHT, 32, SDL_HWSURFACE | SDL_DOUBLEBUF);
+    // The dirty-rectangle renderer presents with SDL_UpdateRects(), which needs a single-buffered screen
+    const char *renderer = getenv(RENDERER_ENV);
+    int dirtyRects = renderer && strcmp(renderer, "dirty") == 0;
+    SDL_Surface *screen = SDL_SetVideoMode(SCREEN_WIDTH, SCREEN_HEIGHT, 32,
+                                           dirtyRects ? SDL_SWSURFACE : SDL_HWSURFACE | SDL_DOUBLEBUF);
     if (!screen) {
         fprintf(stderr, "Failed to create screen: %s\n", SDL_GetError());
         libererMusique(NULL);
@@ -187,6 +194,7 @@ int main() {
         return 1;
     }
     game_data.screen = screen; // Assign screen to game_data
+    initDirtyRenderer(screen, dirtyRects);
 
     countdown_beep = Mix_LoadWAV("assets/sounds/countdown_beep.wav");
     if (!countdown_beep) {
@@ -271,15 +279,15 @@ int main() {
                     break;
             }
             previous_state = current_state;
+            invalidateScreen();
         }
 
         switch (current_state) {
             case STATE_OPENING_ANIMATION:
                 renderBackground(screen, background_state);
-                SDL_Surface *skip_text = TTF_RenderText_Solid(font, "Press Space to Skip", (SDL_Color){255, 255, 255, 255});
-                SDL_Rect skip_pos = {(SCREEN_WIDTH - skip_text->w) / 2, SCREEN_HEIGHT - 50, 0, 0};
-                SDL_BlitSurface(skip_text, NULL, screen, &skip_pos);
-                SDL_FreeSurface(skip_text);
+                const char *skip_text = "Press Space to Skip";
+                blitText(screen, font, skip_text, (SDL_Color){255, 255, 255, 255},
+                         (SCREEN_WIDTH - textWidth(font, skip_text)) / 2, SCREEN_HEIGHT - 50);
                 SDL_Flip(screen);
 
                 SDL_Event event;
@@ -302,8 +310,9 @@ int main() {
 
             case STATE_MAIN_MENU:
                 handle_events(&running, &selected, buttons_main, 5, hover_sound, click_sound, &selected_button);
-                render(screen, background_main, buttons_main, 5, font, (SDL_Color){230, 195, 51}, selected_button);
-                SDL_Flip(screen);
+                if (render(screen, background_main, buttons_main, 5, font, (SDL_Color){230, 195, 51}, selected_button)) {
+                    presentDirtyFrame();
+                }
                 if (selected != -1) {
                     switch (selected) {
                         case 0: 
@@ -336,8 +345,7 @@ int main() {
                             }
                         }
                     }
-                    PlayerMenu_Render(screen);
-                    SDL_Flip(screen);
+                    if (PlayerMenu_Render(screen)) presentDirtyFrame();
                 }
                 break;
 
@@ -385,10 +393,8 @@ int main() {
                     SDL_BlitSurface(countdown_background, NULL, screen, NULL);
                     char countdown_text[20];
                     snprintf(countdown_text, sizeof(countdown_text), "%d", countdown_value);
-                    SDL_Surface *countdown_surface = TTF_RenderText_Solid(font, countdown_text, (SDL_Color){255, 255, 255});
-                    SDL_Rect countdown_pos = {(1280 - countdown_surface->w) / 2, (720 - countdown_surface->h) / 2, 0, 0};
-                    SDL_BlitSurface(countdown_surface, NULL, screen, &countdown_pos);
-                    SDL_FreeSurface(countdown_surface);
+                    blitText(screen, font, countdown_text, (SDL_Color){255, 255, 255, 0},
+                             (1280 - textWidth(font, countdown_text)) / 2, (720 - TTF_FontHeight(font)) / 2);
 
                     SDL_Flip(screen);
 
@@ -1,4 +1,6 @@
 #include "menu.h"
+#include "glyphatlas.h"
+#include "textcache.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -76,16 +78,43 @@ void handle_events(int *running, int *selected, Button buttons[], int button_cou
     }
 }
 
-void render(SDL_Surface *screen, SDL_Surface *background, Button buttons[], int button_count, TTF_Font *font, SDL_Color textColor, int selected_button) {
-    SDL_BlitSurface(background, NULL, screen, NULL);
+// Puts the background back under one button and draws it in its current state. The restored area
+// covers both images, so a larger hover image leaves nothing behind when the button is deselected.
+static void redrawButton(SDL_Surface *screen, SDL_Surface *background, Button *button, int selected) {
+    SDL_Rect area = button->position;
+    SDL_Surface *button_surface = selected ? button->hover_image : button->image;
+    area.w = button->image->w > button->hover_image->w ? button->image->w : button->hover_image->w;
+    area.h = button->image->h > button->hover_image->h ? button->image->h : button->hover_image->h;
+    SDL_Rect dest = area;
+    SDL_BlitSurface(background, &area, screen, &dest);
+    dest = area;
+    SDL_BlitSurface(button_surface, NULL, screen, &dest);
+    markDirty(area);
+}
+
+// Returns 0 when nothing changed since the last call and there is nothing to present
+int render(SDL_Surface *screen, SDL_Surface *background, Button buttons[], int button_count, TTF_Font *font, SDL_Color textColor, int selected_button) {
+    static int lastSelected = -1;
+    if (!consumeFullRedraw()) {
+        if (selected_button == lastSelected) return 0;
+        if (lastSelected >= 0 && lastSelected < button_count) redrawButton(screen, background, &buttons[lastSelected], 0);
+        if (selected_button >= 0 && selected_button < button_count) redrawButton(screen, background, &buttons[selected_button], 1);
+        lastSelected = selected_button;
+        return 1;
+    }
+
+    trackedBlit(background, NULL, screen, NULL);
     for (int i = 0; i < button_count; i++) {
         SDL_Surface *button_surface = (i == selected_button) ? buttons[i].hover_image : buttons[i].image;
-        SDL_BlitSurface(button_surface, NULL, screen, &buttons[i].position);
+        trackedBlit(button_surface, NULL, screen, &buttons[i].position);
+    }
+    SDL_Surface *titleSurface = cachedText(font, "Shattered Bloodline", textColor, TEXT_SOLID);
+    if (titleSurface) {
+        SDL_Rect titlePosition = {(SCREEN_WIDTH - titleSurface->w) / 2, 75, 0, 0};
+        trackedBlit(titleSurface, NULL, screen, &titlePosition);
     }
-    SDL_Surface *titleSurface = TTF_RenderText_Solid(font, "Shattered Bloodline", textColor);
-    SDL_Rect titlePosition = {(SCREEN_WIDTH - titleSurface->w) / 2, 75, 0, 0};
-    SDL_BlitSurface(titleSurface, NULL, screen, &titlePosition);
-    SDL_FreeSurface(titleSurface);
+    lastSelected = selected_button;
+    return 1;
 }
 
 void cleanup(Button buttons[], int button_count, SDL_Surface *background, Mix_Music *music, Mix_Chunk *hover_sound, Mix_Chunk *click_sound, TTF_Font *font) {
@@ -99,7 +128,11 @@ void cleanup(Button buttons[], int button_count, SDL_Surface *background, Mix_Mu
     if (music) Mix_FreeMusic(music);
     if (hover_sound) Mix_FreeChunk(hover_sound);
     if (click_sound) Mix_FreeChunk(click_sound);
-    if (font) TTF_CloseFont(font);
+    if (font) {
+        releaseGlyphFont(font);
+        releaseTextFont(font);
+        TTF_CloseFont(font);
+    }
     if (background_static) SDL_FreeSurface(background_static);
     
 }
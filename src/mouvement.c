@@ -4,112 +4,174 @@
 #include <SDL/SDL.h>
 #include <stdio.h>
 #include "utils.h"
+#include <stdlib.h>
 
 int onGround(GAME *game, Player *player) {
-    if (!game || !player || !game->background.levelCollision) {
-        fprintf(stderr, "onGround: Game, player, or levelCollision is NULL\n");
+    if (!game || !player || !game->background.collision.bits) {
+        fprintf(stderr, "onGround: Game, player, or collision map is NULL\n");
         return 0;
     }
 
     int x_left = player->world_x;
     int x_right = x_left + player->position.w - 1;
-    int y_offset = (SCREEN_HEIGHT - game->background.levelCollision->h) / 2;
+    int y_offset = game->background.collision.y_offset;
     int y_bottom = player->position.y + player->position.h - y_offset;
 
-    if (y_bottom < 0 || y_bottom >= game->background.levelCollision->h) {
-        printf("onGround: Invalid y_bottom %d for levelCollision height %d\n",
-               y_bottom, game->background.levelCollision->h);
+    if (y_bottom < 0 || y_bottom >= game->background.collision.h) {
+        printf("onGround: Invalid y_bottom %d for collision map height %d\n",
+               y_bottom, game->background.collision.h);
         return 0;
     }
 
-    for (int x = x_left; x <= x_right; x += 5) {
-        if (x >= 0 && x < game->background.levelCollision->w) {
-            SDL_Color color = get_pixel(game->background.levelCollision, x, y_bottom);
-            printf("onGround: Checking pixel at (%d, %d): R=%d, G=%d, B=%d\n", x, y_bottom, color.r, color.g, color.b);
-            if (color.r == 255 && color.g == 255 && color.b == 255) {
-                return 1;
+    return collisionRowSolid(&game->background.collision, x_left, x_right, y_bottom, 5);
+}
+
+static int compareProbes(const void *a, const void *b) {
+    return ((const GroundProbe *)a)->world_x - ((const GroundProbe *)b)->world_x;
+}
+
+// Answers every probe in one left-to-right sweep so consecutive lookups stay in nearby map bytes
+void onGroundBatch(GAME *game, GroundProbe *probes, int count) {
+    if (!game || !probes || !game->background.collision.bits) {
+        fprintf(stderr, "onGroundBatch: Game, probes, or collision map is NULL\n");
+        return;
+    }
+
+    const CollisionMap *map = &game->background.collision;
+    qsort(probes, count, sizeof(GroundProbe), compareProbes);
+    for (int i = 0; i < count; i++) {
+        int x_left = probes[i].world_x;
+        int y_bottom = probes[i].bottom_y - map->y_offset;
+        *probes[i].onGround = collisionRowSolid(map, x_left, x_left + probes[i].width - 1, y_bottom, 5);
+    }
+}
+
+// Returns how far feet at screen row bottom_y may move by dy this frame. Falls stop on the first
+// solid row crossed, so fast drops cannot skip thin platforms; upward moves pass through as before.
+int sweepMove(GAME *game, int world_x, int width, int bottom_y, int dy) {
+    if (!game || !game->background.collision.spans || dy <= 0) return dy;
+
+    const CollisionMap *map = &game->background.collision;
+    int feet = bottom_y - map->y_offset;
+    int ground = collisionGroundBelow(map, world_x, world_x + width - 1, 5, feet + 1);
+    if (ground >= 0 && ground - feet < dy) return ground - feet;
+    return dy;
+}
+
+// Walking direction (-1, 0 or 1) toward a target, following walk and drop edges of the navigation graph so
+// enemies take the way down to a lower target instead of pacing under it. Enemies never jump, so jump
+// edges are left out; with no route they stay on their platform. Re-plans every NAV_REPLAN_FRAMES.
+int chaseDirection(GAME *game, NavAgent *agent, int world_x, int width, int bottom_y, int target_x, int target_bottom_y) {
+    int direct = target_x > world_x ? 1 : (target_x < world_x ? -1 : 0);
+    if (!game || !agent || !game->background.nav.platforms) return direct;
+
+    NavGraph *nav = &game->background.nav;
+    const CollisionMap *map = &game->background.collision;
+    int center = world_x + width / 2;
+    if (--agent->timer <= 0) {
+        agent->timer = NAV_REPLAN_FRAMES;
+        agent->mode = NAV_AGENT_DIRECT;
+        int start = navPlatformAt(nav, map, center, bottom_y - map->y_offset);
+        int goal = navPlatformAt(nav, map, target_x, target_bottom_y - map->y_offset);
+        if (start >= 0 && goal >= 0 && start != goal) {
+            int e = navNextEdge(nav, start, center, goal, target_x, NAV_WALK | NAV_DROP);
+            if (e >= 0) {
+                agent->mode = NAV_AGENT_CROSS;
+                agent->waypointX = nav->edges[e].toX;
+                agent->direction = agent->waypointX > nav->edges[e].fromX ? 1 : -1;
+            } else {
+                agent->mode = NAV_AGENT_HOLD;
+                agent->platform = start;
             }
         }
     }
-    return 0;
+
+    if (agent->mode == NAV_AGENT_CROSS) {
+        int past = agent->direction > 0 ? world_x > agent->waypointX : world_x + width - 1 < agent->waypointX;
+        if (!past) return agent->direction;
+        agent->timer = 0;   // Landed on (or falling to) the next platform: re-plan next frame
+        return direct;
+    }
+    if (agent->mode == NAV_AGENT_HOLD) {
+        const NavPlatform *platform = &nav->platforms[agent->platform];
+        if (direct > 0 && world_x + width - 1 >= platform->x1) return 0;
+        if (direct < 0 && world_x <= platform->x0) return 0;
+    }
+    return direct;
+}
+
+// 1 when a patrol heading in direction has reached the end of its platform and no walk edge continues
+// there, so it turns before stepping off a ledge or into a wall. Off the graph (airborne) it never blocks.
+int patrolBlocked(GAME *game, int world_x, int width, int bottom_y, int direction) {
+    if (!game || !direction || !game->background.nav.platforms) return 0;
+
+    const NavGraph *nav = &game->background.nav;
+    const CollisionMap *map = &game->background.collision;
+    int center = world_x + width / 2;
+    int p = navPlatformAt(nav, map, center, bottom_y - map->y_offset);
+    if (p < 0) return 0;
+
+    const NavPlatform *platform = &nav->platforms[p];
+    int end = direction > 0 ? platform->x1 : platform->x0;
+    if (direction > 0 ? center < end : center > end) return 0;
+    for (int e = platform->firstEdge; e < platform->firstEdge + platform->numEdges; e++) {
+        if (nav->edges[e].type == NAV_WALK && nav->edges[e].fromX == end) return 0;
+    }
+    return 1;
 }
 
 int onGroundSoldier(GAME *game, Soldier *soldier) {
-    if (!game || !soldier || !game->background.levelCollision) {
-        fprintf(stderr, "onGroundSoldier: Game, soldier, or levelCollision is NULL\n");
+    if (!game || !soldier || !game->background.collision.bits) {
+        fprintf(stderr, "onGroundSoldier: Game, soldier, or collision map is NULL\n");
         return 0;
     }
 
     int x_left = soldier->world_x;
     int x_right = x_left + soldier->position.w - 1;
-    int y_offset = (SCREEN_HEIGHT - game->background.levelCollision->h) / 2;
+    int y_offset = game->background.collision.y_offset;
     int y_bottom = soldier->position.y + soldier->position.h - y_offset;
 
-    if (y_bottom < 0 || y_bottom >= game->background.levelCollision->h) {
+    if (y_bottom < 0 || y_bottom >= game->background.collision.h) {
         return 0;
     }
 
-    for (int x = x_left; x <= x_right; x += 5) {
-        if (x >= 0 && x < game->background.levelCollision->w) {
-            SDL_Color color = get_pixel(game->background.levelCollision, x, y_bottom);
-            if (color.r == 255 && color.g == 255 && color.b == 255) {
-                return 1;
-            }
-        }
-    }
-    return 0;
+    return collisionRowSolid(&game->background.collision, x_left, x_right, y_bottom, 5);
 }
 
 int onGroundSoldier2(GAME *game, Soldier2 *soldier) {
-    if (!game || !soldier || !game->background.levelCollision) {
-        fprintf(stderr, "onGroundSoldier2: Game, soldier, or levelCollision is NULL\n");
+    if (!game || !soldier || !game->background.collision.bits) {
+        fprintf(stderr, "onGroundSoldier2: Game, soldier, or collision map is NULL\n");
         return 0;
     }
 
     int x_left = soldier->world_x;
     int x_right = x_left + soldier->position.w - 1;
-    int y_offset = (SCREEN_HEIGHT - game->background.levelCollision->h) / 2;
+    int y_offset = game->background.collision.y_offset;
     int y_bottom = soldier->position.y + soldier->position.h - y_offset;
 
-    if (y_bottom < 0 || y_bottom >= game->background.levelCollision->h) {
+    if (y_bottom < 0 || y_bottom >= game->background.collision.h) {
         return 0;
     }
 
-    for (int x = x_left; x <= x_right; x += 5) {
-        if (x >= 0 && x < game->background.levelCollision->w) {
-            SDL_Color color = get_pixel(game->background.levelCollision, x, y_bottom);
-            if (color.r == 255 && color.g == 255 && color.b == 255) {
-                return 1;
-            }
-        }
-    }
-    return 0;
+    return collisionRowSolid(&game->background.collision, x_left, x_right, y_bottom, 5);
 }
 
 int onGroundEntity(GAME *game, SDL_Rect *position, int world_x) {
-    if (!game || !position || !game->background.levelCollision) {
-        fprintf(stderr, "onGroundEntity: Game, position, or levelCollision is NULL\n");
+    if (!game || !position || !game->background.collision.bits) {
+        fprintf(stderr, "onGroundEntity: Game, position, or collision map is NULL\n");
         return 0;
     }
 
     int x_left = world_x;
     int x_right = x_left + position->w - 1;
-    int y_offset = (SCREEN_HEIGHT - game->background.levelCollision->h) / 2;
+    int y_offset = game->background.collision.y_offset;
     int y_bottom = position->y + position->h - y_offset;
 
-    if (y_bottom < 0 || y_bottom >= game->background.levelCollision->h) {
+    if (y_bottom < 0 || y_bottom >= game->background.collision.h) {
         return 0;
     }
 
-    for (int x = x_left; x <= x_right; x += 5) {
-        if (x >= 0 && x < game->background.levelCollision->w) {
-            SDL_Color color = get_pixel(game->background.levelCollision, x, y_bottom);
-            if (color.r == 255 && color.g == 255 && color.b == 255) {
-                return 1;
-            }
-        }
-    }
-    return 0;
+    return collisionRowSolid(&game->background.collision, x_left, x_right, y_bottom, 5);
 }
 
 int onGroundEnemyLvl2(GAME *game, SDL_Rect *position, int world_x) {
@@ -117,65 +179,47 @@ int onGroundEnemyLvl2(GAME *game, SDL_Rect *position, int world_x) {
 }
 
 int onGroundBoss(GAME *game, Boss *boss) {
-    if (!game || !boss || !game->background.levelCollision) {
-        fprintf(stderr, "onGroundBoss: Game, boss, or levelCollision is NULL\n");
+    if (!game || !boss || !game->background.collision.bits) {
+        fprintf(stderr, "onGroundBoss: Game, boss, or collision map is NULL\n");
         return 0;
     }
 
     int x_left = boss->world_x;
     int x_right = x_left + boss->position.w - 1;
-    int y_offset = (SCREEN_HEIGHT - game->background.levelCollision->h) / 2;
+    int y_offset = game->background.collision.y_offset;
     int y_bottom = boss->y + boss->position.h - y_offset;
 
-    if (y_bottom < 0 || y_bottom >= game->background.levelCollision->h) {
-        printf("onGroundBoss: Invalid y_bottom %d for levelCollision height %d\n",
-               y_bottom, game->background.levelCollision->h);
+    if (y_bottom < 0 || y_bottom >= game->background.collision.h) {
+        printf("onGroundBoss: Invalid y_bottom %d for collision map height %d\n",
+               y_bottom, game->background.collision.h);
         return 0;
     }
 
-    for (int x = x_left; x <= x_right; x += 5) {
-        if (x >= 0 && x < game->background.levelCollision->w) {
-            SDL_Color color = get_pixel(game->background.levelCollision, x, y_bottom);
-            if (color.r == 255 && color.g == 255 && color.b == 255) {
-                return 1;
-            }
-        }
-    }
-    return 0;
+    return collisionRowSolid(&game->background.collision, x_left, x_right, y_bottom, 5);
 }
 
 int onGroundPlayer2(GAME *game, Player2 *player2) {
-    if (!game || !player2 || !game->background.levelCollision) {
-        fprintf(stderr, "onGroundPlayer2: Game, player2, or levelCollision is NULL\n");
+    if (!game || !player2 || !game->background.collision.bits) {
+        fprintf(stderr, "onGroundPlayer2: Game, player2, or collision map is NULL\n");
         return 0;
     }
 
     int x_left = player2->world_x;
     int x_right = x_left + player2->position.w - 1;
-    int y_offset = (SCREEN_HEIGHT - game->background.levelCollision->h) / 2;
+    int y_offset = game->background.collision.y_offset;
     int y_bottom = player2->position.y + player2->position.h - y_offset;
 
-    if (y_bottom < 0 || y_bottom >= game->background.levelCollision->h) {
-        printf("onGroundPlayer2: Invalid y_bottom %d for levelCollision height %d\n",
-               y_bottom, game->background.levelCollision->h);
+    if (y_bottom < 0 || y_bottom >= game->background.collision.h) {
+        printf("onGroundPlayer2: Invalid y_bottom %d for collision map height %d\n",
+               y_bottom, game->background.collision.h);
         return 0;
     }
 
-    for (int x = x_left; x <= x_right; x += 5) {
-        if (x >= 0 && x < game->background.levelCollision->w) {
-            SDL_Color color = get_pixel(game->background.levelCollision, x, y_bottom);
-            printf("onGroundPlayer2: Checking pixel at (%d, %d): R=%d, G=%d, B=%d\n", 
-                   x, y_bottom, color.r, color.g, color.b);
-            if (color.r == 255 && color.g == 255 && color.b == 255) {
-                return 1;
-            }
-        }
-    }
-    return 0;
+    return collisionRowSolid(&game->background.collision, x_left, x_right, y_bottom, 5);
 }
 void movement(GAME *game) {
-    if (!game || !game->background.levelCollision) {
-        fprintf(stderr, "movement: Game or levelCollision is NULL\n");
+    if (!game || !game->background.collision.bits) {
+        fprintf(stderr, "movement: Game or collision map is NULL\n");
         return;
     }
 
@@ -202,7 +246,8 @@ void movement(GAME *game) {
 
    
     if (!player->freezeYMovement) {
-        player->position.y += (int)player->yVelocity;
+        player->position.y += sweepMove(game, player->world_x, player->position.w,
+                                        player->position.y + player->position.h, (int)player->yVelocity);
     }
 
    
@@ -239,16 +284,16 @@ void movement(GAME *game) {
     int desired_scroll_x = player->world_x - target_x;
     if (desired_scroll_x < 0) {
         desired_scroll_x = 0;
-    } else if (desired_scroll_x > game->background.image->w - SCREEN_WIDTH) {
-        desired_scroll_x = game->background.image->w - SCREEN_WIDTH;
+    } else if (desired_scroll_x > game->background.tiles.width - SCREEN_WIDTH) {
+        desired_scroll_x = game->background.tiles.width - SCREEN_WIDTH;
     }
 
     float lerp_factor = 0.1f;
     game->background.scroll_x += (int)((desired_scroll_x - game->background.scroll_x) * lerp_factor);
     if (game->background.scroll_x < 0) {
         game->background.scroll_x = 0;
-    } else if (game->background.scroll_x > game->background.image->w - SCREEN_WIDTH) {
-        game->background.scroll_x = game->background.image->w - SCREEN_WIDTH;
+    } else if (game->background.scroll_x > game->background.tiles.width - SCREEN_WIDTH) {
+        game->background.scroll_x = game->background.tiles.width - SCREEN_WIDTH;
     }
 
    
@@ -258,8 +303,8 @@ void movement(GAME *game) {
     if (player->world_x < 0) {
         player->world_x = 0;
         player->position.x = 0;
-    } else if (player->world_x > game->background.image->w - player->position.w) {
-        player->world_x = game->background.image->w - player->position.w;
+    } else if (player->world_x > game->background.tiles.width - player->position.w) {
+        player->world_x = game->background.tiles.width - player->position.w;
         player->position.x = player->world_x - game->background.scroll_x;
     }
 
@@ -276,8 +321,8 @@ void movement(GAME *game) {
 }
 
 void movementPlayer2(GAME *game) {
-    if (!game || !game->background.levelCollision) {
-        fprintf(stderr, "movementPlayer2: Game or levelCollision is NULL\n");
+    if (!game || !game->background.collision.bits) {
+        fprintf(stderr, "movementPlayer2: Game or collision map is NULL\n");
         return;
     }
 
@@ -302,7 +347,8 @@ void movementPlayer2(GAME *game) {
     }
 
     // Apply vertical movement
-    player2->position.y += (int)player2->yVelocity;
+    player2->position.y += sweepMove(game, player2->world_x, player2->position.w,
+                                     player2->position.y + player2->position.h, (int)player2->yVelocity);
 
     // Check ground status
     int newOnGround = onGroundPlayer2(game, player2);
@@ -340,8 +386,8 @@ void movementPlayer2(GAME *game) {
     if (player2->world_x < 0) {
         player2->world_x = 0;
         player2->position.x = 0;
-    } else if (player2->world_x > game->background.image->w - player2->position.w) {
-        player2->world_x = game->background.image->w - player2->position.w;
+    } else if (player2->world_x > game->background.tiles.width - player2->position.w) {
+        player2->world_x = game->background.tiles.width - player2->position.w;
         player2->position.x = player2->world_x - game->background.scroll_x;
     }
 
@@ -0,0 +1,307 @@
+#include "navgraph.h"
+#include <SDL/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+// Extra route cost of leaving a platform by each edge type, on top of the distance walked
+#define NAV_DROP_COST 8
+#define NAV_JUMP_COST 32
+
+static int growArray(void **array, int *capacity, int count, size_t size) {
+    if (count < *capacity) return 1;
+    int grown = *capacity ? *capacity * 2 : 64;
+    void *bigger = realloc(*array, grown * size);
+    if (!bigger) return 0;
+    *array = bigger;
+    *capacity = grown;
+    return 1;
+}
+
+// Links each span top to the platform of the nearest surface within NAV_STEP in the previous column
+static int extractPlatforms(NavGraph *nav, const CollisionMap *map) {
+    int numSpans = map->spanStart[map->w];
+    int maxPerColumn = 1;
+    for (int x = 0; x < map->w; x++) {
+        int n = map->spanStart[x + 1] - map->spanStart[x];
+        if (n > maxPerColumn) maxPerColumn = n;
+    }
+
+    nav->spanPlatform = malloc((numSpans > 0 ? numSpans : 1) * sizeof(int));
+    int *open = malloc(maxPerColumn * sizeof(int));      // Spans of the previous column
+    Uint8 *taken = malloc(maxPerColumn);
+    if (!nav->spanPlatform || !open || !taken) {
+        free(open);
+        free(taken);
+        return 0;
+    }
+
+    int capacity = 0, numOpen = 0;
+    for (int x = 0; x < map->w; x++) {
+        memset(taken, 0, maxPerColumn);
+        for (int i = map->spanStart[x]; i < map->spanStart[x + 1]; i++) {
+            int top = map->spans[i].top;
+            int best = -1, bestDiff = NAV_STEP + 1;
+            for (int k = 0; k < numOpen; k++) {
+                int diff = abs(map->spans[open[k]].top - top);
+                if (!taken[k] && diff < bestDiff) {
+                    best = k;
+                    bestDiff = diff;
+                }
+            }
+
+            if (best >= 0) {
+                taken[best] = 1;
+                int p = nav->spanPlatform[open[best]];
+                nav->spanPlatform[i] = p;
+                nav->platforms[p].x1 = x;
+                continue;
+            }
+            if (!growArray((void **)&nav->platforms, &capacity, nav->numPlatforms, sizeof(NavPlatform))) {
+                free(open);
+                free(taken);
+                return 0;
+            }
+            NavPlatform *platform = &nav->platforms[nav->numPlatforms];
+            platform->x0 = platform->x1 = x;
+            platform->firstEdge = platform->numEdges = 0;
+            nav->spanPlatform[i] = nav->numPlatforms++;
+        }
+        numOpen = 0;
+        for (int i = map->spanStart[x]; i < map->spanStart[x + 1]; i++) open[numOpen++] = i;
+    }
+    free(open);
+    free(taken);
+
+    // Platforms take one span per column, so each one's surface rows are a contiguous run
+    int columns = 0;
+    for (int p = 0; p < nav->numPlatforms; p++) {
+        nav->platforms[p].surface = columns;
+        columns += nav->platforms[p].x1 - nav->platforms[p].x0 + 1;
+    }
+    nav->surfaceY = malloc((columns > 0 ? columns : 1) * sizeof(int));
+    if (!nav->surfaceY) return 0;
+    for (int x = 0; x < map->w; x++) {
+        for (int i = map->spanStart[x]; i < map->spanStart[x + 1]; i++) {
+            const NavPlatform *platform = &nav->platforms[nav->spanPlatform[i]];
+            nav->surfaceY[platform->surface + x - platform->x0] = map->spans[i].top;
+        }
+    }
+    return 1;
+}
+
+static int surfaceAt(const NavGraph *nav, int p, int x) {
+    const NavPlatform *platform = &nav->platforms[p];
+    return nav->surfaceY[platform->surface + x - platform->x0];
+}
+
+static int addEdge(NavGraph *nav, int *capacity, int from, int to, int fromX, int toX, NavEdgeType type) {
+    if (!growArray((void **)&nav->edges, capacity, nav->numEdges, sizeof(NavEdge))) return 0;
+    NavEdge *edge = &nav->edges[nav->numEdges++];
+    edge->from = from;
+    edge->to = to;
+    edge->fromX = fromX;
+    edge->toX = toX;
+    edge->type = type;
+    return 1;
+}
+
+// Walk or drop edge from the end of platform p at column x into the neighbouring column c
+static int addEndEdge(NavGraph *nav, int *capacity, const CollisionMap *map, int p, int x, int c) {
+    if (c < 0 || c >= map->w) return 1;
+    int y = surfaceAt(nav, p, x);
+    for (int i = map->spanStart[c]; i < map->spanStart[c + 1]; i++) {
+        const GroundSpan *span = &map->spans[i];
+        if (span->bottom < y - NAV_STEP) continue;
+        if (span->top < y - NAV_STEP) return 1;   // Wall taller than a step
+        NavEdgeType type = span->top <= y + NAV_STEP ? NAV_WALK : NAV_DROP;
+        return addEdge(nav, capacity, p, nav->spanPlatform[i], x, c, type);
+    }
+    return 1;
+}
+
+// Next sampled column after x; the last column of a run is always sampled
+static int nextSample(int x, int last) {
+    if (x == last) return last + 1;
+    return x + NAV_JUMP_SAMPLE < last ? x + NAV_JUMP_SAMPLE : last;
+}
+
+// Closest pair of sampled columns where `to` is across a gap or up a ledge, no higher than a jump
+static int addJumpEdge(NavGraph *nav, int *capacity, int from, int to, int maxJumpHeight, int maxJumpReach) {
+    const NavPlatform *a = &nav->platforms[from];
+    const NavPlatform *b = &nav->platforms[to];
+    if (b->x1 < a->x0 - maxJumpReach || b->x0 > a->x1 + maxJumpReach) return 1;
+
+    int bestFrom = -1, bestTo = -1, bestDist = maxJumpReach + 1;
+    for (int xb = b->x0; xb <= b->x1; xb = nextSample(xb, b->x1)) {
+        int yb = surfaceAt(nav, to, xb);
+        int lo = xb - maxJumpReach > a->x0 ? xb - maxJumpReach : a->x0;
+        int hi = xb + maxJumpReach < a->x1 ? xb + maxJumpReach : a->x1;
+        for (int xa = lo; xa <= hi; xa = nextSample(xa, hi)) {
+            int rise = surfaceAt(nav, from, xa) - yb;
+            int dist = abs(xa - xb);
+            int walkable = dist <= 1 && rise <= NAV_STEP;   // Already a walk edge
+            if (rise >= -NAV_STEP && rise <= maxJumpHeight && !walkable && dist < bestDist) {
+                bestFrom = xa;
+                bestTo = xb;
+                bestDist = dist;
+            }
+        }
+    }
+    if (bestFrom < 0) return 1;
+    return addEdge(nav, capacity, from, to, bestFrom, bestTo, NAV_JUMP);
+}
+
+static int compareEdges(const void *a, const void *b) {
+    return ((const NavEdge *)a)->from - ((const NavEdge *)b)->from;
+}
+
+static void indexEdges(NavGraph *nav) {
+    if (nav->numEdges > 0) qsort(nav->edges, nav->numEdges, sizeof(NavEdge), compareEdges);
+    for (int p = 0; p < nav->numPlatforms; p++) nav->platforms[p].firstEdge = nav->platforms[p].numEdges = 0;
+    for (int e = nav->numEdges - 1; e >= 0; e--) {
+        nav->platforms[nav->edges[e].from].firstEdge = e;
+        nav->platforms[nav->edges[e].from].numEdges++;
+    }
+}
+
+// Jump edges compare every pair of platforms, so level load leaves them out until an agent asks for them
+static void buildJumpEdges(NavGraph *nav) {
+    nav->haveJumpEdges = 1;
+    int before = nav->numEdges, ok = 1;
+    for (int p = 0; ok && p < nav->numPlatforms; p++) {
+        for (int q = 0; ok && q < nav->numPlatforms; q++) {
+            if (q != p) ok = addJumpEdge(nav, &nav->edgeCapacity, p, q, nav->maxJumpHeight, nav->maxJumpReach);
+        }
+    }
+    if (!ok) fprintf(stderr, "buildJumpEdges: Failed to allocate edges, some jumps are missing\n");
+    indexEdges(nav);
+    // Cached routes and their edge indices predate the jumps
+    for (int i = 0; i < NAV_CACHE_SIZE; i++) nav->cache[i].start = -1;
+    printf("Navigation graph: %d jump edges added\n", nav->numEdges - before);
+}
+
+int buildNavGraph(NavGraph *nav, const CollisionMap *map, int maxJumpHeight, int maxJumpReach) {
+    if (!nav || !map || !map->spans || !map->spanStart) {
+        fprintf(stderr, "buildNavGraph: Navigation graph or collision map is NULL\n");
+        return 0;
+    }
+    memset(nav, 0, sizeof(*nav));
+    nav->maxJumpHeight = maxJumpHeight;
+    nav->maxJumpReach = maxJumpReach;
+
+    if (!extractPlatforms(nav, map)) {
+        fprintf(stderr, "buildNavGraph: Failed to extract platforms\n");
+        freeNavGraph(nav);
+        return 0;
+    }
+
+    for (int p = 0; p < nav->numPlatforms; p++) {
+        const NavPlatform *platform = &nav->platforms[p];
+        if (!addEndEdge(nav, &nav->edgeCapacity, map, p, platform->x0, platform->x0 - 1) ||
+            !addEndEdge(nav, &nav->edgeCapacity, map, p, platform->x1, platform->x1 + 1)) {
+            fprintf(stderr, "buildNavGraph: Failed to allocate edges\n");
+            freeNavGraph(nav);
+            return 0;
+        }
+    }
+    indexEdges(nav);
+
+    int n = nav->numPlatforms > 0 ? nav->numPlatforms : 1;
+    nav->cost = malloc(n * sizeof(int));
+    nav->entryX = malloc(n * sizeof(int));
+    nav->cameFrom = malloc(n * sizeof(int));
+    nav->closed = malloc(n);
+    if (!nav->cost || !nav->entryX || !nav->cameFrom || !nav->closed) {
+        fprintf(stderr, "buildNavGraph: Failed to allocate search buffers\n");
+        freeNavGraph(nav);
+        return 0;
+    }
+    for (int i = 0; i < NAV_CACHE_SIZE; i++) nav->cache[i].start = -1;
+
+    printf("Navigation graph built: %d platforms, %d walk and drop edges\n", nav->numPlatforms, nav->numEdges);
+    return 1;
+}
+
+void freeNavGraph(NavGraph *nav) {
+    if (!nav) return;
+    free(nav->platforms);
+    free(nav->edges);
+    free(nav->surfaceY);
+    free(nav->spanPlatform);
+    free(nav->cost);
+    free(nav->entryX);
+    free(nav->cameFrom);
+    free(nav->closed);
+    memset(nav, 0, sizeof(*nav));
+}
+
+int navPlatformAt(const NavGraph *nav, const CollisionMap *map, int x, int feet_y) {
+    if (!nav || !nav->spanPlatform || !map || x < 0 || x >= map->w) return -1;
+    for (int i = map->spanStart[x]; i < map->spanStart[x + 1]; i++) {
+        if (map->spans[i].bottom >= feet_y - NAV_STEP) return nav->spanPlatform[i];
+    }
+    return -1;
+}
+
+// A* over platforms; walking cost is the horizontal distance from where a platform was entered
+static int findRoute(NavGraph *nav, int start, int startX, int goal, int goalX, int allowed) {
+    for (int p = 0; p < nav->numPlatforms; p++) {
+        nav->cost[p] = INT_MAX;
+        nav->cameFrom[p] = -1;
+        nav->closed[p] = 0;
+    }
+    nav->cost[start] = 0;
+    nav->entryX[start] = startX;
+
+    for (;;) {
+        int current = -1, bestScore = INT_MAX;
+        for (int p = 0; p < nav->numPlatforms; p++) {
+            if (nav->closed[p] || nav->cost[p] == INT_MAX) continue;
+            int score = nav->cost[p] + abs(goalX - nav->entryX[p]);
+            if (score < bestScore) {
+                current = p;
+                bestScore = score;
+            }
+        }
+        if (current < 0) return -1;
+        if (current == goal) break;
+        nav->closed[current] = 1;
+
+        const NavPlatform *platform = &nav->platforms[current];
+        for (int e = platform->firstEdge; e < platform->firstEdge + platform->numEdges; e++) {
+            const NavEdge *edge = &nav->edges[e];
+            if (!(edge->type & allowed) || nav->closed[edge->to]) continue;
+            int cost = nav->cost[current] + abs(edge->fromX - nav->entryX[current]) + abs(edge->toX - edge->fromX);
+            if (edge->type == NAV_DROP) cost += NAV_DROP_COST;
+            if (edge->type == NAV_JUMP) cost += NAV_JUMP_COST;
+            if (cost < nav->cost[edge->to]) {
+                nav->cost[edge->to] = cost;
+                nav->entryX[edge->to] = edge->toX;
+                nav->cameFrom[edge->to] = e;
+            }
+        }
+    }
+
+    int e = nav->cameFrom[goal];
+    while (nav->edges[e].from != start) e = nav->cameFrom[nav->edges[e].from];
+    return e;
+}
+
+int navNextEdge(NavGraph *nav, int start, int startX, int goal, int goalX, int allowed) {
+    if (!nav || !nav->cost || start < 0 || goal < 0 || start == goal ||
+        start >= nav->numPlatforms || goal >= nav->numPlatforms) return -1;
+    if ((allowed & NAV_JUMP) && !nav->haveJumpEdges) buildJumpEdges(nav);
+
+    // The cached route ignores where on the start platform the query came from; platforms are few
+    // and long, so the first hop rarely changes while an entity walks along one
+    NavRoute *route = &nav->cache[(unsigned)(start * 31 + goal * 17 + allowed) % NAV_CACHE_SIZE];
+    if (route->start != start || route->goal != goal || route->allowed != allowed) {
+        route->start = start;
+        route->goal = goal;
+        route->allowed = allowed;
+        route->edge = findRoute(nav, start, startX, goal, goalX, allowed);
+    }
+    return route->edge;
+}
@@ -24,27 +24,42 @@ void initNPC(NPC *npc, int x, int y, const char *dialogue, GAME *game) {
     sprintf(path, "assets/npc/npc_idle.png");
     npc->idleSheet = IMG_Load(path);
     if (!npc->idleSheet) fprintf(stderr, "Failed to load %s: %s\n", path, IMG_GetError());
-    else SDL_SetColorKey(npc->idleSheet, SDL_SRCCOLORKEY, SDL_MapRGB(npc->idleSheet->format, 255, 0, 255));
+    else {
+        SDL_SetColorKey(npc->idleSheet, SDL_SRCCOLORKEY, SDL_MapRGB(npc->idleSheet->format, 255, 0, 255));
+        packSpriteSheet(npc->idleSheet, 256, 256);
+    }
 
     sprintf(path, "assets/npc/npc_idle2.png");
     npc->idle2Sheet = IMG_Load(path);
     if (!npc->idle2Sheet) fprintf(stderr, "Failed to load %s: %s\n", path, IMG_GetError());
-    else SDL_SetColorKey(npc->idle2Sheet, SDL_SRCCOLORKEY, SDL_MapRGB(npc->idle2Sheet->format, 255, 0, 255));
+    else {
+        SDL_SetColorKey(npc->idle2Sheet, SDL_SRCCOLORKEY, SDL_MapRGB(npc->idle2Sheet->format, 255, 0, 255));
+        packSpriteSheet(npc->idle2Sheet, 256, 256);
+    }
 
     sprintf(path, "assets/npc/npc_idle3.png");
     npc->idle3Sheet = IMG_Load(path);
     if (!npc->idle3Sheet) fprintf(stderr, "Failed to load %s: %s\n", path, IMG_GetError());
-    else SDL_SetColorKey(npc->idle3Sheet, SDL_SRCCOLORKEY, SDL_MapRGB(npc->idle3Sheet->format, 255, 0, 255));
+    else {
+        SDL_SetColorKey(npc->idle3Sheet, SDL_SRCCOLORKEY, SDL_MapRGB(npc->idle3Sheet->format, 255, 0, 255));
+        packSpriteSheet(npc->idle3Sheet, 256, 256);
+    }
 
     sprintf(path, "assets/npc/npc_dialogue.png");
     npc->dialogueSheet = IMG_Load(path);
     if (!npc->dialogueSheet) fprintf(stderr, "Failed to load %s: %s\n", path, IMG_GetError());
-    else SDL_SetColorKey(npc->dialogueSheet, SDL_SRCCOLORKEY, SDL_MapRGB(npc->dialogueSheet->format, 255, 0, 255));
+    else {
+        SDL_SetColorKey(npc->dialogueSheet, SDL_SRCCOLORKEY, SDL_MapRGB(npc->dialogueSheet->format, 255, 0, 255));
+        packSpriteSheet(npc->dialogueSheet, 256, 256);
+    }
 
     sprintf(path, "assets/npc/npc_approval.png");
     npc->approvalSheet = IMG_Load(path);
     if (!npc->approvalSheet) fprintf(stderr, "Failed to load %s: %s\n", path, IMG_GetError());
-    else SDL_SetColorKey(npc->approvalSheet, SDL_SRCCOLORKEY, SDL_MapRGB(npc->approvalSheet->format, 255, 0, 255));
+    else {
+        SDL_SetColorKey(npc->approvalSheet, SDL_SRCCOLORKEY, SDL_MapRGB(npc->approvalSheet->format, 255, 0, 255));
+        packSpriteSheet(npc->approvalSheet, 256, 256);
+    }
 
     // Load health icon for NPC 1 (health restoration NPC)
     if (game->level == 1 && strcmp(dialogue, "I restore health!") == 0) {
@@ -55,6 +70,7 @@ void initNPC(NPC *npc, int x, int y, const char *dialogue, GAME *game) {
             npc->healthIcon = NULL;
         } else {
             SDL_SetColorKey(npc->healthIcon, SDL_SRCCOLORKEY, SDL_MapRGB(npc->healthIcon->format, 255, 0, 255));
+            packSpriteSheet(npc->healthIcon, npc->healthIcon->w, npc->healthIcon->h);
             printf("Health icon loaded for NPC\n");
         }
     } else {
@@ -85,26 +101,32 @@ void freeNPC(NPC *npc) {
     }
 
     if (npc->idleSheet) {
+        unpackSpriteSheet(npc->idleSheet);
         SDL_FreeSurface(npc->idleSheet);
         npc->idleSheet = NULL;
     }
     if (npc->idle2Sheet) {
+        unpackSpriteSheet(npc->idle2Sheet);
         SDL_FreeSurface(npc->idle2Sheet);
         npc->idle2Sheet = NULL;
     }
     if (npc->idle3Sheet) {
+        unpackSpriteSheet(npc->idle3Sheet);
         SDL_FreeSurface(npc->idle3Sheet);
         npc->idle3Sheet = NULL;
     }
     if (npc->dialogueSheet) {
+        unpackSpriteSheet(npc->dialogueSheet);
         SDL_FreeSurface(npc->dialogueSheet);
         npc->dialogueSheet = NULL;
     }
     if (npc->approvalSheet) {
+        unpackSpriteSheet(npc->approvalSheet);
         SDL_FreeSurface(npc->approvalSheet);
         npc->approvalSheet = NULL;
     }
     if (npc->healthIcon) {
+        unpackSpriteSheet(npc->healthIcon);
         SDL_FreeSurface(npc->healthIcon);
         npc->healthIcon = NULL;
     }
@@ -194,8 +216,8 @@ void renderNPC(SDL_Surface *screen, NPC *npc, int scroll_x, GAME *game) {
 
     SDL_Rect src = {npc->frame * 256, 0, 256, 256}; // Updated to 256x256
     SDL_Rect dest = {npc->world_x - scroll_x, npc->position.y, 256, 256}; // Updated to 256x256
-    if (SDL_BlitSurface(sheet, &src, screen, &dest) < 0) {
-        fprintf(stderr, "renderNPC: SDL_BlitSurface failed: %s\n", SDL_GetError());
+    if (blitSprite(sheet, &src, screen, &dest, 0) < 0) {
+        fprintf(stderr, "renderNPC: blitSprite failed: %s\n", SDL_GetError());
     }
 
     // Render health icon if active
@@ -205,8 +227,8 @@ void renderNPC(SDL_Surface *screen, NPC *npc, int scroll_x, GAME *game) {
         int startX = (npc->world_x - scroll_x) + (npc->position.w / 2) - (iconWidth / 2); // Center horizontally
         int startY = npc->position.y - iconHeight - 10; // 10 pixels above NPC
         SDL_Rect iconDest = {startX, startY, iconWidth, iconHeight};
-        if (SDL_BlitSurface(npc->healthIcon, NULL, screen, &iconDest) < 0) {
-            fprintf(stderr, "renderNPC: SDL_BlitSurface failed for health icon: %s\n", SDL_GetError());
+        if (blitSprite(npc->healthIcon, NULL, screen, &iconDest, 0) < 0) {
+            fprintf(stderr, "renderNPC: blitSprite failed for health icon: %s\n", SDL_GetError());
         }
     }
 }
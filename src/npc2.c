@@ -7,6 +7,7 @@
 #include "npc2.h"
 #include "collision.h"
 #include "utils.h"
+#include "glyphatlas.h"
 
 void initNPC2(NPC2* npc, int x, int y, GAME* game) {
     if (!npc || !game) {
@@ -31,6 +32,7 @@ void initNPC2(NPC2* npc, int x, int y, GAME* game) {
         fprintf(stderr, "initNPC2: Failed to load %s: %s\n", path, IMG_GetError());
     } else {
         SDL_SetColorKey(npc->movementSheet, SDL_SRCCOLORKEY, SDL_MapRGB(npc->movementSheet->format, 255, 0, 255));
+        packSpriteSheet(npc->movementSheet, 128, 128);
         printf("initNPC2: Loaded movementSheet (%dx%d)\n", npc->movementSheet->w, npc->movementSheet->h);
     }
 
@@ -40,6 +42,7 @@ void initNPC2(NPC2* npc, int x, int y, GAME* game) {
         fprintf(stderr, "initNPC2: Failed to load %s: %s\n", path, IMG_GetError());
     } else {
         SDL_SetColorKey(npc->dialogueSheet, SDL_SRCCOLORKEY, SDL_MapRGB(npc->dialogueSheet->format, 255, 0, 255));
+        packSpriteSheet(npc->dialogueSheet, 128, 128);
         printf("initNPC2: Loaded dialogueSheet (%dx%d)\n", npc->dialogueSheet->w, npc->dialogueSheet->h);
     }
 
@@ -49,6 +52,7 @@ void initNPC2(NPC2* npc, int x, int y, GAME* game) {
         fprintf(stderr, "initNPC2: Failed to load %s: %s\n", path, IMG_GetError());
     } else {
         SDL_SetColorKey(npc->bustImage, SDL_SRCCOLORKEY, SDL_MapRGB(npc->bustImage->format, 255, 0, 255));
+        packSpriteSheet(npc->bustImage, npc->bustImage->w, npc->bustImage->h);
         printf("initNPC2: Loaded bustImage (%dx%d)\n", npc->bustImage->w, npc->bustImage->h);
     }
 
@@ -188,39 +192,33 @@ void renderNPC2(SDL_Surface* screen, NPC2* npc, int scroll_x, GAME* game) {
             srcRect.y = 96;
         }
         SDL_Rect destRect = {screenX, yPos, 128, 128};
-        if (SDL_BlitSurface(npc->movementSheet, &srcRect, screen, &destRect) != 0) {
+        if (blitSprite(npc->movementSheet, &srcRect, screen, &destRect, 0) != 0) {
             printf("renderNPC2: Failed to blit movementSheet: %s\n", SDL_GetError());
         }
     } else {
         // Render dialogue animation
         SDL_Rect dialogueSrcRect = {npc->dialogueFrame * 128, npc->dialogueLine * 128, 128, 128};
         SDL_Rect dialogueDestRect = {screenX + 128 - 32, yPos - 16, 128, 128}; // Adjusted to align above NPC
-        if (SDL_BlitSurface(npc->dialogueSheet, &dialogueSrcRect, screen, &dialogueDestRect) != 0) {
+        if (blitSprite(npc->dialogueSheet, &dialogueSrcRect, screen, &dialogueDestRect, 0) != 0) {
             printf("renderNPC2: Failed to blit dialogueSheet: %s\n", SDL_GetError());
         }
 
         // Render dialogue box
         SDL_Rect dialogueBox = {screenX + 128 + 10, yPos - 10, 300, 80};
-        SDL_FillRect(screen, &dialogueBox, SDL_MapRGB(screen->format, 50, 50, 50));
+        trackedFill(screen, &dialogueBox, SDL_MapRGB(screen->format, 50, 50, 50));
 
         // Render dialogue text
         if (npc->font) {
             SDL_Color textColor = {255, 255, 255};
-            SDL_Surface* textSurface = TTF_RenderText_Solid(npc->font, npc->dialogueText[npc->dialogueLine], textColor);
-            if (textSurface) {
-                SDL_Rect textDest = {dialogueBox.x + 10, dialogueBox.y + 10, textSurface->w, textSurface->h};
-                if (SDL_BlitSurface(textSurface, NULL, screen, &textDest) != 0) {
-                    printf("renderNPC2: Failed to blit textSurface: %s\n", SDL_GetError());
-                }
-                SDL_FreeSurface(textSurface);
-            } else {
-                printf("renderNPC2: Failed to render text: %s\n", TTF_GetError());
+            if (blitText(screen, npc->font, npc->dialogueText[npc->dialogueLine], textColor,
+                         dialogueBox.x + 10, dialogueBox.y + 10) != 0) {
+                printf("renderNPC2: Failed to draw dialogue text: %s\n", SDL_GetError());
             }
         }
 
         // Render bust image
         SDL_Rect bustDestRect = {screenX - npc->bustImage->w - 10, yPos + 128 - npc->bustImage->h, npc->bustImage->w, npc->bustImage->h};
-        if (SDL_BlitSurface(npc->bustImage, NULL, screen, &bustDestRect) != 0) {
+        if (blitSprite(npc->bustImage, NULL, screen, &bustDestRect, 0) != 0) {
             printf("renderNPC2: Failed to blit bustImage: %s\n", SDL_GetError());
         }
     }
@@ -229,8 +227,17 @@ void renderNPC2(SDL_Surface* screen, NPC2* npc, int scroll_x, GAME* game) {
 void freeNPC2(NPC2* npc) {
     if (!npc) return;
 
-    if (npc->movementSheet) SDL_FreeSurface(npc->movementSheet);
-    if (npc->dialogueSheet) SDL_FreeSurface(npc->dialogueSheet);
-    if (npc->bustImage) SDL_FreeSurface(npc->bustImage);
+    if (npc->movementSheet) {
+        unpackSpriteSheet(npc->movementSheet);
+        SDL_FreeSurface(npc->movementSheet);
+    }
+    if (npc->dialogueSheet) {
+        unpackSpriteSheet(npc->dialogueSheet);
+        SDL_FreeSurface(npc->dialogueSheet);
+    }
+    if (npc->bustImage) {
+        unpackSpriteSheet(npc->bustImage);
+        SDL_FreeSurface(npc->bustImage);
+    }
     npc->active = 0;
 }
@@ -0,0 +1,100 @@
+#include "pixelkernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define PIXELKERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+enum { KERNELS_SCALAR, KERNELS_SSE2, KERNELS_AVX2 };
+
+static int kernelLevel(void) {
+    static int level = -1;
+    if (level < 0) {
+#ifdef PIXELKERNELS_X86
+        __builtin_cpu_init();
+        level = __builtin_cpu_supports("avx2") ? KERNELS_AVX2 : KERNELS_SSE2;
+#else
+        level = KERNELS_SCALAR;
+#endif
+    }
+    return level;
+}
+
+#ifdef PIXELKERNELS_X86
+// Each kernel does its whole vectors from the start of the row and returns how far it got; the
+// scalar loop finishes the tail
+
+__attribute__((target("avx2")))
+static int reverse32Avx2(Uint32 *dst, const Uint32 *src, int count) {
+    const __m256i order = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(src + count - 8 - i));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_permutevar8x32_epi32(v, order));
+    }
+    return i;
+}
+
+static int reverse32Sse2(Uint32 *dst, const Uint32 *src, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + count - 4 - i));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static int clearKeyedAvx2(Uint32 *pixels, int count, Uint32 rgbMask, Uint32 key, int *cleared) {
+    const __m256i mask = _mm256_set1_epi32((int)rgbMask), k = _mm256_set1_epi32((int)key);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(pixels + i));
+        __m256i keyed = _mm256_cmpeq_epi32(_mm256_and_si256(v, mask), k);
+        unsigned bits = (unsigned)_mm256_movemask_epi8(keyed);
+        if (bits) {
+            *cleared += __builtin_popcount(bits) >> 2;
+            _mm256_storeu_si256((__m256i *)(pixels + i), _mm256_andnot_si256(keyed, v));
+        }
+    }
+    return i;
+}
+
+static int clearKeyedSse2(Uint32 *pixels, int count, Uint32 rgbMask, Uint32 key, int *cleared) {
+    const __m128i mask = _mm_set1_epi32((int)rgbMask), k = _mm_set1_epi32((int)key);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(pixels + i));
+        __m128i keyed = _mm_cmpeq_epi32(_mm_and_si128(v, mask), k);
+        unsigned bits = (unsigned)_mm_movemask_epi8(keyed);
+        if (bits) {
+            *cleared += __builtin_popcount(bits) >> 2;
+            _mm_storeu_si128((__m128i *)(pixels + i), _mm_andnot_si128(keyed, v));
+        }
+    }
+    return i;
+}
+#endif
+
+void reversePixels32(Uint32 *dst, const Uint32 *src, int count) {
+    int i = 0;
+#ifdef PIXELKERNELS_X86
+    i = kernelLevel() == KERNELS_AVX2 ? reverse32Avx2(dst, src, count) : reverse32Sse2(dst, src, count);
+#endif
+    for (; i < count; i++) dst[i] = src[count - 1 - i];
+}
+
+int clearKeyedPixels32(Uint32 *pixels, int count, Uint32 rgbMask, Uint32 key) {
+    int cleared = 0, i = 0;
+#ifdef PIXELKERNELS_X86
+    i = kernelLevel() == KERNELS_AVX2 ? clearKeyedAvx2(pixels, count, rgbMask, key, &cleared)
+                                      : clearKeyedSse2(pixels, count, rgbMask, key, &cleared);
+#endif
+    for (; i < count; i++) {
+        if ((pixels[i] & rgbMask) == key) {
+            pixels[i] = 0;
+            cleared++;
+        }
+    }
+    return cleared;
+}
@@ -30,13 +30,8 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->idleSheet, SDL_SRCCOLORKEY, SDL_MapRGB(player->idleSheet->format, 255, 0, 255));
-    player->idleSheetFlipped = flipHorizontally(player->idleSheet);
-    if (!player->idleSheetFlipped) {
-        fprintf(stderr, "Failed to flip Idle_resized.png\n");
-        freePlayer(player);
-        exit(1);
-    }
-    printf("Idle sheet loaded and flipped.\n");
+    packSpriteSheet(player->idleSheet, 256, 256);
+    printf("Idle sheet loaded.\n");
 
     // Load walk sheet
     player->walkSheet = IMG_Load("assets/player/Walk_resized.png");
@@ -46,13 +41,8 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->walkSheet, SDL_SRCCOLORKEY, SDL_MapRGB(player->walkSheet->format, 255, 0, 255));
-    player->walkSheetFlipped = flipHorizontally(player->walkSheet);
-    if (!player->walkSheetFlipped) {
-        fprintf(stderr, "Failed to flip Walk_resized.png\n");
-        freePlayer(player);
-        exit(1);
-    }
-    printf("Walk sheet loaded and flipped.\n");
+    packSpriteSheet(player->walkSheet, 256, 256);
+    printf("Walk sheet loaded.\n");
 
     // Load run sheet
     player->runSheet = IMG_Load("assets/player/Run_resized.png");
@@ -62,13 +52,8 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->runSheet, SDL_SRCCOLORKEY, SDL_MapRGB(player->runSheet->format, 255, 0, 255));
-    player->runSheetFlipped = flipHorizontally(player->runSheet);
-    if (!player->runSheetFlipped) {
-        fprintf(stderr, "Failed to flip Run_resized.png\n");
-        freePlayer(player);
-        exit(1);
-    }
-    printf("Run sheet loaded and flipped.\n");
+    packSpriteSheet(player->runSheet, 256, 256);
+    printf("Run sheet loaded.\n");
 
     // Load jump sheet
     player->jumpSheet = IMG_Load("assets/player/Jump_resized.png");
@@ -78,13 +63,8 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->jumpSheet, SDL_SRCCOLORKEY, SDL_MapRGB(player->jumpSheet->format, 255, 0, 255));
-    player->jumpSheetFlipped = flipHorizontally(player->jumpSheet);
-    if (!player->jumpSheetFlipped) {
-        fprintf(stderr, "Failed to flip Jump_resized.png\n");
-        freePlayer(player);
-        exit(1);
-    }
-    printf("Jump sheet loaded and flipped.\n");
+    packSpriteSheet(player->jumpSheet, 256, 256);
+    printf("Jump sheet loaded.\n");
 
     // Load attack1 sheet
     player->attack1Sheet = IMG_Load("assets/player/Attack_1_resized.png");
@@ -94,13 +74,8 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->attack1Sheet, SDL_SRCCOLORKEY, SDL_MapRGB(player->attack1Sheet->format, 255, 0, 255));
-    player->attack1SheetFlipped = flipHorizontally(player->attack1Sheet);
-    if (!player->attack1SheetFlipped) {
-        fprintf(stderr, "Failed to flip Attack_1_resized.png\n");
-        freePlayer(player);
-        exit(1);
-    }
-    printf("Attack1 sheet loaded and flipped.\n");
+    packSpriteSheet(player->attack1Sheet, 256, 256);
+    printf("Attack1 sheet loaded.\n");
 
     // Load shot sheet
     player->shotSheet = IMG_Load("assets/player/Shot_resized.png");
@@ -110,13 +85,8 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->shotSheet, SDL_SRCCOLORKEY, SDL_MapRGB(player->shotSheet->format, 255, 0, 255));
-    player->shotSheetFlipped = flipHorizontally(player->shotSheet);
-    if (!player->shotSheetFlipped) {
-        fprintf(stderr, "Failed to flip Shot_resized.png\n");
-        freePlayer(player);
-        exit(1);
-    }
-    printf("Shot sheet loaded and flipped.\n");
+    packSpriteSheet(player->shotSheet, 256, 256);
+    printf("Shot sheet loaded.\n");
 
     // Load recharge sheet
     player->rechargeSheet = IMG_Load("assets/player/Recharge_resized.png");
@@ -126,13 +96,8 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->rechargeSheet, SDL_SRCCOLORKEY, SDL_MapRGB(player->rechargeSheet->format, 255, 0, 255));
-    player->rechargeSheetFlipped = flipHorizontally(player->rechargeSheet);
-    if (!player->rechargeSheetFlipped) {
-        fprintf(stderr, "Failed to flip Recharge_resized.png\n");
-        freePlayer(player);
-        exit(1);
-    }
-    printf("Recharge sheet loaded and flipped.\n");
+    packSpriteSheet(player->rechargeSheet, 256, 256);
+    printf("Recharge sheet loaded.\n");
 
     // Load hurt sheet
     player->hurtSheet = IMG_Load("assets/player/Hurt_resized.png");
@@ -142,13 +107,8 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->hurtSheet, SDL_SRCCOLORKEY, SDL_MapRGB(player->hurtSheet->format, 255, 0, 255));
-    player->hurtSheetFlipped = flipHorizontally(player->hurtSheet);
-    if (!player->hurtSheetFlipped) {
-        fprintf(stderr, "Failed to flip Hurt_resized.png\n");
-        freePlayer(player);
-        exit(1);
-    }
-    printf("Hurt sheet loaded and flipped.\n");
+    packSpriteSheet(player->hurtSheet, 256, 256);
+    printf("Hurt sheet loaded.\n");
 
     // Load dead sheet
     player->deadSheet = IMG_Load("assets/player/Dead_resized.png");
@@ -158,13 +118,8 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->deadSheet, SDL_SRCCOLORKEY, SDL_MapRGB(player->deadSheet->format, 255, 0, 255));
-    player->deadSheetFlipped = flipHorizontally(player->deadSheet);
-    if (!player->deadSheetFlipped) {
-        fprintf(stderr, "Failed to flip Dead_resized.png\n");
-        freePlayer(player);
-        exit(1);
-    }
-    printf("Dead sheet loaded and flipped.\n");
+    packSpriteSheet(player->deadSheet, 256, 256);
+    printf("Dead sheet loaded.\n");
 
     // Load health bar images
     player->healthBarBg = IMG_Load("assets/health/healthbar_bg.png");
@@ -174,6 +129,7 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->healthBarBg, SDL_SRCCOLORKEY, SDL_MapRGB(player->healthBarBg->format, 255, 0, 255));
+    packSpriteSheet(player->healthBarBg, player->healthBarBg->w, player->healthBarBg->h);
 
     player->healthBarGreen = IMG_Load("assets/health/healthbar_green.png");
     if (!player->healthBarGreen || player->healthBarGreen->w != 271 || player->healthBarGreen->h != 21) {
@@ -182,6 +138,7 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->healthBarGreen, SDL_SRCCOLORKEY, SDL_MapRGB(player->healthBarGreen->format, 255, 0, 255));
+    packSpriteSheet(player->healthBarGreen, player->healthBarGreen->w, player->healthBarGreen->h);
     printf("Health bar images loaded.\n");
 
     // Load kill icons
@@ -192,6 +149,7 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->killIcon1, SDL_SRCCOLORKEY, SDL_MapRGB(player->killIcon1->format, 255, 0, 255));
+    packSpriteSheet(player->killIcon1, player->killIcon1->w, player->killIcon1->h);
 
     player->killIcon2 = IMG_Load("assets/icons/kill_icon2.png");
     if (!player->killIcon2 || player->killIcon2->w != 88 || player->killIcon2->h != 88) {
@@ -200,6 +158,7 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->killIcon2, SDL_SRCCOLORKEY, SDL_MapRGB(player->killIcon2->format, 255, 0, 255));
+    packSpriteSheet(player->killIcon2, player->killIcon2->w, player->killIcon2->h);
 
     player->killIcon3 = IMG_Load("assets/icons/kill_icon3.png");
     if (!player->killIcon3 || player->killIcon3->w != 88 || player->killIcon3->h != 88) {
@@ -208,6 +167,7 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->killIcon3, SDL_SRCCOLORKEY, SDL_MapRGB(player->killIcon3->format, 255, 0, 255));
+    packSpriteSheet(player->killIcon3, player->killIcon3->w, player->killIcon3->h);
 
     player->killIcon4 = IMG_Load("assets/icons/kill_icon4.png");
     if (!player->killIcon4 || player->killIcon4->w != 88 || player->killIcon4->h != 88) {
@@ -216,6 +176,7 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->killIcon4, SDL_SRCCOLORKEY, SDL_MapRGB(player->killIcon4->format, 255, 0, 255));
+    packSpriteSheet(player->killIcon4, player->killIcon4->w, player->killIcon4->h);
     printf("Kill icons loaded.\n");
 
     // Load health item
@@ -226,6 +187,7 @@ void initPlayer(Player *player, SDL_Surface *screen) {
         exit(1);
     }
     SDL_SetColorKey(player->healthItem.image, SDL_SRCCOLORKEY, SDL_MapRGB(player->healthItem.image->format, 255, 0, 255));
+    packSpriteSheet(player->healthItem.image, player->healthItem.image->w, player->healthItem.image->h);
     printf("Health item loaded.\n");
 
     // Load bullet sheet with transparency fix
@@ -237,7 +199,7 @@ void initPlayer(Player *player, SDL_Surface *screen) {
     }
     Uint32 colorkey = SDL_MapRGB(player->bulletSheet->format, 255, 0, 255); // Magenta as transparent color
     SDL_SetColorKey(player->bulletSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-    SDL_Surface *optimized = SDL_DisplayFormatAlpha(player->bulletSheet);
+    SDL_Surface *optimized = keyedDisplayFormatAlpha(player->bulletSheet);
     if (!optimized) {
         fprintf(stderr, "SDL_DisplayFormatAlpha failed for bullet.png: %s\n", SDL_GetError());
         SDL_FreeSurface(player->bulletSheet);
@@ -245,15 +207,10 @@ void initPlayer(Player *player, SDL_Surface *screen) {
     }
     SDL_FreeSurface(player->bulletSheet);
     player->bulletSheet = optimized;
-    SDL_SetColorKey(player->bulletSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-    player->bulletSheetFlipped = flipHorizontally(player->bulletSheet);
-    if (!player->bulletSheetFlipped) {
-        fprintf(stderr, "Failed to flip bullet.png\n");
-        SDL_FreeSurface(player->bulletSheet);
-        exit(1);
-    }
-    SDL_SetColorKey(player->bulletSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-    printf("Bullet sheet loaded and flipped with transparency.\n");
+    // No SDL_RLEACCEL: leftward bullets are drawn by blitMirrored(), which reads the pixels directly
+    SDL_SetColorKey(player->bulletSheet, SDL_SRCCOLORKEY, colorkey);
+    packSpriteSheet(player->bulletSheet, 72, 72);
+    printf("Bullet sheet loaded with transparency.\n");
 
     // Load sound effects
     jumpSound = Mix_LoadWAV("assets/sounds/jump.wav");
@@ -516,7 +473,12 @@ void updatePlayer(Player *player, GAME *game) {
 
     // Handle bullet animation and movement
     if (player->bulletActive) {
+        int prevCenterX = player->bullet.x + player->bullet_w / 2;
         player->bullet.x += player->bulletDirection * 15;
+        int centerY = player->bullet.y + player->bullet_h / 2;
+        if (projectileHitsTerrain(game, prevCenterX, centerY, player->bullet.x + player->bullet_w / 2, centerY)) {
+            player->bulletActive = 0;
+        }
         static int bulletFrameDelay = 0;
         if (++bulletFrameDelay >= 4) {
             player->bulletFrame = (player->bulletFrame + 1) % 4;
@@ -608,30 +570,16 @@ void renderPlayer(Player *player, GAME *game) {
            player->state, player->facing, player->frame, player->position.x, player->position.y, player->world_x);
 
     SDL_Surface *sheet = NULL;
-    if (player->facing == LEFT) {
-        switch (player->state) {
-            case IDLE: sheet = player->idleSheetFlipped; break;
-            case WALK: sheet = player->walkSheetFlipped; break;
-            case RUN: sheet = player->runSheetFlipped; break;
-            case JUMP: sheet = player->jumpSheetFlipped; break;
-            case ATTACK_1: sheet = player->attack1SheetFlipped; break;
-            case SHOT: sheet = player->shotSheetFlipped; break;
-            case RECHARGE: sheet = player->rechargeSheetFlipped; break;
-            case HURT: sheet = player->hurtSheetFlipped; break;
-            case DEAD: sheet = player->deadSheetFlipped; break;
-        }
-    } else {
-        switch (player->state) {
-            case IDLE: sheet = player->idleSheet; break;
-            case WALK: sheet = player->walkSheet; break;
-            case RUN: sheet = player->runSheet; break;
-            case JUMP: sheet = player->jumpSheet; break;
-            case ATTACK_1: sheet = player->attack1Sheet; break;
-            case SHOT: sheet = player->shotSheet; break;
-            case RECHARGE: sheet = player->rechargeSheet; break;
-            case HURT: sheet = player->hurtSheet; break;
-            case DEAD: sheet = player->deadSheet; break;
-        }
+    switch (player->state) {
+        case IDLE: sheet = player->idleSheet; break;
+        case WALK: sheet = player->walkSheet; break;
+        case RUN: sheet = player->runSheet; break;
+        case JUMP: sheet = player->jumpSheet; break;
+        case ATTACK_1: sheet = player->attack1Sheet; break;
+        case SHOT: sheet = player->shotSheet; break;
+        case RECHARGE: sheet = player->rechargeSheet; break;
+        case HURT: sheet = player->hurtSheet; break;
+        case DEAD: sheet = player->deadSheet; break;
     }
 
     if (!sheet) {
@@ -646,13 +594,13 @@ void renderPlayer(Player *player, GAME *game) {
         return;
     }
     SDL_Rect destRect = {player->position.x, player->position.y, 256, 256};
-    if (SDL_BlitSurface(sheet, &srcRect, game->screen, &destRect) < 0) {
-        fprintf(stderr, "renderPlayer: SDL_BlitSurface failed for player sprite: %s\n", SDL_GetError());
+    if (blitSprite(sheet, &srcRect, game->screen, &destRect, player->facing == LEFT) < 0) {
+        fprintf(stderr, "renderPlayer: blitSprite failed for player sprite: %s\n", SDL_GetError());
         return;
     }
 
     if (player->bulletActive) {
-        SDL_Surface *bulletSheet = (player->bulletDirection < 0) ? player->bulletSheetFlipped : player->bulletSheet;
+        SDL_Surface *bulletSheet = player->bulletSheet;
         if (!bulletSheet) {
             fprintf(stderr, "renderPlayer: Bullet sheet is NULL\n");
             return;
@@ -664,8 +612,8 @@ void renderPlayer(Player *player, GAME *game) {
                     bulletSrcRect.x, bulletSrcRect.y, bulletSrcRect.w, bulletSrcRect.h, bulletSheet->w, bulletSheet->h);
             return;
         }
-        if (SDL_BlitSurface(bulletSheet, &bulletSrcRect, game->screen, &bulletDestRect) < 0) {
-            fprintf(stderr, "renderPlayer: SDL_BlitSurface failed for bullet: %s\n", SDL_GetError());
+        if (blitSprite(bulletSheet, &bulletSrcRect, game->screen, &bulletDestRect, player->bulletDirection < 0) < 0) {
+            fprintf(stderr, "renderPlayer: blitSprite failed for bullet: %s\n", SDL_GetError());
             return;
         }
     }
@@ -683,8 +631,8 @@ void renderPlayer(Player *player, GAME *game) {
             int startX = (SCREEN_WIDTH - iconWidth) / 2;
             int startY = 10;
             SDL_Rect destRect = {startX, startY, iconWidth, iconHeight};
-            if (SDL_BlitSurface(iconToDisplay, NULL, game->screen, &destRect) < 0) {
-                fprintf(stderr, "renderPlayer: SDL_BlitSurface failed for kill icon: %s\n", SDL_GetError());
+            if (blitSprite(iconToDisplay, NULL, game->screen, &destRect, 0) < 0) {
+                fprintf(stderr, "renderPlayer: blitSprite failed for kill icon: %s\n", SDL_GetError());
                 return;
             }
         }
@@ -700,41 +648,48 @@ void renderPlayer(Player *player, GAME *game) {
                                   player->healthItem.image->w, // Use actual width (48)
                                   player->healthItem.image->h  // Use actual height (48)
         };
-        if (SDL_BlitSurface(player->healthItem.image, NULL, game->screen, &healthDestRect) < 0) {
-            fprintf(stderr, "renderPlayer: SDL_BlitSurface failed for health item: %s\n", SDL_GetError());
+        if (blitSprite(player->healthItem.image, NULL, game->screen, &healthDestRect, 0) < 0) {
+            fprintf(stderr, "renderPlayer: blitSprite failed for health item: %s\n", SDL_GetError());
             return;
         }
     }
 }
 
 void freePlayer(Player *player) {
+    unpackSpriteSheet(player->idleSheet);
     if (player->idleSheet) SDL_FreeSurface(player->idleSheet);
-    if (player->idleSheetFlipped) SDL_FreeSurface(player->idleSheetFlipped);
+    unpackSpriteSheet(player->walkSheet);
     if (player->walkSheet) SDL_FreeSurface(player->walkSheet);
-    if (player->walkSheetFlipped) SDL_FreeSurface(player->walkSheetFlipped);
+    unpackSpriteSheet(player->runSheet);
     if (player->runSheet) SDL_FreeSurface(player->runSheet);
-    if (player->runSheetFlipped) SDL_FreeSurface(player->runSheetFlipped);
+    unpackSpriteSheet(player->jumpSheet);
     if (player->jumpSheet) SDL_FreeSurface(player->jumpSheet);
-    if (player->jumpSheetFlipped) SDL_FreeSurface(player->jumpSheetFlipped);
+    unpackSpriteSheet(player->attack1Sheet);
     if (player->attack1Sheet) SDL_FreeSurface(player->attack1Sheet);
-    if (player->attack1SheetFlipped) SDL_FreeSurface(player->attack1SheetFlipped);
+    unpackSpriteSheet(player->shotSheet);
     if (player->shotSheet) SDL_FreeSurface(player->shotSheet);
-    if (player->shotSheetFlipped) SDL_FreeSurface(player->shotSheetFlipped);
+    unpackSpriteSheet(player->rechargeSheet);
     if (player->rechargeSheet) SDL_FreeSurface(player->rechargeSheet);
-    if (player->rechargeSheetFlipped) SDL_FreeSurface(player->rechargeSheetFlipped);
+    unpackSpriteSheet(player->hurtSheet);
     if (player->hurtSheet) SDL_FreeSurface(player->hurtSheet);
-    if (player->hurtSheetFlipped) SDL_FreeSurface(player->hurtSheetFlipped);
+    unpackSpriteSheet(player->deadSheet);
     if (player->deadSheet) SDL_FreeSurface(player->deadSheet);
-    if (player->deadSheetFlipped) SDL_FreeSurface(player->deadSheetFlipped);
+    unpackSpriteSheet(player->healthBarBg);
     if (player->healthBarBg) SDL_FreeSurface(player->healthBarBg);
+    unpackSpriteSheet(player->healthBarGreen);
     if (player->healthBarGreen) SDL_FreeSurface(player->healthBarGreen);
+    unpackSpriteSheet(player->killIcon1);
     if (player->killIcon1) SDL_FreeSurface(player->killIcon1);
+    unpackSpriteSheet(player->killIcon2);
     if (player->killIcon2) SDL_FreeSurface(player->killIcon2);
+    unpackSpriteSheet(player->killIcon3);
     if (player->killIcon3) SDL_FreeSurface(player->killIcon3);
+    unpackSpriteSheet(player->killIcon4);
     if (player->killIcon4) SDL_FreeSurface(player->killIcon4);
+    unpackSpriteSheet(player->healthItem.image);
     if (player->healthItem.image) SDL_FreeSurface(player->healthItem.image);
+    unpackSpriteSheet(player->bulletSheet);
     if (player->bulletSheet) SDL_FreeSurface(player->bulletSheet);
-    if (player->bulletSheetFlipped) SDL_FreeSurface(player->bulletSheetFlipped);
 
     // Free sound effects
     if (jumpSound) {
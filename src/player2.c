@@ -3,11 +3,12 @@
 #include <SDL/SDL.h>
 #include <SDL/SDL_image.h>
 #include <SDL/SDL_ttf.h>
-#include <SDL/SDL_rotozoom.h>
 #include "game.h"
 #include "player2.h"
 #include "collision.h"
 #include "mouvement.h"
+#include "spritemask.h"
+#include "glyphatlas.h"
 
 void initPlayer2(Player2 *player, int x, int y, struct GAME *game) {
     SDL_Surface* loaded = IMG_Load("assets/player2.png");
@@ -16,13 +17,9 @@ void initPlayer2(Player2 *player, int x, int y, struct GAME *game) {
         exit(1);
     }
     player->spriteSheet = loaded;
-    player->spriteSheetFlipped = rotozoomSurfaceXY(loaded, 0, -1, 1, 0);
-    if (!player->spriteSheetFlipped) {
-        fprintf(stderr, "initPlayer2: Failed to create flipped sprite\n");
-        exit(1);
-    }
     SDL_SetColorKey(player->spriteSheet, SDL_SRCCOLORKEY, SDL_MapRGB(player->spriteSheet->format, 255, 0, 255));
-    SDL_SetColorKey(player->spriteSheetFlipped, SDL_SRCCOLORKEY, SDL_MapRGB(player->spriteSheetFlipped->format, 255, 0, 255));
+    registerSpriteMask(player->spriteSheet);
+    packSpriteSheet(player->spriteSheet, 192, 192);
 
     player->position.x = x;
     player->position.y = y;
@@ -154,29 +151,36 @@ void updatePlayer2(Player2 *player, struct GAME *game) {
 }
 
 void renderPlayer2(SDL_Surface *screen, Player2 *player) {
-    SDL_Surface* spriteToDisplay = player->lookingRight ? player->spriteSheet : player->spriteSheetFlipped;
     SDL_Rect frameToDisplay = player->frame;
     SDL_Rect destRect = {player->position.x, player->position.y, player->position.w, player->position.h};
 
+    // Facing left draws the frame's mirror image, which sits at the mirrored x in the flipped sheet
     if (!player->lookingRight) {
-        frameToDisplay.x = (spriteToDisplay->w - frameToDisplay.x) - frameToDisplay.w;
+        frameToDisplay.x = (player->spriteSheet->w - frameToDisplay.x) - frameToDisplay.w;
     }
-    SDL_BlitSurface(spriteToDisplay, &frameToDisplay, screen, &destRect);
+    blitSprite(player->spriteSheet, &frameToDisplay, screen, &destRect, !player->lookingRight);
 }
 
 void freePlayer2(Player2 *player) {
+    releaseSpriteMask(player->spriteSheet);
+    unpackSpriteSheet(player->spriteSheet);
     if (player->spriteSheet) SDL_FreeSurface(player->spriteSheet);
-    if (player->spriteSheetFlipped) SDL_FreeSurface(player->spriteSheetFlipped);
 }
 
 void initCoins(Coin coins[], int count, int useDoubleBackground) {
-    for (int i = 0; i < count; i++) {
-        coins[i].sprite = IMG_Load("assets/coin.png");
-        if (!coins[i].sprite) {
-            fprintf(stderr, "initCoins: Failed to load coin %d: %s\n", i, IMG_GetError());
+    // Every coin draws the same image, so they share one packed copy
+    static SDL_Surface *coinSprite = NULL;
+    if (!coinSprite) {
+        coinSprite = IMG_Load("assets/coin.png");
+        if (!coinSprite) {
+            fprintf(stderr, "initCoins: Failed to load coin: %s\n", IMG_GetError());
             exit(1);
         }
-        SDL_SetColorKey(coins[i].sprite, SDL_SRCCOLORKEY, SDL_MapRGB(coins[i].sprite->format, 255, 0, 255));
+        SDL_SetColorKey(coinSprite, SDL_SRCCOLORKEY, SDL_MapRGB(coinSprite->format, 255, 0, 255));
+        packSpriteSheet(coinSprite, coinSprite->w, coinSprite->h);
+    }
+    for (int i = 0; i < count; i++) {
+        coins[i].sprite = coinSprite;
         coins[i].x = 220 + (i % 7) * 70;
         coins[i].y = (i < 7) ? 500 : (useDoubleBackground ? 110 : 500);
         coins[i].position.x = coins[i].x;
@@ -191,7 +195,7 @@ void renderCoins(SDL_Surface *screen, Coin coins[], int count) {
     for (int i = 0; i < count; i++) {
         if (coins[i].active) {
             SDL_Rect destRect = {coins[i].position.x - screen->clip_rect.x, coins[i].y, COIN_WIDTH, COIN_HEIGHT};
-            SDL_BlitSurface(coins[i].sprite, NULL, screen, &destRect);
+            blitSprite(coins[i].sprite, NULL, screen, &destRect, 0);
         }
     }
 }
@@ -200,12 +204,7 @@ void displayScoreLivesPlayer2(SDL_Surface *screen, Player2 *player, int playerNu
     char texte[50];
     SDL_Color couleur = {255, 255, 255, 0};
     sprintf(texte, "Joueur %d - Vies: %d Score: %d", playerNum, player->lives, player->score);
-    SDL_Surface *texteSurface = TTF_RenderText_Solid(font, texte, couleur);
-    if (!texteSurface) {
-        fprintf(stderr, "displayScoreLivesPlayer2: TTF_RenderText_Solid failed: %s\n", TTF_GetError());
-        return;
+    if (blitText(screen, font, texte, couleur, 10, playerNum * 30 + 20) < 0) {
+        fprintf(stderr, "displayScoreLivesPlayer2: blitText failed: %s\n", SDL_GetError());
     }
-    SDL_Rect posTexte = {10, playerNum * 30 + 20, 0, 0};
-    SDL_BlitSurface(texteSurface, NULL, screen, &posTexte);
-    SDL_FreeSurface(texteSurface);
 }
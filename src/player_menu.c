@@ -1,5 +1,7 @@
 #include "player_menu.h"
 #include "sound.h"
+#include "dirtyrect.h"
+#include "textcache.h"
 #include <SDL/SDL_image.h>
 #include <SDL/SDL_ttf.h>
 #include <stdio.h>
@@ -171,16 +173,64 @@ int PlayerMenu_HandleEvents(SDL_Event *event) {
     return PLAYER_MENU_CONTINUE; 
 }
 
-void PlayerMenu_Render(SDL_Surface *screen) {
+// Puts the background back under one button, over the larger of its two images, and draws it
+// unless it is hidden
+static void redrawPlayerButton(SDL_Surface *screen, PlayerButton *button) {
+    SDL_Rect area = {button->position.x, button->position.y,
+                     button->normal->w > button->hover->w ? button->normal->w : button->hover->w,
+                     button->normal->h > button->hover->h ? button->normal->h : button->hover->h};
+    SDL_Rect dest = area;
+    SDL_FillRect(screen, &dest, SDL_MapRGB(screen->format, 0, 0, 0));
+    dest = area;
+    SDL_BlitSurface(playerBackground, &area, screen, &dest);
+    if (button->state != BTN_HIDDEN) {
+        dest = area;
+        SDL_BlitSurface(button->state == BTN_HOVER ? button->hover : button->normal, NULL, screen, &dest);
+    }
+    markDirty(area);
+}
+
+// Repaints only the buttons whose state changed since the last frame; returns how many did
+static int redrawChangedButtons(SDL_Surface *screen, PlayerButton buttons[], int lastStates[], int count) {
+    int changed = 0;
+    for (int i = 0; i < count; i++) {
+        if (buttons[i].state == lastStates[i]) continue;
+        redrawPlayerButton(screen, &buttons[i]);
+        lastStates[i] = buttons[i].state;
+        changed++;
+    }
+    return changed;
+}
+
+int PlayerMenu_Render(SDL_Surface *screen) {
+    static int lastMenuState = -1;
+    static int lastMainStates[NUM_PLAYER_BUTTONS_MAIN];
+    static int lastAvatarStates[NUM_PLAYER_BUTTONS_AVATAR];
+    int full = consumeFullRedraw() || playerMenuState != lastMenuState;
+
+    if (!full) {
+        if (playerMenuState == PLAYER_MENU_MAIN) {
+            return redrawChangedButtons(screen, mainButtons, lastMainStates, NUM_PLAYER_BUTTONS_MAIN) > 0;
+        }
+        return redrawChangedButtons(screen, avatarButtons, lastAvatarStates, NUM_PLAYER_BUTTONS_AVATAR) > 0;
+    }
+    lastMenuState = playerMenuState;
+    for (int i = 0; i < NUM_PLAYER_BUTTONS_MAIN; i++) lastMainStates[i] = mainButtons[i].state;
+    for (int i = 0; i < NUM_PLAYER_BUTTONS_AVATAR; i++) lastAvatarStates[i] = avatarButtons[i].state;
+    // The whole menu is repainted, so present it whole too
+    invalidateScreen();
+    consumeFullRedraw();
+
     SDL_FillRect(screen, NULL, SDL_MapRGB(screen->format, 0, 0, 0));
     SDL_BlitSurface(playerBackground, NULL, screen, NULL);
 
     if (playerMenuState == PLAYER_MENU_MAIN) {
         SDL_Color textColor = {255, 255, 255, 0}; 
-        SDL_Surface *textSurface = TTF_RenderText_Solid(font, "Choisissez votre mode de jeu", textColor);
-        SDL_Rect textPosition = {screen->w / 2 - textSurface->w / 2, 200, 0, 0};
-        SDL_BlitSurface(textSurface, NULL, screen, &textPosition);
-        SDL_FreeSurface(textSurface);
+        SDL_Surface *textSurface = cachedText(font, "Choisissez votre mode de jeu", textColor, TEXT_SOLID);
+        if (textSurface) {
+            SDL_Rect textPosition = {screen->w / 2 - textSurface->w / 2, 200, 0, 0};
+            SDL_BlitSurface(textSurface, NULL, screen, &textPosition);
+        }
 
         for (int i = 0; i < NUM_PLAYER_BUTTONS_MAIN; i++) {
             SDL_Surface *buttonSurface = mainButtons[i].state == BTN_HOVER ? mainButtons[i].hover : mainButtons[i].normal;
@@ -188,10 +238,11 @@ void PlayerMenu_Render(SDL_Surface *screen) {
         }
     } else if (playerMenuState == PLAYER_MENU_AVATAR) {
         SDL_Color textColor = {0, 0, 0, 0}; 
-        SDL_Surface *textSurface = TTF_RenderText_Solid(font, "Choisissez votre avatar ou input", textColor);
-        SDL_Rect textPosition = {screen->w / 2 - textSurface->w / 2, 100, 0, 0};
-        SDL_BlitSurface(textSurface, NULL, screen, &textPosition);
-        SDL_FreeSurface(textSurface);
+        SDL_Surface *textSurface = cachedText(font, "Choisissez votre avatar ou input", textColor, TEXT_SOLID);
+        if (textSurface) {
+            SDL_Rect textPosition = {screen->w / 2 - textSurface->w / 2, 100, 0, 0};
+            SDL_BlitSurface(textSurface, NULL, screen, &textPosition);
+        }
 
         for (int i = 0; i < NUM_PLAYER_BUTTONS_AVATAR; i++) {
             if (avatarButtons[i].state == BTN_HIDDEN) {
@@ -201,6 +252,7 @@ void PlayerMenu_Render(SDL_Surface *screen) {
             SDL_BlitSurface(buttonSurface, NULL, screen, &avatarButtons[i].position);
         }
     }
+    return 1;
 }
 
 void PlayerMenu_Cleanup() {
@@ -215,6 +267,9 @@ void PlayerMenu_Cleanup() {
     }
 
     if (playerBackground) SDL_FreeSurface(playerBackground);
-    if (font) TTF_CloseFont(font);
+    if (font) {
+        releaseTextFont(font);
+        TTF_CloseFont(font);
+    }
     if (hoverSound) Mix_FreeChunk(hoverSound);
 }
@@ -1,4 +1,7 @@
 #include "portal.h"
+#include "dirtyrect.h"
+#include "spriteblit.h"
+#include "atlas.h"
 #include <SDL/SDL_image.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -16,6 +19,7 @@ void initPortal(Portal* portal, int x, int y) {
             exit(1);
         }
         SDL_SetColorKey(portal->frames[i], SDL_SRCCOLORKEY, SDL_MapRGB(portal->frames[i]->format, 255, 0, 255));
+        packSpriteSheet(portal->frames[i], portal->frames[i]->w, portal->frames[i]->h);
     }
     portal->position.x = x;
     portal->position.y = y;
@@ -38,12 +42,13 @@ void updatePortal(Portal* portal) {
 void renderPortal(SDL_Surface* screen, Portal* portal, int scroll_x) {
     if (!portal->active) return;
     SDL_Rect adjustedPos = {portal->position.x - scroll_x, portal->position.y, portal->position.w, portal->position.h};
-    SDL_BlitSurface(portal->frames[portal->frame], NULL, screen, &adjustedPos);
+    blitSprite(portal->frames[portal->frame], NULL, screen, &adjustedPos, 0);
 }
 
 void freePortal(Portal* portal) {
     for (int i = 0; i < 7; i++) {
         if (portal->frames[i]) {
+            unpackSpriteSheet(portal->frames[i]);
             SDL_FreeSurface(portal->frames[i]);
             portal->frames[i] = NULL;
         }
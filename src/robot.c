@@ -23,21 +23,13 @@
 
 // Global sprite sheets for robot animations
 SDL_Surface* robot_idleSheet = NULL;
-SDL_Surface* robot_idleSheetFlipped = NULL;
 SDL_Surface* robot_walkSheet = NULL;
-SDL_Surface* robot_walkSheetFlipped = NULL;
 SDL_Surface* robot_attack1Sheet = NULL;
-SDL_Surface* robot_attack1SheetFlipped = NULL;
 SDL_Surface* robot_attack3Sheet = NULL;
-SDL_Surface* robot_attack3SheetFlipped = NULL;
 SDL_Surface* robot_specialSheet = NULL;
-SDL_Surface* robot_specialSheetFlipped = NULL;
 SDL_Surface* robot_hurtSheet = NULL;
-SDL_Surface* robot_hurtSheetFlipped = NULL;
 SDL_Surface* robot_deathSheet = NULL;
-SDL_Surface* robot_deathSheetFlipped = NULL;
 SDL_Surface* robot_projectileSheet = NULL;
-SDL_Surface* robot_projectileSheetFlipped = NULL;
 
 void initRobot(Robot* robot, int x, int y) {
     if (!robot) {
@@ -54,8 +46,8 @@ void initRobot(Robot* robot, int x, int y) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(robot_idleSheet->format, 255, 255, 255);
-        SDL_SetColorKey(robot_idleSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface* optimized = SDL_DisplayFormatAlpha(robot_idleSheet);
+        SDL_SetColorKey(robot_idleSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface* optimized = keyedDisplayFormatAlpha(robot_idleSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for idle_resized.png: %s\n", SDL_GetError());
             SDL_FreeSurface(robot_idleSheet);
@@ -63,14 +55,7 @@ void initRobot(Robot* robot, int x, int y) {
         }
         SDL_FreeSurface(robot_idleSheet);
         robot_idleSheet = optimized;
-        robot_idleSheetFlipped = flipHorizontally(robot_idleSheet);
-        if (!robot_idleSheetFlipped) {
-            fprintf(stderr, "Failed to flip idle_resized.png\n");
-            SDL_FreeSurface(robot_idleSheet);
-            robot_idleSheet = NULL;
-            exit(1);
-        }
-        SDL_SetColorKey(robot_idleSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(robot_idleSheet, 256, 256);
     }
     if (!robot_walkSheet) {
         robot_walkSheet = IMG_Load("assets/enemies/robot/walk_resized.png"); // 1536x256, 6 frames
@@ -79,8 +64,8 @@ void initRobot(Robot* robot, int x, int y) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(robot_walkSheet->format, 255, 255, 255);
-        SDL_SetColorKey(robot_walkSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface* optimized = SDL_DisplayFormatAlpha(robot_walkSheet);
+        SDL_SetColorKey(robot_walkSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface* optimized = keyedDisplayFormatAlpha(robot_walkSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for walk_resized.png: %s\n", SDL_GetError());
             SDL_FreeSurface(robot_walkSheet);
@@ -88,14 +73,7 @@ void initRobot(Robot* robot, int x, int y) {
         }
         SDL_FreeSurface(robot_walkSheet);
         robot_walkSheet = optimized;
-        robot_walkSheetFlipped = flipHorizontally(robot_walkSheet);
-        if (!robot_walkSheetFlipped) {
-            fprintf(stderr, "Failed to flip walk_resized.png\n");
-            SDL_FreeSurface(robot_walkSheet);
-            robot_walkSheet = NULL;
-            exit(1);
-        }
-        SDL_SetColorKey(robot_walkSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(robot_walkSheet, 256, 256);
     }
     if (!robot_attack1Sheet) {
         robot_attack1Sheet = IMG_Load("assets/enemies/robot/attack1_resized.png"); // 1536x256, 6 frames
@@ -104,8 +82,8 @@ void initRobot(Robot* robot, int x, int y) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(robot_attack1Sheet->format, 255, 255, 255);
-        SDL_SetColorKey(robot_attack1Sheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface* optimized = SDL_DisplayFormatAlpha(robot_attack1Sheet);
+        SDL_SetColorKey(robot_attack1Sheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface* optimized = keyedDisplayFormatAlpha(robot_attack1Sheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for attack1_resized.png: %s\n", SDL_GetError());
             SDL_FreeSurface(robot_attack1Sheet);
@@ -113,14 +91,7 @@ void initRobot(Robot* robot, int x, int y) {
         }
         SDL_FreeSurface(robot_attack1Sheet);
         robot_attack1Sheet = optimized;
-        robot_attack1SheetFlipped = flipHorizontally(robot_attack1Sheet);
-        if (!robot_attack1SheetFlipped) {
-            fprintf(stderr, "Failed to flip attack1_resized.png\n");
-            SDL_FreeSurface(robot_attack1Sheet);
-            robot_attack1Sheet = NULL;
-            exit(1);
-        }
-        SDL_SetColorKey(robot_attack1SheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(robot_attack1Sheet, 256, 256);
     }
     if (!robot_attack3Sheet) {
         robot_attack3Sheet = IMG_Load("assets/enemies/robot/attack3_resized.png"); // 1536x256, 6 frames
@@ -129,8 +100,8 @@ void initRobot(Robot* robot, int x, int y) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(robot_attack3Sheet->format, 255, 255, 255);
-        SDL_SetColorKey(robot_attack3Sheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface* optimized = SDL_DisplayFormatAlpha(robot_attack3Sheet);
+        SDL_SetColorKey(robot_attack3Sheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface* optimized = keyedDisplayFormatAlpha(robot_attack3Sheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for attack3_resized.png: %s\n", SDL_GetError());
             SDL_FreeSurface(robot_attack3Sheet);
@@ -138,14 +109,7 @@ void initRobot(Robot* robot, int x, int y) {
         }
         SDL_FreeSurface(robot_attack3Sheet);
         robot_attack3Sheet = optimized;
-        robot_attack3SheetFlipped = flipHorizontally(robot_attack3Sheet);
-        if (!robot_attack3SheetFlipped) {
-            fprintf(stderr, "Failed to flip attack3_resized.png\n");
-            SDL_FreeSurface(robot_attack3Sheet);
-            robot_attack3Sheet = NULL;
-            exit(1);
-        }
-        SDL_SetColorKey(robot_attack3SheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(robot_attack3Sheet, 256, 256);
     }
     if (!robot_specialSheet) {
         robot_specialSheet = IMG_Load("assets/enemies/robot/special_resized.png"); // 1536x256, 6 frames
@@ -154,8 +118,8 @@ void initRobot(Robot* robot, int x, int y) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(robot_specialSheet->format, 255, 255, 255);
-        SDL_SetColorKey(robot_specialSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface* optimized = SDL_DisplayFormatAlpha(robot_specialSheet);
+        SDL_SetColorKey(robot_specialSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface* optimized = keyedDisplayFormatAlpha(robot_specialSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for special_resized.png: %s\n", SDL_GetError());
             SDL_FreeSurface(robot_specialSheet);
@@ -163,14 +127,7 @@ void initRobot(Robot* robot, int x, int y) {
         }
         SDL_FreeSurface(robot_specialSheet);
         robot_specialSheet = optimized;
-        robot_specialSheetFlipped = flipHorizontally(robot_specialSheet);
-        if (!robot_specialSheetFlipped) {
-            fprintf(stderr, "Failed to flip special_resized.png\n");
-            SDL_FreeSurface(robot_specialSheet);
-            robot_specialSheet = NULL;
-            exit(1);
-        }
-        SDL_SetColorKey(robot_specialSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(robot_specialSheet, 256, 256);
     }
     if (!robot_hurtSheet) {
         robot_hurtSheet = IMG_Load("assets/enemies/robot/hurt_resized.png"); // 512x256, 2 frames
@@ -179,8 +136,8 @@ void initRobot(Robot* robot, int x, int y) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(robot_hurtSheet->format, 255, 255, 255);
-        SDL_SetColorKey(robot_hurtSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface* optimized = SDL_DisplayFormatAlpha(robot_hurtSheet);
+        SDL_SetColorKey(robot_hurtSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface* optimized = keyedDisplayFormatAlpha(robot_hurtSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for hurt_resized.png: %s\n", SDL_GetError());
             SDL_FreeSurface(robot_hurtSheet);
@@ -188,14 +145,7 @@ void initRobot(Robot* robot, int x, int y) {
         }
         SDL_FreeSurface(robot_hurtSheet);
         robot_hurtSheet = optimized;
-        robot_hurtSheetFlipped = flipHorizontally(robot_hurtSheet);
-        if (!robot_hurtSheetFlipped) {
-            fprintf(stderr, "Failed to flip hurt_resized.png\n");
-            SDL_FreeSurface(robot_hurtSheet);
-            robot_hurtSheet = NULL;
-            exit(1);
-        }
-        SDL_SetColorKey(robot_hurtSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(robot_hurtSheet, 256, 256);
     }
     if (!robot_deathSheet) {
         robot_deathSheet = IMG_Load("assets/enemies/robot/death_resized.png"); // 1536x256, 6 frames
@@ -204,8 +154,8 @@ void initRobot(Robot* robot, int x, int y) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(robot_deathSheet->format, 255, 255, 255);
-        SDL_SetColorKey(robot_deathSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface* optimized = SDL_DisplayFormatAlpha(robot_deathSheet);
+        SDL_SetColorKey(robot_deathSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface* optimized = keyedDisplayFormatAlpha(robot_deathSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for death_resized.png: %s\n", SDL_GetError());
             SDL_FreeSurface(robot_deathSheet);
@@ -213,14 +163,7 @@ void initRobot(Robot* robot, int x, int y) {
         }
         SDL_FreeSurface(robot_deathSheet);
         robot_deathSheet = optimized;
-        robot_deathSheetFlipped = flipHorizontally(robot_deathSheet);
-        if (!robot_deathSheetFlipped) {
-            fprintf(stderr, "Failed to flip death_resized.png\n");
-            SDL_FreeSurface(robot_deathSheet);
-            robot_deathSheet = NULL;
-            exit(1);
-        }
-        SDL_SetColorKey(robot_deathSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(robot_deathSheet, 256, 256);
     }
     if (!robot_projectileSheet) {
         robot_projectileSheet = IMG_Load("assets/enemies/robot/projectile_resized.png"); // 256x256, 1 frame
@@ -229,8 +172,8 @@ void initRobot(Robot* robot, int x, int y) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(robot_projectileSheet->format, 255, 255, 255);
-        SDL_SetColorKey(robot_projectileSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface* optimized = SDL_DisplayFormatAlpha(robot_projectileSheet);
+        SDL_SetColorKey(robot_projectileSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface* optimized = keyedDisplayFormatAlpha(robot_projectileSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for projectile_resized.png: %s\n", SDL_GetError());
             SDL_FreeSurface(robot_projectileSheet);
@@ -238,14 +181,7 @@ void initRobot(Robot* robot, int x, int y) {
         }
         SDL_FreeSurface(robot_projectileSheet);
         robot_projectileSheet = optimized;
-        robot_projectileSheetFlipped = flipHorizontally(robot_projectileSheet);
-        if (!robot_projectileSheetFlipped) {
-            fprintf(stderr, "Failed to flip projectile_resized.png\n");
-            SDL_FreeSurface(robot_projectileSheet);
-            robot_projectileSheet = NULL;
-            exit(1);
-        }
-        SDL_SetColorKey(robot_projectileSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(robot_projectileSheet, 256, 256);
     }
 
     // Initialize robot attributes
@@ -271,6 +207,10 @@ void initRobot(Robot* robot, int x, int y) {
     robot->projectileDirection = 0;
     robot->invulnerabilityTimer = 0;
     robot->active = 1;
+    robot->nav.timer = 0;
+    robot->nav.mode = NAV_AGENT_DIRECT;
+    robot->seesPlayer = 0;
+    robot->losTimer = 0;
     robot->yVelocity = 0.0f;
     robot->onGround = 0;
     robot->frameDelay = 0;
@@ -300,8 +240,7 @@ void updateRobot(Robot* robot, SDL_Rect playerPos, int* playerHealth, int player
         return;
     }
 
-    // Apply gravity and ensure grounding
-    robot->onGround = onGroundEntity(game, &robot->position, robot->world_x);
+    // Apply gravity and ensure grounding (onGround comes from onGroundBatch())
     if (!robot->onGround) {
         robot->yVelocity += GRAVITY;
         if (robot->yVelocity > MAX_FALL_SPEED) robot->yVelocity = MAX_FALL_SPEED;
@@ -309,7 +248,8 @@ void updateRobot(Robot* robot, SDL_Rect playerPos, int* playerHealth, int player
         robot->yVelocity = 0.0f;
         placeRobotOnGround(game, robot);
     }
-    robot->position.y += (int)robot->yVelocity;
+    robot->position.y += sweepMove(game, robot->world_x, robot->position.w,
+                                   robot->position.y + robot->position.h, (int)robot->yVelocity);
     if (robot->position.y < 0) {
         robot->position.y = 0;
         robot->yVelocity = 0.0f;
@@ -343,6 +283,12 @@ void updateRobot(Robot* robot, SDL_Rect playerPos, int* playerHealth, int player
     int dy = (playerPos.y + playerPos.h / 2) - (robot->position.y + robot->position.h / 2);
     int distance = (int)sqrt(dx * dx + dy * dy);
     robot->facingLeft = dx < 0 ? 1 : 0;
+    if (--robot->losTimer <= 0) {
+        robot->losTimer = LOS_CHECK_FRAMES;
+        robot->seesPlayer = hasLineOfSight(game, robot->world_x + robot->position.w / 2,
+                                           robot->position.y + robot->position.h / 2,
+                                           playerWorldX + playerPos.w / 2, playerPos.y + playerPos.h / 2);
+    }
 
     // State machine
     if (robot->state != ROBOT_HURT && robot->state != ROBOT_DEAD && robot->stateCooldown <= 0) {
@@ -367,7 +313,7 @@ void updateRobot(Robot* robot, SDL_Rect playerPos, int* playerHealth, int player
                 robot->frame = 0;
                 robot->stateCooldown = FRAME_DELAY;
             }
-        } else if (distance < robot->fireZone && robot->bullets > 0 && robot->damageCooldown <= 0) {
+        } else if (distance < robot->fireZone && robot->bullets > 0 && robot->damageCooldown <= 0 && robot->seesPlayer) {
             robot->state = ROBOT_ATTACK1;
             robot->yVelocity = 0.0f;
             if (robot->frame >= robot->totalFrames - 1) {
@@ -406,11 +352,17 @@ void updateRobot(Robot* robot, SDL_Rect playerPos, int* playerHealth, int player
             robot->state = ROBOT_WALKING;
             robot->yVelocity = 0.0f;
             float speed = MOVE_SPEED * (1.0f + (robot->activationZone - distance) / (float)robot->activationZone);
-            robot->world_x += (dx > 0 ? speed : -speed);
+            robot->world_x += speed * chaseDirection(game, &robot->nav, robot->world_x, robot->position.w,
+                                                     robot->position.y + robot->position.h,
+                                                     playerWorldX, playerPos.y + playerPos.h);
             robot->position.x = robot->world_x - game->background.scroll_x;
         } else {
             robot->state = ROBOT_WALKING;
             robot->yVelocity = 0.0f;
+            if (patrolBlocked(game, robot->world_x, robot->position.w, robot->position.y + robot->position.h,
+                              robot->patrolDirection)) {
+                robot->patrolDirection = -robot->patrolDirection;
+            }
             robot->world_x += robot->patrolDirection * PATROL_SPEED;
             robot->position.x = robot->world_x - game->background.scroll_x;
             if (--robot->patrolTimer <= 0) {
@@ -434,10 +386,14 @@ void updateRobot(Robot* robot, SDL_Rect playerPos, int* playerHealth, int player
 
     // Update projectile
     if (robot->projectileActive) {
+        int prevCenterX = robot->projectilePosition.x + robot->projectilePosition.w / 2;
         robot->projectilePosition.x += robot->projectileDirection * 5;
+        int centerY = robot->projectilePosition.y + robot->projectilePosition.h / 2;
         SDL_Rect projWorldRect = {robot->projectilePosition.x, robot->projectilePosition.y, robot->projectilePosition.w, robot->projectilePosition.h};
         SDL_Rect playerWorldRect = {playerWorldX, playerPos.y, playerPos.w, playerPos.h};
-        if (rectIntersect(&projWorldRect, &playerWorldRect)) {
+        if (projectileHitsTerrain(game, prevCenterX, centerY, robot->projectilePosition.x + robot->projectilePosition.w / 2, centerY)) {
+            robot->projectileActive = 0;
+        } else if (rectIntersect(&projWorldRect, &playerWorldRect)) {
             *playerHealth -= 10;
             if (*playerHealth <= 0) {
                 game->player.state = DEAD;
@@ -452,7 +408,8 @@ void updateRobot(Robot* robot, SDL_Rect playerPos, int* playerHealth, int player
     }
 
     // Player attacks robot
-    if (game->player.state == ATTACK_1 && robot->invulnerabilityTimer <= 0) {
+    if (game->player.state == ATTACK_1 && robot->invulnerabilityTimer <= 0 &&
+        (colliderContacts(&game->broadphase, COLLIDER_ROBOT, (int)(robot - game->robots)) & CONTACT_PLAYER)) {
         SDL_Rect attackRect = {
             game->player.world_x + (game->player.facing == RIGHT ? 50 : -50),
             game->player.position.y, 100, 100
@@ -466,7 +423,8 @@ void updateRobot(Robot* robot, SDL_Rect playerPos, int* playerHealth, int player
             LOG("Robot hit by player attack: health=%d\n", robot->health);
         }
     }
-    if (game->player.bulletActive && robot->invulnerabilityTimer <= 0) {
+    if (game->player.bulletActive && robot->invulnerabilityTimer <= 0 &&
+        (colliderContacts(&game->broadphase, COLLIDER_ROBOT, (int)(robot - game->robots)) & CONTACT_BULLET)) {
         SDL_Rect bulletRect = {game->player.bullet.x, game->player.bullet.y, game->player.bullet_w, game->player.bullet_h};
         SDL_Rect robotWorldRect = {robot->world_x, robot->position.y, robot->position.w, robot->position.h};
         if (rectIntersect(&bulletRect, &robotWorldRect)) {
@@ -516,24 +474,16 @@ void renderRobot(SDL_Surface* screen, Robot* robot, int scroll_x) {
         return;
     }
 
-    SDL_Surface* sheet = robot->facingLeft ?
-        (robot->state == ROBOT_IDLE ? robot_idleSheetFlipped :
-         robot->state == ROBOT_WALKING ? robot_walkSheetFlipped :
-         robot->state == ROBOT_ATTACK1 ? robot_attack1SheetFlipped :
-         robot->state == ROBOT_ATTACK3 ? robot_attack3SheetFlipped :
-         robot->state == ROBOT_SPECIAL ? robot_specialSheetFlipped :
-         robot->state == ROBOT_HURT ? robot_hurtSheetFlipped :
-         robot->state == ROBOT_DEAD ? robot_deathSheetFlipped : robot_idleSheetFlipped) :
-        (robot->state == ROBOT_IDLE ? robot_idleSheet :
-         robot->state == ROBOT_WALKING ? robot_walkSheet :
-         robot->state == ROBOT_ATTACK1 ? robot_attack1Sheet :
-         robot->state == ROBOT_ATTACK3 ? robot_attack3Sheet :
-         robot->state == ROBOT_SPECIAL ? robot_specialSheet :
-         robot->state == ROBOT_HURT ? robot_hurtSheet :
-         robot->state == ROBOT_DEAD ? robot_deathSheet : robot_idleSheet);
+    SDL_Surface* sheet = robot->state == ROBOT_IDLE ? robot_idleSheet :
+                         robot->state == ROBOT_WALKING ? robot_walkSheet :
+                         robot->state == ROBOT_ATTACK1 ? robot_attack1Sheet :
+                         robot->state == ROBOT_ATTACK3 ? robot_attack3Sheet :
+                         robot->state == ROBOT_SPECIAL ? robot_specialSheet :
+                         robot->state == ROBOT_HURT ? robot_hurtSheet :
+                         robot->state == ROBOT_DEAD ? robot_deathSheet : robot_idleSheet;
 
     if (!sheet) {
-        sheet = robot->facingLeft ? robot_idleSheetFlipped : robot_idleSheet;
+        sheet = robot_idleSheet;
         LOG("renderRobot: Fallback to idle sheet for state=%d\n", robot->state);
     }
 
@@ -545,22 +495,21 @@ void renderRobot(SDL_Surface* screen, Robot* robot, int scroll_x) {
             robot->state, robot->frame, robot->totalFrames);
     }
     SDL_Rect destRect = {robot->position.x, robot->position.y, 256, 256};
-    SDL_BlitSurface(sheet, &srcRect, screen, &destRect);
+    blitSprite(sheet, &srcRect, screen, &destRect, robot->facingLeft);
 
     // Render projectile
     if (robot->projectileActive) {
-        SDL_Surface* projSheet = robot->projectileDirection < 0 ? robot_projectileSheetFlipped : robot_projectileSheet;
         SDL_Rect projSrcRect = {0, 0, 256, 256};
         SDL_Rect projDestRect = {robot->projectilePosition.x - scroll_x, robot->projectilePosition.y, 256, 256};
-        SDL_BlitSurface(projSheet, &projSrcRect, screen, &projDestRect);
+        blitSprite(robot_projectileSheet, &projSrcRect, screen, &projDestRect, robot->projectileDirection < 0);
     }
 
     // Render health bar, matching soldier.c and soldier2.c
     if (robot->health > 0 && robot->state != ROBOT_DEAD) {
         SDL_Rect healthBarBg = {robot->position.x, robot->position.y - 20, 50, 5};
-        SDL_FillRect(screen, &healthBarBg, SDL_MapRGB(screen->format, 255, 0, 0));
+        trackedFill(screen, &healthBarBg, SDL_MapRGB(screen->format, 255, 0, 0));
         SDL_Rect healthBar = {robot->position.x, robot->position.y - 20, (50 * robot->health) / robot->maxHealth, 5};
-        SDL_FillRect(screen, &healthBar, SDL_MapRGB(screen->format, 0, 255, 0));
+        trackedFill(screen, &healthBar, SDL_MapRGB(screen->format, 0, 255, 0));
     }
 
     LOG("Robot rendered: x=%d, y=%d, state=%d, frame=%d, totalFrames=%d, active=%d\n",
@@ -579,13 +528,12 @@ void freeRobot(Robot* robot) {
 void freeRobotSprites(void) {
     LOG("Freeing robot sprites...\n");
     SDL_Surface* sheets[] = {
-        robot_idleSheet, robot_idleSheetFlipped, robot_walkSheet, robot_walkSheetFlipped,
-        robot_attack1Sheet, robot_attack1SheetFlipped, robot_attack3Sheet, robot_attack3SheetFlipped,
-        robot_specialSheet, robot_specialSheetFlipped, robot_hurtSheet, robot_hurtSheetFlipped,
-        robot_deathSheet, robot_deathSheetFlipped, robot_projectileSheet, robot_projectileSheetFlipped
+        robot_idleSheet, robot_walkSheet, robot_attack1Sheet, robot_attack3Sheet,
+        robot_specialSheet, robot_hurtSheet, robot_deathSheet, robot_projectileSheet
     };
-    for (int i = 0; i < 16; i++) {
+    for (int i = 0; i < 8; i++) {
         if (sheets[i]) {
+            unpackSpriteSheet(sheets[i]);
             SDL_FreeSurface(sheets[i]);
             sheets[i] = NULL;
         }
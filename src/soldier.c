@@ -14,27 +14,16 @@
 
 
 static SDL_Surface *idleSheet = NULL;
-static SDL_Surface *idleSheetFlipped = NULL;
 static SDL_Surface *walkSheet = NULL;
-static SDL_Surface *walkSheetFlipped = NULL;
 static SDL_Surface *attackSheet = NULL;
-static SDL_Surface *attackSheetFlipped = NULL;
 static SDL_Surface *shotSheet = NULL;
-static SDL_Surface *shotSheetFlipped = NULL;
 static SDL_Surface *shot2Sheet = NULL;
-static SDL_Surface *shot2SheetFlipped = NULL;
 static SDL_Surface *grenadeSheet = NULL;
-static SDL_Surface *grenadeSheetFlipped = NULL;
 static SDL_Surface *rechargeSheet = NULL;
-static SDL_Surface *rechargeSheetFlipped = NULL;
 static SDL_Surface *throwSheet = NULL;
-static SDL_Surface *throwSheetFlipped = NULL;
 static SDL_Surface *hurtSheet = NULL;
-static SDL_Surface *hurtSheetFlipped = NULL;
 static SDL_Surface *deadSheet = NULL;
-static SDL_Surface *deadSheetFlipped = NULL;
 static SDL_Surface *explosionSheet = NULL;
-static SDL_Surface *explosionSheetFlipped = NULL;
 
 static SoldierSprites soldierSprites;
 
@@ -59,15 +48,12 @@ void initSoldierSprites() {
 
 void freeSoldierSprites() {
     SDL_Surface *sheets[] = {
-        idleSheet, idleSheetFlipped, walkSheet, walkSheetFlipped,
-        attackSheet, attackSheetFlipped, shotSheet, shotSheetFlipped,
-        shot2Sheet, shot2SheetFlipped, grenadeSheet, grenadeSheetFlipped,
-        rechargeSheet, rechargeSheetFlipped, throwSheet, throwSheetFlipped,
-        hurtSheet, hurtSheetFlipped, deadSheet, deadSheetFlipped,
-        explosionSheet, explosionSheetFlipped
+        idleSheet, walkSheet, attackSheet, shotSheet, shot2Sheet, grenadeSheet,
+        rechargeSheet, throwSheet, hurtSheet, deadSheet, explosionSheet
     };
-    for (int i = 0; i < 22; i++) {
+    for (int i = 0; i < 11; i++) {
         if (sheets[i]) {
+            unpackSpriteSheet(sheets[i]);
             SDL_FreeSurface(sheets[i]);
             sheets[i] = NULL;
         }
@@ -95,8 +81,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(idleSheet->format, 255, 255, 255);
-        SDL_SetColorKey(idleSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(idleSheet);
+        SDL_SetColorKey(idleSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(idleSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Idle.png: %s\n", SDL_GetError());
             SDL_FreeSurface(idleSheet);
@@ -104,14 +90,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(idleSheet);
         idleSheet = optimized;
-        SDL_SetColorKey(idleSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        idleSheetFlipped = flipHorizontally(idleSheet);
-        if (!idleSheetFlipped) {
-            fprintf(stderr, "Failed to flip Idle.png\n");
-            SDL_FreeSurface(idleSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(idleSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(idleSheet, 256, 256);
+        SDL_SetColorKey(idleSheet, SDL_SRCCOLORKEY, colorkey);
         soldierSprites.frameCounts[SOLDIER_IDLE] = idleSheet->w / 256;
     }
     if (!walkSheet) {
@@ -121,8 +101,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(walkSheet->format, 255, 255, 255);
-        SDL_SetColorKey(walkSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(walkSheet);
+        SDL_SetColorKey(walkSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(walkSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Walk.png: %s\n", SDL_GetError());
             SDL_FreeSurface(walkSheet);
@@ -130,14 +110,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(walkSheet);
         walkSheet = optimized;
-        SDL_SetColorKey(walkSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        walkSheetFlipped = flipHorizontally(walkSheet);
-        if (!walkSheetFlipped) {
-            fprintf(stderr, "Failed to flip Walk.png\n");
-            SDL_FreeSurface(walkSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(walkSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(walkSheet, 256, 256);
+        SDL_SetColorKey(walkSheet, SDL_SRCCOLORKEY, colorkey);
         soldierSprites.frameCounts[SOLDIER_WALK] = walkSheet->w / 256;
     }
     if (!attackSheet) {
@@ -147,8 +121,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(attackSheet->format, 255, 255, 255);
-        SDL_SetColorKey(attackSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(attackSheet);
+        SDL_SetColorKey(attackSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(attackSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Attack.png: %s\n", SDL_GetError());
             SDL_FreeSurface(attackSheet);
@@ -156,14 +130,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(attackSheet);
         attackSheet = optimized;
-        SDL_SetColorKey(attackSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        attackSheetFlipped = flipHorizontally(attackSheet);
-        if (!attackSheetFlipped) {
-            fprintf(stderr, "Failed to flip Attack.png\n");
-            SDL_FreeSurface(attackSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(attackSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(attackSheet, 256, 256);
+        SDL_SetColorKey(attackSheet, SDL_SRCCOLORKEY, colorkey);
         soldierSprites.frameCounts[SOLDIER_ATTACK] = attackSheet->w / 256;
     }
     if (!shot2Sheet) {
@@ -173,8 +141,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(shot2Sheet->format, 255, 255, 255);
-        SDL_SetColorKey(shot2Sheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(shot2Sheet);
+        SDL_SetColorKey(shot2Sheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(shot2Sheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Shot_2.png: %s\n", SDL_GetError());
             SDL_FreeSurface(shot2Sheet);
@@ -182,14 +150,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(shot2Sheet);
         shot2Sheet = optimized;
-        SDL_SetColorKey(shot2Sheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        shot2SheetFlipped = flipHorizontally(shot2Sheet);
-        if (!shot2SheetFlipped) {
-            fprintf(stderr, "Failed to flip Shot_2.png\n");
-            SDL_FreeSurface(shot2Sheet);
-            exit(1);
-        }
-        SDL_SetColorKey(shot2SheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(shot2Sheet, 256, 256);
+        SDL_SetColorKey(shot2Sheet, SDL_SRCCOLORKEY, colorkey);
         soldierSprites.frameCounts[SOLDIER_SHOT_2] = shot2Sheet->w / 256;
     }
     if (!grenadeSheet) {
@@ -199,8 +161,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(grenadeSheet->format, 255, 255, 255);
-        SDL_SetColorKey(grenadeSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(grenadeSheet);
+        SDL_SetColorKey(grenadeSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(grenadeSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Grenade.png: %s\n", SDL_GetError());
             SDL_FreeSurface(grenadeSheet);
@@ -208,14 +170,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(grenadeSheet);
         grenadeSheet = optimized;
-        SDL_SetColorKey(grenadeSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        grenadeSheetFlipped = flipHorizontally(grenadeSheet);
-        if (!grenadeSheetFlipped) {
-            fprintf(stderr, "Failed to flip Grenade.png\n");
-            SDL_FreeSurface(grenadeSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(grenadeSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(grenadeSheet, 256, 256);
+        SDL_SetColorKey(grenadeSheet, SDL_SRCCOLORKEY, colorkey);
         soldierSprites.frameCounts[SOLDIER_GRENADE] = grenadeSheet->w / 256;
     }
     if (!rechargeSheet) {
@@ -225,8 +181,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(rechargeSheet->format, 255, 255, 255);
-        SDL_SetColorKey(rechargeSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(rechargeSheet);
+        SDL_SetColorKey(rechargeSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(rechargeSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Recharge.png: %s\n", SDL_GetError());
             SDL_FreeSurface(rechargeSheet);
@@ -234,14 +190,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(rechargeSheet);
         rechargeSheet = optimized;
-        SDL_SetColorKey(rechargeSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        rechargeSheetFlipped = flipHorizontally(rechargeSheet);
-        if (!rechargeSheetFlipped) {
-            fprintf(stderr, "Failed to flip Recharge.png\n");
-            SDL_FreeSurface(rechargeSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(rechargeSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(rechargeSheet, 256, 256);
+        SDL_SetColorKey(rechargeSheet, SDL_SRCCOLORKEY, colorkey);
         soldierSprites.frameCounts[SOLDIER_RECHARGE] = rechargeSheet->w / 256;
     }
     if (!hurtSheet) {
@@ -251,8 +201,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(hurtSheet->format, 255, 255, 255);
-        SDL_SetColorKey(hurtSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(hurtSheet);
+        SDL_SetColorKey(hurtSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(hurtSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Hurt.png: %s\n", SDL_GetError());
             SDL_FreeSurface(hurtSheet);
@@ -260,14 +210,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(hurtSheet);
         hurtSheet = optimized;
-        SDL_SetColorKey(hurtSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        hurtSheetFlipped = flipHorizontally(hurtSheet);
-        if (!hurtSheetFlipped) {
-            fprintf(stderr, "Failed to flip Hurt.png\n");
-            SDL_FreeSurface(hurtSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(hurtSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(hurtSheet, 256, 256);
+        SDL_SetColorKey(hurtSheet, SDL_SRCCOLORKEY, colorkey);
         soldierSprites.frameCounts[SOLDIER_HURT] = hurtSheet->w / 256;
     }
     if (!deadSheet) {
@@ -277,8 +221,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(deadSheet->format, 255, 255, 255);
-        SDL_SetColorKey(deadSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(deadSheet);
+        SDL_SetColorKey(deadSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(deadSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Dead.png: %s\n", SDL_GetError());
             SDL_FreeSurface(deadSheet);
@@ -286,14 +230,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(deadSheet);
         deadSheet = optimized;
-        SDL_SetColorKey(deadSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        deadSheetFlipped = flipHorizontally(deadSheet);
-        if (!deadSheetFlipped) {
-            fprintf(stderr, "Failed to flip Dead.png\n");
-            SDL_FreeSurface(deadSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(deadSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(deadSheet, 256, 256);
+        SDL_SetColorKey(deadSheet, SDL_SRCCOLORKEY, colorkey);
         soldierSprites.frameCounts[SOLDIER_DEAD] = deadSheet->w / 256;
     }
     if (!explosionSheet) {
@@ -303,8 +241,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(explosionSheet->format, 255, 255, 255);
-        SDL_SetColorKey(explosionSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(explosionSheet);
+        SDL_SetColorKey(explosionSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(explosionSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Explosion.png: %s\n", SDL_GetError());
             SDL_FreeSurface(explosionSheet);
@@ -312,14 +250,8 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(explosionSheet);
         explosionSheet = optimized;
-        SDL_SetColorKey(explosionSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        explosionSheetFlipped = flipHorizontally(explosionSheet);
-        if (!explosionSheetFlipped) {
-            fprintf(stderr, "Failed to flip Explosion.png\n");
-            SDL_FreeSurface(explosionSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(explosionSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(explosionSheet, 256, 256);
+        SDL_SetColorKey(explosionSheet, SDL_SRCCOLORKEY, colorkey);
     }
 
     
@@ -339,6 +271,10 @@ void initSoldier(Soldier *soldier, int x, int y, struct GAME *game) {
     soldier->health = 15;
     soldier->maxHealth = 15;
     soldier->active = 1;
+    soldier->nav.timer = 0;
+    soldier->nav.mode = NAV_AGENT_DIRECT;
+    soldier->seesPlayer = 0;
+    soldier->losTimer = 0;
     soldier->patrolLeft = x - 200;
     soldier->patrolRight = x + 200;
     soldier->lastAttackTime = 0;
@@ -377,8 +313,7 @@ void updateSoldier(Soldier *soldier, SDL_Rect playerPos, int *playerHealth, int
         return;
     }
 
-    
-    soldier->onGround = onGroundSoldier(game, soldier);
+    // onGround was refreshed by onGroundBatch() in playLevel()
     if (!soldier->onGround) {
         soldier->yVelocity += GRAVITY;
         if (soldier->yVelocity > MAX_FALL_SPEED) {
@@ -387,7 +322,8 @@ void updateSoldier(Soldier *soldier, SDL_Rect playerPos, int *playerHealth, int
     } else {
         soldier->yVelocity = 0.0f;
     }
-    soldier->position.y += (int)soldier->yVelocity;
+    soldier->position.y += sweepMove(game, soldier->world_x, soldier->position.w,
+                                     soldier->position.y + soldier->position.h, (int)soldier->yVelocity);
     if (soldier->onGround && soldier->yVelocity >= 0) {
         placeSoldierOnGround(game, soldier);
     }
@@ -434,6 +370,13 @@ void updateSoldier(Soldier *soldier, SDL_Rect playerPos, int *playerHealth, int
         int dx = game->player.world_x - soldier->world_x;
         int distance = abs(dx);
         soldier->facingLeft = dx < 0 ? 1 : 0;
+        if (--soldier->losTimer <= 0) {
+            soldier->losTimer = LOS_CHECK_FRAMES;
+            soldier->seesPlayer = hasLineOfSight(game, soldier->world_x + soldier->position.w / 2,
+                                                 soldier->position.y + soldier->position.h / 2,
+                                                 game->player.world_x + game->player.position.w / 2,
+                                                 game->player.position.y + game->player.position.h / 2);
+        }
 
         if (soldier->state == SOLDIER_HURT && soldier->invulnerabilityTimer <= 0) {
             soldier->state = SOLDIER_IDLE;
@@ -457,7 +400,7 @@ void updateSoldier(Soldier *soldier, SDL_Rect playerPos, int *playerHealth, int
                         game->player.state = HURT;
                     }
                 }
-            } else if (distance < FIRE_DISTANCE && soldier->bullets > 0) {
+            } else if (distance < FIRE_DISTANCE && soldier->bullets > 0 && soldier->seesPlayer) {
                 soldier->xVelocity = 0.0f;
                 soldier->state = SOLDIER_SHOT_2; 
                 if (soldier->frame >= soldier->totalFrames - 1 && soldier->damageCooldown <= 0) {
@@ -489,11 +432,17 @@ void updateSoldier(Soldier *soldier, SDL_Rect playerPos, int *playerHealth, int
                 }
             } else if (distance < ACTIVATION_DISTANCE) {
                 soldier->state = SOLDIER_WALK;
-                soldier->xVelocity = dx > 0 ? MOVE_SPEED : -MOVE_SPEED;
+                soldier->xVelocity = MOVE_SPEED * chaseDirection(game, &soldier->nav, soldier->world_x, soldier->position.w,
+                                                                 soldier->position.y + soldier->position.h,
+                                                                 game->player.world_x, game->player.position.y + game->player.position.h);
                 soldier->world_x += (int)soldier->xVelocity;
                 soldier->position.x = soldier->world_x;
             } else {
                 soldier->state = SOLDIER_WALK;
+                if (patrolBlocked(game, soldier->world_x, soldier->position.w, soldier->position.y + soldier->position.h,
+                                  soldier->patrolDirection)) {
+                    soldier->patrolDirection = -soldier->patrolDirection;
+                }
                 soldier->xVelocity = soldier->patrolDirection * PATROL_SPEED;
                 soldier->world_x += (int)soldier->xVelocity;
                 soldier->position.x = soldier->world_x;
@@ -546,7 +495,8 @@ void updateSoldier(Soldier *soldier, SDL_Rect playerPos, int *playerHealth, int
             }
         }
 
-        if (game->player.state == ATTACK_1 && soldier->invulnerabilityTimer <= 0) {
+        if (game->player.state == ATTACK_1 && soldier->invulnerabilityTimer <= 0 &&
+            (colliderContacts(&game->broadphase, COLLIDER_SOLDIER, (int)(soldier - game->soldiers)) & CONTACT_PLAYER)) {
             SDL_Rect attackRect = {
                 game->player.world_x + (game->player.facing == RIGHT ? 50 : -50),
                 game->player.position.y, 100, 100
@@ -561,7 +511,8 @@ void updateSoldier(Soldier *soldier, SDL_Rect playerPos, int *playerHealth, int
             }
         }
 
-        if (game->player.bulletActive && soldier->invulnerabilityTimer <= 0) {
+        if (game->player.bulletActive && soldier->invulnerabilityTimer <= 0 &&
+            (colliderContacts(&game->broadphase, COLLIDER_SOLDIER, (int)(soldier - game->soldiers)) & CONTACT_BULLET)) {
             SDL_Rect bulletRect = {game->player.bullet.x, game->player.bullet.y, game->player.bullet_w, game->player.bullet_h};
             SDL_Rect soldierRect = {soldier->world_x, soldier->position.y, soldier->position.w, soldier->position.h};
             if (rectIntersect(&soldierRect, &bulletRect)) {
@@ -607,30 +558,19 @@ void renderSoldier(SDL_Surface *screen, Soldier *soldier, int scroll_x) {
         return;
     }
 
-    SDL_Surface *sheet = soldier->facingLeft ?
-        (soldier->state == SOLDIER_IDLE ? idleSheetFlipped :
-         soldier->state == SOLDIER_WALK ? walkSheetFlipped :
-         soldier->state == SOLDIER_ATTACK ? attackSheetFlipped :
-         soldier->state == SOLDIER_SHOOT ? shotSheetFlipped :
-         soldier->state == SOLDIER_SHOT_2 ? shot2SheetFlipped :
-         soldier->state == SOLDIER_GRENADE ? grenadeSheetFlipped :
-         soldier->state == SOLDIER_RECHARGE ? rechargeSheetFlipped :
-         soldier->state == SOLDIER_THROW ? throwSheetFlipped :
-         soldier->state == SOLDIER_HURT ? hurtSheetFlipped :
-         deadSheetFlipped) :
-        (soldier->state == SOLDIER_IDLE ? idleSheet :
-         soldier->state == SOLDIER_WALK ? walkSheet :
-         soldier->state == SOLDIER_ATTACK ? attackSheet :
-         soldier->state == SOLDIER_SHOOT ? shotSheet :
-         soldier->state == SOLDIER_SHOT_2 ? shot2Sheet :
-         soldier->state == SOLDIER_GRENADE ? grenadeSheet :
-         soldier->state == SOLDIER_RECHARGE ? rechargeSheet :
-         soldier->state == SOLDIER_THROW ? throwSheet :
-         soldier->state == SOLDIER_HURT ? hurtSheet :
-         deadSheet);
+    SDL_Surface *sheet = soldier->state == SOLDIER_IDLE ? idleSheet :
+                         soldier->state == SOLDIER_WALK ? walkSheet :
+                         soldier->state == SOLDIER_ATTACK ? attackSheet :
+                         soldier->state == SOLDIER_SHOOT ? shotSheet :
+                         soldier->state == SOLDIER_SHOT_2 ? shot2Sheet :
+                         soldier->state == SOLDIER_GRENADE ? grenadeSheet :
+                         soldier->state == SOLDIER_RECHARGE ? rechargeSheet :
+                         soldier->state == SOLDIER_THROW ? throwSheet :
+                         soldier->state == SOLDIER_HURT ? hurtSheet :
+                         deadSheet;
 
     if (!sheet) {
-        sheet = soldier->facingLeft ? idleSheetFlipped : idleSheet;
+        sheet = idleSheet;
         LOG("renderSoldier: Fallback to idle sheet for state=%d\n", soldier->state);
     }
 
@@ -641,21 +581,21 @@ void renderSoldier(SDL_Surface *screen, Soldier *soldier, int scroll_x) {
         LOG("renderSoldier: Frame reset for state=%d, frame=%d\n", soldier->state, soldier->frame);
     }
     SDL_Rect destRect = {soldier->position.x, soldier->position.y, 256, 256};
-    SDL_BlitSurface(sheet, &srcRect, screen, &destRect);
+    blitSprite(sheet, &srcRect, screen, &destRect, soldier->facingLeft);
 
     if (soldier->health > 0 && soldier->state != SOLDIER_DEAD) {
         SDL_Rect healthBarBg = {soldier->position.x, soldier->position.y - 20, 50, 5};
-        SDL_FillRect(screen, &healthBarBg, SDL_MapRGB(screen->format, 255, 0, 0));
+        trackedFill(screen, &healthBarBg, SDL_MapRGB(screen->format, 255, 0, 0));
         SDL_Rect healthBar = {soldier->position.x, soldier->position.y - 20, (50 * soldier->health) / soldier->maxHealth, 5};
-        SDL_FillRect(screen, &healthBar, SDL_MapRGB(screen->format, 0, 255, 0));
+        trackedFill(screen, &healthBar, SDL_MapRGB(screen->format, 0, 255, 0));
     }
 
     if (soldier->explosion.active) {
-        SDL_Surface *expSheet = soldier->facingLeft ? explosionSheetFlipped : explosionSheet;
+        SDL_Surface *expSheet = explosionSheet;
         SDL_Rect expSrcRect = {soldier->explosion.frame * 256, 0, 256, 256};
         if (expSrcRect.x < expSheet->w) {
             SDL_Rect expDestRect = {soldier->explosion.position.x - scroll_x, soldier->explosion.position.y, 256, 256};
-            SDL_BlitSurface(expSheet, &expSrcRect, screen, &expDestRect);
+            blitSprite(expSheet, &expSrcRect, screen, &expDestRect, soldier->facingLeft);
         }
     }
 
@@ -6,6 +6,7 @@
 #include <string.h>
 #include "soldier2.h"
 #include "mouvement.h"
+#include "collision.h"
 #include "game.h"
 #include "utils.h"
 
@@ -27,21 +28,13 @@
 #define DEATH_ANIMATION_FRAMES 4 // Explicitly set to 4 frames for death animation
 
 static SDL_Surface *idleSheet = NULL;
-static SDL_Surface *idleSheetFlipped = NULL;
 static SDL_Surface *walkSheet = NULL;
-static SDL_Surface *walkSheetFlipped = NULL;
 static SDL_Surface *attackSheet = NULL;
-static SDL_Surface *attackSheetFlipped = NULL;
 static SDL_Surface *shot2Sheet = NULL;
-static SDL_Surface *shot2SheetFlipped = NULL;
 static SDL_Surface *grenadeSheet = NULL;
-static SDL_Surface *grenadeSheetFlipped = NULL;
 static SDL_Surface *rechargeSheet = NULL;
-static SDL_Surface *rechargeSheetFlipped = NULL;
 static SDL_Surface *hurtSheet = NULL;
-static SDL_Surface *hurtSheetFlipped = NULL;
 static SDL_Surface *deadSheet = NULL;
-static SDL_Surface *deadSheetFlipped = NULL;
 
 void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
     if (!soldier || !game) {
@@ -63,8 +56,8 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(idleSheet->format, 255, 255, 255);
-        SDL_SetColorKey(idleSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(idleSheet);
+        SDL_SetColorKey(idleSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(idleSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Idle.png: %s\n", SDL_GetError());
             SDL_FreeSurface(idleSheet);
@@ -72,13 +65,7 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(idleSheet);
         idleSheet = optimized;
-        idleSheetFlipped = flipHorizontally(idleSheet);
-        if (!idleSheetFlipped) {
-            fprintf(stderr, "Failed to flip Idle.png\n");
-            SDL_FreeSurface(idleSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(idleSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(idleSheet, 256, 256);
     }
     if (!walkSheet) {
         walkSheet = IMG_Load("assets/enemies/Soldier/Soldier_2/Walk.png");
@@ -87,8 +74,8 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(walkSheet->format, 255, 255, 255);
-        SDL_SetColorKey(walkSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(walkSheet);
+        SDL_SetColorKey(walkSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(walkSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Walk.png: %s\n", SDL_GetError());
             SDL_FreeSurface(walkSheet);
@@ -96,13 +83,7 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(walkSheet);
         walkSheet = optimized;
-        walkSheetFlipped = flipHorizontally(walkSheet);
-        if (!walkSheetFlipped) {
-            fprintf(stderr, "Failed to flip Walk.png\n");
-            SDL_FreeSurface(walkSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(walkSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(walkSheet, 256, 256);
     }
     if (!attackSheet) {
         attackSheet = IMG_Load("assets/enemies/Soldier/Soldier_2/Attack.png");
@@ -111,8 +92,8 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(attackSheet->format, 255, 255, 255);
-        SDL_SetColorKey(attackSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(attackSheet);
+        SDL_SetColorKey(attackSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(attackSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Attack.png: %s\n", SDL_GetError());
             SDL_FreeSurface(attackSheet);
@@ -120,13 +101,7 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(attackSheet);
         attackSheet = optimized;
-        attackSheetFlipped = flipHorizontally(attackSheet);
-        if (!attackSheetFlipped) {
-            fprintf(stderr, "Failed to flip Attack.png\n");
-            SDL_FreeSurface(attackSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(attackSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(attackSheet, 256, 256);
     }
     if (!shot2Sheet) {
         shot2Sheet = IMG_Load("assets/enemies/Soldier/Soldier_2/Shot_2.png");
@@ -135,8 +110,8 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(shot2Sheet->format, 255, 255, 255);
-        SDL_SetColorKey(shot2Sheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(shot2Sheet);
+        SDL_SetColorKey(shot2Sheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(shot2Sheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Shot_2.png: %s\n", SDL_GetError());
             SDL_FreeSurface(shot2Sheet);
@@ -144,13 +119,7 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(shot2Sheet);
         shot2Sheet = optimized;
-        shot2SheetFlipped = flipHorizontally(shot2Sheet);
-        if (!shot2SheetFlipped) {
-            fprintf(stderr, "Failed to flip Shot_2.png\n");
-            SDL_FreeSurface(shot2Sheet);
-            exit(1);
-        }
-        SDL_SetColorKey(shot2SheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(shot2Sheet, 256, 256);
     }
     if (!grenadeSheet) {
         grenadeSheet = IMG_Load("assets/enemies/Soldier/Soldier_2/Grenade.png");
@@ -159,8 +128,8 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(grenadeSheet->format, 255, 255, 255);
-        SDL_SetColorKey(grenadeSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(grenadeSheet);
+        SDL_SetColorKey(grenadeSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(grenadeSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Grenade.png: %s\n", SDL_GetError());
             SDL_FreeSurface(grenadeSheet);
@@ -168,13 +137,7 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(grenadeSheet);
         grenadeSheet = optimized;
-        grenadeSheetFlipped = flipHorizontally(grenadeSheet);
-        if (!grenadeSheetFlipped) {
-            fprintf(stderr, "Failed to flip Grenade.png\n");
-            SDL_FreeSurface(grenadeSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(grenadeSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(grenadeSheet, 256, 256);
     }
     if (!rechargeSheet) {
         rechargeSheet = IMG_Load("assets/enemies/Soldier/Soldier_2/Recharge.png");
@@ -183,8 +146,8 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(rechargeSheet->format, 255, 255, 255);
-        SDL_SetColorKey(rechargeSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(rechargeSheet);
+        SDL_SetColorKey(rechargeSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(rechargeSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Recharge.png: %s\n", SDL_GetError());
             SDL_FreeSurface(rechargeSheet);
@@ -192,13 +155,7 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(rechargeSheet);
         rechargeSheet = optimized;
-        rechargeSheetFlipped = flipHorizontally(rechargeSheet);
-        if (!rechargeSheetFlipped) {
-            fprintf(stderr, "Failed to flip Recharge.png\n");
-            SDL_FreeSurface(rechargeSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(rechargeSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(rechargeSheet, 256, 256);
     }
     if (!hurtSheet) {
         hurtSheet = IMG_Load("assets/enemies/Soldier/Soldier_2/Hurt.png");
@@ -207,8 +164,8 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(hurtSheet->format, 255, 255, 255);
-        SDL_SetColorKey(hurtSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(hurtSheet);
+        SDL_SetColorKey(hurtSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(hurtSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Hurt.png: %s\n", SDL_GetError());
             SDL_FreeSurface(hurtSheet);
@@ -216,13 +173,7 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(hurtSheet);
         hurtSheet = optimized;
-        hurtSheetFlipped = flipHorizontally(hurtSheet);
-        if (!hurtSheetFlipped) {
-            fprintf(stderr, "Failed to flip Hurt.png\n");
-            SDL_FreeSurface(hurtSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(hurtSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(hurtSheet, 256, 256);
     }
     if (!deadSheet) {
         deadSheet = IMG_Load("assets/enemies/Soldier/Soldier_2/Dead.png");
@@ -231,8 +182,8 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
             exit(1);
         }
         Uint32 colorkey = SDL_MapRGB(deadSheet->format, 255, 255, 255);
-        SDL_SetColorKey(deadSheet, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
-        SDL_Surface *optimized = SDL_DisplayFormatAlpha(deadSheet);
+        SDL_SetColorKey(deadSheet, SDL_SRCCOLORKEY, colorkey);
+        SDL_Surface *optimized = keyedDisplayFormatAlpha(deadSheet);
         if (!optimized) {
             fprintf(stderr, "SDL_DisplayFormatAlpha failed for Dead.png: %s\n", SDL_GetError());
             SDL_FreeSurface(deadSheet);
@@ -240,13 +191,7 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
         }
         SDL_FreeSurface(deadSheet);
         deadSheet = optimized;
-        deadSheetFlipped = flipHorizontally(deadSheet);
-        if (!deadSheetFlipped) {
-            fprintf(stderr, "Failed to flip Dead.png\n");
-            SDL_FreeSurface(deadSheet);
-            exit(1);
-        }
-        SDL_SetColorKey(deadSheetFlipped, SDL_SRCCOLORKEY | SDL_RLEACCEL, colorkey);
+        packSpriteSheet(deadSheet, 256, 256);
     }
 
     // Initialize soldier fields, matching soldier.c
@@ -268,6 +213,10 @@ void initSoldier2(Soldier2 *soldier, int x, int y, struct GAME *game) {
     soldier->invulnerabilityTimer = 0;
     soldier->facingLeft = 0;
     soldier->active = 1;
+    soldier->nav.timer = 0;
+    soldier->nav.mode = NAV_AGENT_DIRECT;
+    soldier->seesPlayer = 0;
+    soldier->losTimer = 0;
     soldier->frameDelay = 0;
     soldier->patrolDirection = 1;
     soldier->patrolTimer = 60 + rand() % 120;
@@ -297,15 +246,15 @@ void updateSoldier2(Soldier2 *soldier, SDL_Rect playerPos, int *playerHealth, in
         return;
     }
 
-    // Apply gravity and ground snapping, matching soldier.c
-    soldier->onGround = onGroundSoldier2(game, soldier);
+    // Apply gravity and ground snapping, matching soldier.c (onGround comes from onGroundBatch())
     if (!soldier->onGround) {
         soldier->yVelocity += GRAVITY;
         if (soldier->yVelocity > MAX_FALL_SPEED) soldier->yVelocity = MAX_FALL_SPEED;
     } else {
         soldier->yVelocity = 0.0f;
     }
-    soldier->position.y += (int)soldier->yVelocity;
+    soldier->position.y += sweepMove(game, soldier->world_x, soldier->position.w,
+                                     soldier->position.y + soldier->position.h, (int)soldier->yVelocity);
     if (soldier->onGround && soldier->yVelocity >= 0) {
         placeSoldier2OnGround(game, soldier);
     }
@@ -347,6 +296,13 @@ void updateSoldier2(Soldier2 *soldier, SDL_Rect playerPos, int *playerHealth, in
     int dy = (game->player.position.y + game->player.position.h / 2) - (soldier->position.y + soldier->position.h / 2);
     int distance = (int)sqrt(dx * dx + dy * dy);
     soldier->facingLeft = dx < 0 ? 1 : 0;
+    if (--soldier->losTimer <= 0) {
+        soldier->losTimer = LOS_CHECK_FRAMES;
+        soldier->seesPlayer = hasLineOfSight(game, soldier->world_x + soldier->position.w / 2,
+                                             soldier->position.y + soldier->position.h / 2,
+                                             game->player.world_x + game->player.position.w / 2,
+                                             game->player.position.y + game->player.position.h / 2);
+    }
 
     // State machine, matching soldier.c
     if (soldier->state != SOLDIER2_HURT && soldier->state != SOLDIER2_DEAD) {
@@ -371,7 +327,7 @@ void updateSoldier2(Soldier2 *soldier, SDL_Rect playerPos, int *playerHealth, in
                 soldier->damageCooldown = DAMAGE_COOLDOWN;
                 soldier->frame = 0;
             }
-        } else if (distance < FIRE_DISTANCE && soldier->bullets > 0) {
+        } else if (distance < FIRE_DISTANCE && soldier->bullets > 0 && soldier->seesPlayer) {
             soldier->xVelocity = 0.0f;
             soldier->state = SOLDIER2_SHOT_2;
             if (soldier->frame >= soldier->totalFrames - 1 && soldier->damageCooldown <= 0) {
@@ -407,10 +363,16 @@ void updateSoldier2(Soldier2 *soldier, SDL_Rect playerPos, int *playerHealth, in
             }
         } else if (distance < UPDATE_DISTANCE) {
             soldier->state = SOLDIER2_WALK;
-            soldier->xVelocity = dx > 0 ? MOVE_SPEED : -MOVE_SPEED;
+            soldier->xVelocity = MOVE_SPEED * chaseDirection(game, &soldier->nav, soldier->world_x, soldier->position.w,
+                                                             soldier->position.y + soldier->position.h,
+                                                             game->player.world_x, game->player.position.y + game->player.position.h);
             soldier->world_x += (int)soldier->xVelocity;
         } else {
             soldier->state = SOLDIER2_WALK;
+            if (patrolBlocked(game, soldier->world_x, soldier->position.w, soldier->position.y + soldier->position.h,
+                              soldier->patrolDirection)) {
+                soldier->patrolDirection = -soldier->patrolDirection;
+            }
             soldier->xVelocity = soldier->patrolDirection * PATROL_SPEED;
             soldier->world_x += (int)soldier->xVelocity;
             if (--soldier->patrolTimer <= 0) {
@@ -451,7 +413,8 @@ void updateSoldier2(Soldier2 *soldier, SDL_Rect playerPos, int *playerHealth, in
     }
 
     // Handle player attacks, matching soldier.c
-    if (game->player.state == ATTACK_1 && soldier->invulnerabilityTimer <= 0) {
+    if (game->player.state == ATTACK_1 && soldier->invulnerabilityTimer <= 0 &&
+        (colliderContacts(&game->broadphase, COLLIDER_SOLDIER2, (int)(soldier - game->soldiers2)) & CONTACT_PLAYER)) {
         SDL_Rect attackRect = {
             game->player.world_x + (game->player.facing == RIGHT ? 50 : -50),
             game->player.position.y, 100, 100
@@ -465,7 +428,8 @@ void updateSoldier2(Soldier2 *soldier, SDL_Rect playerPos, int *playerHealth, in
             LOG("Soldier2 hit by player attack: health=%d\n", soldier->health);
         }
     }
-    if (game->player.bulletActive && soldier->invulnerabilityTimer <= 0) {
+    if (game->player.bulletActive && soldier->invulnerabilityTimer <= 0 &&
+        (colliderContacts(&game->broadphase, COLLIDER_SOLDIER2, (int)(soldier - game->soldiers2)) & CONTACT_BULLET)) {
         SDL_Rect bulletRect = {game->player.bullet.x, game->player.bullet.y, game->player.bullet.w, game->player.bullet.h};
         SDL_Rect soldierWorldRect = {soldier->world_x, soldier->position.y, soldier->position.w, soldier->position.h};
         if (rectIntersect(&bulletRect, &soldierWorldRect)) {
@@ -513,26 +477,17 @@ void renderSoldier2(SDL_Surface *screen, Soldier2 *soldier, int scroll_x) {
     }
 
     // Select sprite sheet, matching soldier.c
-    SDL_Surface *sheet = soldier->facingLeft ?
-        (soldier->state == SOLDIER2_IDLE ? idleSheetFlipped :
-         soldier->state == SOLDIER2_WALK ? walkSheetFlipped :
-         soldier->state == SOLDIER2_ATTACK ? attackSheetFlipped :
-         soldier->state == SOLDIER2_SHOT_2 ? shot2SheetFlipped :
-         soldier->state == SOLDIER2_GRENADE ? grenadeSheetFlipped :
-         soldier->state == SOLDIER2_RECHARGE ? rechargeSheetFlipped :
-         soldier->state == SOLDIER2_HURT ? hurtSheetFlipped :
-         soldier->state == SOLDIER2_DEAD ? deadSheetFlipped : idleSheetFlipped) :
-        (soldier->state == SOLDIER2_IDLE ? idleSheet :
-         soldier->state == SOLDIER2_WALK ? walkSheet :
-         soldier->state == SOLDIER2_ATTACK ? attackSheet :
-         soldier->state == SOLDIER2_SHOT_2 ? shot2Sheet :
-         soldier->state == SOLDIER2_GRENADE ? grenadeSheet :
-         soldier->state == SOLDIER2_RECHARGE ? rechargeSheet :
-         soldier->state == SOLDIER2_HURT ? hurtSheet :
-         soldier->state == SOLDIER2_DEAD ? deadSheet : idleSheet);
+    SDL_Surface *sheet = soldier->state == SOLDIER2_IDLE ? idleSheet :
+                         soldier->state == SOLDIER2_WALK ? walkSheet :
+                         soldier->state == SOLDIER2_ATTACK ? attackSheet :
+                         soldier->state == SOLDIER2_SHOT_2 ? shot2Sheet :
+                         soldier->state == SOLDIER2_GRENADE ? grenadeSheet :
+                         soldier->state == SOLDIER2_RECHARGE ? rechargeSheet :
+                         soldier->state == SOLDIER2_HURT ? hurtSheet :
+                         soldier->state == SOLDIER2_DEAD ? deadSheet : idleSheet;
 
     if (!sheet) {
-        sheet = soldier->facingLeft ? idleSheetFlipped : idleSheet;
+        sheet = idleSheet;
         LOG("renderSoldier2: Fallback to idle sheet for state=%d\n", soldier->state);
     }
 
@@ -545,23 +500,23 @@ void renderSoldier2(SDL_Surface *screen, Soldier2 *soldier, int scroll_x) {
             soldier->state, soldier->frame, soldier->totalFrames);
     }
     SDL_Rect destRect = {soldier->position.x, soldier->position.y, 256, 256};
-    SDL_BlitSurface(sheet, &srcRect, screen, &destRect);
+    blitSprite(sheet, &srcRect, screen, &destRect, soldier->facingLeft);
 
     // Render health bar, matching soldier.c
     if (soldier->health > 0 && soldier->state != SOLDIER2_DEAD) {
         SDL_Rect healthBarBg = {soldier->position.x, soldier->position.y - 20, 50, 5};
-        SDL_FillRect(screen, &healthBarBg, SDL_MapRGB(screen->format, 255, 0, 0));
+        trackedFill(screen, &healthBarBg, SDL_MapRGB(screen->format, 255, 0, 0));
         SDL_Rect healthBar = {soldier->position.x, soldier->position.y - 20, (50 * soldier->health) / soldier->maxHealth, 5};
-        SDL_FillRect(screen, &healthBar, SDL_MapRGB(screen->format, 0, 255, 0));
+        trackedFill(screen, &healthBar, SDL_MapRGB(screen->format, 0, 255, 0));
     }
 
     // Render grenade smoke
     if (soldier->smoke.active) {
-        SDL_Surface *smokeSheet = soldier->facingLeft ? grenadeSheetFlipped : grenadeSheet;
+        SDL_Surface *smokeSheet = grenadeSheet;
         SDL_Rect smokeSrcRect = {soldier->smoke.frame * 256, 0, 256, 256};
         if (smokeSrcRect.x < smokeSheet->w) {
             SDL_Rect smokeDestRect = {soldier->smoke.position.x - scroll_x, soldier->smoke.position.y, 256, 256};
-            SDL_BlitSurface(smokeSheet, &smokeSrcRect, screen, &smokeDestRect);
+            blitSprite(smokeSheet, &smokeSrcRect, screen, &smokeDestRect, soldier->facingLeft);
         }
     }
 
@@ -581,13 +536,12 @@ void freeSoldier2(Soldier2 *soldier) {
 void freeSoldier2Sprites() {
     LOG("Freeing Soldier2 sprites...\n");
     SDL_Surface *sheets[] = {
-        idleSheet, idleSheetFlipped, walkSheet, walkSheetFlipped,
-        attackSheet, attackSheetFlipped, shot2Sheet, shot2SheetFlipped,
-        grenadeSheet, grenadeSheetFlipped, rechargeSheet, rechargeSheetFlipped,
-        hurtSheet, hurtSheetFlipped, deadSheet, deadSheetFlipped
+        idleSheet, walkSheet, attackSheet, shot2Sheet,
+        grenadeSheet, rechargeSheet, hurtSheet, deadSheet
     };
-    for (int i = 0; i < 16; i++) {
+    for (int i = 0; i < 8; i++) {
         if (sheets[i]) {
+            unpackSpriteSheet(sheets[i]);
             SDL_FreeSurface(sheets[i]);
             sheets[i] = NULL;
         }
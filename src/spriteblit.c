@@ -0,0 +1,137 @@
+#include "spriteblit.h"
+#include "dirtyrect.h"
+#include "atlas.h"
+#include <stdio.h>
+
+static inline Uint32 readPixel(const Uint8 *p, int bpp) {
+    switch (bpp) {
+        case 1: return *p;
+        case 2: return *(const Uint16 *)p;
+        case 3:
+            if (SDL_BYTEORDER == SDL_BIG_ENDIAN) return (p[0] << 16) | (p[1] << 8) | p[2];
+            return p[0] | (p[1] << 8) | (p[2] << 16);
+        default: return *(const Uint32 *)p;
+    }
+}
+
+static inline void writePixel(Uint8 *p, int bpp, Uint32 pixel) {
+    switch (bpp) {
+        case 1: *p = (Uint8)pixel; break;
+        case 2: *(Uint16 *)p = (Uint16)pixel; break;
+        case 3:
+            if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+                p[0] = (pixel >> 16) & 0xFF; p[1] = (pixel >> 8) & 0xFF; p[2] = pixel & 0xFF;
+            } else {
+                p[0] = pixel & 0xFF; p[1] = (pixel >> 8) & 0xFF; p[2] = (pixel >> 16) & 0xFF;
+            }
+            break;
+        default: *(Uint32 *)p = pixel; break;
+    }
+}
+
+// Clips like SDL_UpperBlit(): to the source surface, then to the destination clip rect
+static int clipBlit(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst, SDL_Rect *dstrect, SDL_Rect *from, SDL_Rect *to) {
+    int sx = srcrect ? srcrect->x : 0, sy = srcrect ? srcrect->y : 0;
+    int w = srcrect ? srcrect->w : src->w, h = srcrect ? srcrect->h : src->h;
+    int dx = dstrect ? dstrect->x : 0, dy = dstrect ? dstrect->y : 0;
+
+    if (sx < 0) { w += sx; dx -= sx; sx = 0; }
+    if (sx + w > src->w) w = src->w - sx;
+    if (sy < 0) { h += sy; dy -= sy; sy = 0; }
+    if (sy + h > src->h) h = src->h - sy;
+
+    const SDL_Rect *clip = &dst->clip_rect;
+    if (dx < clip->x) { sx += clip->x - dx; w -= clip->x - dx; dx = clip->x; }
+    if (dx + w > clip->x + clip->w) w = clip->x + clip->w - dx;
+    if (dy < clip->y) { sy += clip->y - dy; h -= clip->y - dy; dy = clip->y; }
+    if (dy + h > clip->y + clip->h) h = clip->y + clip->h - dy;
+    if (w < 0) w = 0;
+    if (h < 0) h = 0;
+
+    *from = (SDL_Rect){sx, sy, w, h};
+    *to = (SDL_Rect){dx, dy, w, h};
+    if (dstrect) *dstrect = *to;
+    return w > 0 && h > 0;
+}
+
+int blitMirrored(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst, SDL_Rect *dstrect) {
+    if (!src || !dst) {
+        SDL_SetError("blitMirrored: passed a NULL surface");
+        return -1;
+    }
+    SDL_Rect from, to;
+    if (!clipBlit(src, srcrect, dst, dstrect, &from, &to)) return 0;
+
+    if (SDL_MUSTLOCK(src) && SDL_LockSurface(src) < 0) return -1;
+    if (SDL_MUSTLOCK(dst) && SDL_LockSurface(dst) < 0) {
+        if (SDL_MUSTLOCK(src)) SDL_UnlockSurface(src);
+        return -1;
+    }
+
+    // SDL's rules: per-pixel alpha wins over the colorkey; otherwise colorkey and/or surface alpha
+    const SDL_PixelFormat *sf = src->format, *df = dst->format;
+    int perPixel = (src->flags & SDL_SRCALPHA) && sf->Amask;
+    int keyed = !perPixel && (src->flags & SDL_SRCCOLORKEY);
+    Uint32 surfaceAlpha = (!perPixel && (src->flags & SDL_SRCALPHA)) ? sf->alpha : SDL_ALPHA_OPAQUE;
+    Uint32 rgbMask = ~sf->Amask;
+    int sbpp = sf->BytesPerPixel, dbpp = df->BytesPerPixel;
+    // Mirrored column from.x is source column src->w - 1 - from.x, read right to left
+    int firstColumn = src->w - 1 - from.x;
+    int packed = sbpp == 4 && dbpp == 4 && !df->Amask && sf->Rmask == df->Rmask && sf->Gmask == df->Gmask &&
+                 sf->Bmask == df->Bmask && df->Gmask == 0x0000FF00 && (df->Rmask | df->Bmask) == 0x00FF00FF;
+
+    for (int y = 0; y < to.h; y++) {
+        const Uint8 *srow = (const Uint8 *)src->pixels + (from.y + y) * src->pitch;
+        Uint8 *drow = (Uint8 *)dst->pixels + (to.y + y) * dst->pitch + to.x * dbpp;
+
+        if (packed) {
+            const Uint32 *s = (const Uint32 *)srow + firstColumn;
+            Uint32 *d = (Uint32 *)drow;
+            for (int x = 0; x < to.w; x++, s--, d++) {
+                Uint32 p = *s;
+                if (keyed && (p & rgbMask) == sf->colorkey) continue;
+                Uint32 a = perPixel ? (p & sf->Amask) >> sf->Ashift : surfaceAlpha;
+                if (a == SDL_ALPHA_OPAQUE) {
+                    *d = p & rgbMask;
+                } else if (a) {
+                    // Same arithmetic as SDL's 32-bit alpha blitters, two channels at a time
+                    Uint32 q = *d;
+                    Uint32 rb = ((q & 0xFF00FF) + (((p & 0xFF00FF) - (q & 0xFF00FF)) * a >> 8)) & 0xFF00FF;
+                    Uint32 g = ((q & 0xFF00) + (((p & 0xFF00) - (q & 0xFF00)) * a >> 8)) & 0xFF00;
+                    *d = rb | g;
+                }
+            }
+            continue;
+        }
+
+        for (int x = 0; x < to.w; x++) {
+            Uint32 p = readPixel(srow + (firstColumn - x) * sbpp, sbpp);
+            if (keyed && (p & rgbMask) == sf->colorkey) continue;
+            Uint8 r, g, b, a;
+            SDL_GetRGBA(p, sf, &r, &g, &b, &a);
+            if (!perPixel) a = surfaceAlpha;
+            if (!a) continue;
+            Uint8 *dp = drow + x * dbpp;
+            if (a != SDL_ALPHA_OPAQUE) {
+                Uint8 dr, dg, db;
+                SDL_GetRGB(readPixel(dp, dbpp), df, &dr, &dg, &db);
+                r = dr + (((int)r - dr) * a >> 8);
+                g = dg + (((int)g - dg) * a >> 8);
+                b = db + (((int)b - db) * a >> 8);
+            }
+            writePixel(dp, dbpp, SDL_MapRGB(df, r, g, b));
+        }
+    }
+
+    if (SDL_MUSTLOCK(dst)) SDL_UnlockSurface(dst);
+    if (SDL_MUSTLOCK(src)) SDL_UnlockSurface(src);
+    if (dst == dirtyRenderer.screen) markDirty(to);
+    return 0;
+}
+
+int blitSprite(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *dst, SDL_Rect *dstrect, int mirrored) {
+    const AtlasSheet *packed = findAtlasSheet(src);
+    if (packed) return blitAtlasSheet(packed, srcrect, dst, dstrect, mirrored);
+    if (mirrored) return blitMirrored(src, srcrect, dst, dstrect);
+    return trackedBlit(src, srcrect, dst, dstrect);
+}
@@ -0,0 +1,184 @@
+#include "spritemask.h"
+#include "colmap.h"
+#include <SDL/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static struct {
+    SDL_Surface *surface;
+    SpriteMask *mask;
+    SpriteMask *mirrored;
+} spriteMasks[MAX_SPRITE_MASKS];
+static int numSpriteMasks = 0;
+
+int spritePixelOpaque(SDL_Surface *surface, int x, int y) {
+    if (x < 0 || x >= surface->w || y < 0 || y >= surface->h) return 0;
+
+    int bpp = surface->format->BytesPerPixel;
+    const Uint8 *p = (const Uint8 *)surface->pixels + y * surface->pitch + x * bpp;
+    Uint32 pixel;
+    switch (bpp) {
+        case 1: pixel = *p; break;
+        case 2: pixel = *(const Uint16 *)p; break;
+        case 3:
+            if (SDL_BYTEORDER == SDL_BIG_ENDIAN) pixel = (p[0] << 16) | (p[1] << 8) | p[2];
+            else pixel = p[0] | (p[1] << 8) | (p[2] << 16);
+            break;
+        default: pixel = *(const Uint32 *)p; break;
+    }
+
+    Uint8 r, g, b, a;
+    SDL_GetRGBA(pixel, surface->format, &r, &g, &b, &a);
+    if (surface->format->Amask && a == 0) return 0;
+    if ((surface->flags & SDL_SRCCOLORKEY) && SDL_MapRGB(surface->format, r, g, b) == surface->format->colorkey) return 0;
+    return 1;
+}
+
+SpriteMask *createSpriteMask(SDL_Surface *surface) {
+    if (!surface) return NULL;
+
+    SpriteMask *mask = malloc(sizeof(SpriteMask));
+    if (!mask) return NULL;
+    mask->w = surface->w;
+    mask->h = surface->h;
+    mask->words = (surface->w + 63) / 64 + 1;
+    mask->rows = calloc((size_t)mask->words * mask->h, sizeof(Uint64));
+    if (!mask->rows) {
+        fprintf(stderr, "createSpriteMask: Failed to allocate %dx%d mask\n", surface->w, surface->h);
+        free(mask);
+        return NULL;
+    }
+
+    if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) == 0) collisionStats.locks++;
+    for (int y = 0; y < mask->h; y++) {
+        Uint64 *row = mask->rows + y * mask->words;
+        for (int x = 0; x < mask->w; x++) {
+            if (spritePixelOpaque(surface, x, y)) row[x >> 6] |= (Uint64)1 << (x & 63);
+        }
+    }
+    if (SDL_MUSTLOCK(surface)) SDL_UnlockSurface(surface);
+    return mask;
+}
+
+SpriteMask *mirrorSpriteMask(const SpriteMask *mask) {
+    if (!mask) return NULL;
+
+    SpriteMask *mirrored = malloc(sizeof(SpriteMask));
+    if (!mirrored) return NULL;
+    *mirrored = *mask;
+    mirrored->rows = calloc((size_t)mask->words * mask->h, sizeof(Uint64));
+    if (!mirrored->rows) {
+        fprintf(stderr, "mirrorSpriteMask: Failed to allocate %dx%d mask\n", mask->w, mask->h);
+        free(mirrored);
+        return NULL;
+    }
+    for (int y = 0; y < mask->h; y++) {
+        const Uint64 *row = mask->rows + y * mask->words;
+        Uint64 *out = mirrored->rows + y * mask->words;
+        for (int x = 0; x < mask->w; x++) {
+            int mx = mask->w - 1 - x;
+            if (row[x >> 6] >> (x & 63) & 1) out[mx >> 6] |= (Uint64)1 << (mx & 63);
+        }
+    }
+    return mirrored;
+}
+
+void freeSpriteMask(SpriteMask *mask) {
+    if (!mask) return;
+    free(mask->rows);
+    free(mask);
+}
+
+// 64 mask bits starting at bit `offset` of a row (rows carry a zero padding word at the end)
+static inline Uint64 rowBits(const Uint64 *row, int offset) {
+    int word = offset >> 6, shift = offset & 63;
+    if (!shift) return row[word];
+    return (row[word] >> shift) | (row[word + 1] << (64 - shift));
+}
+
+int spriteMaskCollision(const SpriteMask *mask1, const SDL_Rect *rect1, const SDL_Rect *srcRect1,
+                        const SpriteMask *mask2, const SDL_Rect *rect2, const SDL_Rect *srcRect2) {
+    if (!mask1 || !rect1 || !srcRect1 || !mask2 || !rect2 || !srcRect2) return 0;
+
+    // Screen area where both rects overlap and both map to pixels inside their source rect and sheet
+    int left1 = srcRect1->x > 0 ? srcRect1->x : 0;
+    int right1 = srcRect1->x + srcRect1->w < mask1->w ? srcRect1->x + srcRect1->w : mask1->w;
+    int top1 = srcRect1->y > 0 ? srcRect1->y : 0;
+    int bottom1 = srcRect1->y + srcRect1->h < mask1->h ? srcRect1->y + srcRect1->h : mask1->h;
+    int left2 = srcRect2->x > 0 ? srcRect2->x : 0;
+    int right2 = srcRect2->x + srcRect2->w < mask2->w ? srcRect2->x + srcRect2->w : mask2->w;
+    int top2 = srcRect2->y > 0 ? srcRect2->y : 0;
+    int bottom2 = srcRect2->y + srcRect2->h < mask2->h ? srcRect2->y + srcRect2->h : mask2->h;
+
+    int dx1 = rect1->x - srcRect1->x, dy1 = rect1->y - srcRect1->y;   // screen = local + d
+    int dx2 = rect2->x - srcRect2->x, dy2 = rect2->y - srcRect2->y;
+
+    int x1 = rect1->x, x2 = rect1->x + rect1->w;
+    int y1 = rect1->y, y2 = rect1->y + rect1->h;
+    if (rect2->x > x1) x1 = rect2->x;
+    if (rect2->x + rect2->w < x2) x2 = rect2->x + rect2->w;
+    if (rect2->y > y1) y1 = rect2->y;
+    if (rect2->y + rect2->h < y2) y2 = rect2->y + rect2->h;
+    if (left1 + dx1 > x1) x1 = left1 + dx1;
+    if (right1 + dx1 < x2) x2 = right1 + dx1;
+    if (top1 + dy1 > y1) y1 = top1 + dy1;
+    if (bottom1 + dy1 < y2) y2 = bottom1 + dy1;
+    if (left2 + dx2 > x1) x1 = left2 + dx2;
+    if (right2 + dx2 < x2) x2 = right2 + dx2;
+    if (top2 + dy2 > y1) y1 = top2 + dy2;
+    if (bottom2 + dy2 < y2) y2 = bottom2 + dy2;
+    if (x1 >= x2 || y1 >= y2) return 0;
+
+    int width = x2 - x1;
+    int offset1 = x1 - dx1, offset2 = x1 - dx2;
+    for (int y = y1; y < y2; y++) {
+        const Uint64 *row1 = mask1->rows + (y - dy1) * mask1->words;
+        const Uint64 *row2 = mask2->rows + (y - dy2) * mask2->words;
+        for (int k = 0; k < width; k += 64) {
+            Uint64 overlap = rowBits(row1, offset1 + k) & rowBits(row2, offset2 + k);
+            if (width - k < 64) overlap &= ((Uint64)1 << (width - k)) - 1;
+            if (overlap) return 1;
+        }
+    }
+    return 0;
+}
+
+void registerSpriteMask(SDL_Surface *surface) {
+    if (!surface || findSpriteMask(surface)) return;
+    if (numSpriteMasks == MAX_SPRITE_MASKS) {
+        fprintf(stderr, "registerSpriteMask: Mask table full, sheet falls back to per-pixel tests\n");
+        return;
+    }
+    SpriteMask *mask = createSpriteMask(surface);
+    if (!mask) return;
+    spriteMasks[numSpriteMasks].surface = surface;
+    spriteMasks[numSpriteMasks].mask = mask;
+    spriteMasks[numSpriteMasks].mirrored = mirrorSpriteMask(mask);
+    numSpriteMasks++;
+}
+
+void releaseSpriteMask(SDL_Surface *surface) {
+    for (int i = 0; i < numSpriteMasks; i++) {
+        if (spriteMasks[i].surface == surface) {
+            freeSpriteMask(spriteMasks[i].mask);
+            freeSpriteMask(spriteMasks[i].mirrored);
+            spriteMasks[i] = spriteMasks[--numSpriteMasks];
+            return;
+        }
+    }
+}
+
+const SpriteMask *findSpriteMask(SDL_Surface *surface) {
+    for (int i = 0; i < numSpriteMasks; i++) {
+        if (spriteMasks[i].surface == surface) return spriteMasks[i].mask;
+    }
+    return NULL;
+}
+
+const SpriteMask *findMirroredSpriteMask(SDL_Surface *surface) {
+    for (int i = 0; i < numSpriteMasks; i++) {
+        if (spriteMasks[i].surface == surface) return spriteMasks[i].mirrored;
+    }
+    return NULL;
+}
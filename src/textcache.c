@@ -0,0 +1,107 @@
+#include "textcache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    TTF_Font *font;
+    TextMode mode;
+    SDL_Color color;
+    Uint32 hash;            // Of text, checked before the string compare
+    char *text;
+    SDL_Surface *surface;
+    Uint32 lastUsed;
+} CachedText;
+
+static CachedText texts[MAX_CACHED_TEXTS];
+static int numTexts = 0;
+static size_t cacheBytes = 0;
+static Uint32 useClock = 0;
+
+// FNV-1a
+static Uint32 hashText(const char *text) {
+    Uint32 hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) hash = (hash ^ *p) * 16777619u;
+    return hash;
+}
+
+static size_t surfaceBytes(const SDL_Surface *surface) {
+    return (size_t)surface->pitch * surface->h;
+}
+
+static void dropText(int i) {
+    cacheBytes -= surfaceBytes(texts[i].surface);
+    SDL_FreeSurface(texts[i].surface);
+    free(texts[i].text);
+    texts[i] = texts[--numTexts];
+}
+
+static int leastRecentlyUsed(void) {
+    int oldest = 0;
+    for (int i = 1; i < numTexts; i++) {
+        if (texts[i].lastUsed < texts[oldest].lastUsed) oldest = i;
+    }
+    return oldest;
+}
+
+// Solid text keeps its background as an RLE colorkey, blended text its alpha channel
+static SDL_Surface *renderText(TTF_Font *font, const char *text, SDL_Color color, TextMode mode) {
+    SDL_Surface *rendered = NULL;
+    switch (mode) {
+        case TEXT_SOLID: rendered = TTF_RenderText_Solid(font, text, color); break;
+        case TEXT_BLENDED: rendered = TTF_RenderText_Blended(font, text, color); break;
+        case TEXT_UTF8_SOLID: rendered = TTF_RenderUTF8_Solid(font, text, color); break;
+        case TEXT_UTF8_BLENDED: rendered = TTF_RenderUTF8_Blended(font, text, color); break;
+    }
+    if (!rendered) return NULL;
+
+    SDL_Surface *converted;
+    if (mode == TEXT_SOLID || mode == TEXT_UTF8_SOLID) {
+        SDL_SetColorKey(rendered, SDL_SRCCOLORKEY | SDL_RLEACCEL, rendered->format->colorkey);
+        converted = SDL_DisplayFormat(rendered);
+    } else {
+        SDL_SetAlpha(rendered, SDL_SRCALPHA | SDL_RLEACCEL, SDL_ALPHA_OPAQUE);
+        converted = SDL_DisplayFormatAlpha(rendered);
+    }
+    if (!converted) return rendered;    // Still drawable, through SDL's generic blitters
+    SDL_FreeSurface(rendered);
+    return converted;
+}
+
+SDL_Surface *cachedText(TTF_Font *font, const char *text, SDL_Color color, TextMode mode) {
+    if (!font || !text) return NULL;
+    Uint32 hash = hashText(text);
+    for (int i = 0; i < numTexts; i++) {
+        CachedText *entry = &texts[i];
+        if (entry->hash == hash && entry->font == font && entry->mode == mode && entry->color.r == color.r &&
+            entry->color.g == color.g && entry->color.b == color.b && strcmp(entry->text, text) == 0) {
+            entry->lastUsed = ++useClock;
+            return entry->surface;
+        }
+    }
+
+    SDL_Surface *surface = renderText(font, text, color, mode);
+    if (!surface) return NULL;
+    char *copy = malloc(strlen(text) + 1);
+    if (!copy) {
+        fprintf(stderr, "cachedText: Out of memory for \"%s\"\n", text);
+        SDL_FreeSurface(surface);
+        return NULL;
+    }
+    strcpy(copy, text);
+
+    // Make room; a surface bigger than the whole cap still gets cached, alone
+    size_t bytes = surfaceBytes(surface);
+    while (numTexts && (numTexts == MAX_CACHED_TEXTS || cacheBytes + bytes > TEXT_CACHE_BYTES)) {
+        dropText(leastRecentlyUsed());
+    }
+    texts[numTexts++] = (CachedText){font, mode, color, hash, copy, surface, ++useClock};
+    cacheBytes += bytes;
+    return surface;
+}
+
+void releaseTextFont(TTF_Font *font) {
+    for (int i = numTexts - 1; i >= 0; i--) {
+        if (texts[i].font == font) dropText(i);
+    }
+}
@@ -0,0 +1,189 @@
+#include "trigger.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void resetTriggers(TriggerSet *set) {
+    set->count = 0;
+    set->numOrdered = 0;
+    set->maxWidth = 0;
+    set->numInside = 0;
+}
+
+void freeTriggers(TriggerSet *set) {
+    free(set->triggers);
+    free(set->order);
+    memset(set, 0, sizeof(*set));
+}
+
+// Position in `order` of the first live handle whose rect.x is >= x
+static int lowerBound(const TriggerSet *set, int x) {
+    int lo = 0, hi = set->numOrdered;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (set->triggers[set->order[mid]].rect.x < x) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static int orderIndex(const TriggerSet *set, int handle) {
+    for (int i = lowerBound(set, set->triggers[handle].rect.x); i < set->numOrdered; i++) {
+        if (set->order[i] == handle) return i;
+    }
+    return -1;
+}
+
+int addTrigger(TriggerSet *set, SDL_Rect rect, int feet, int id, TriggerCallback callback) {
+    if (set->count == set->capacity) {
+        int capacity = set->capacity ? set->capacity * 2 : 32;
+        Trigger *triggers = realloc(set->triggers, capacity * sizeof(Trigger));
+        int *order = realloc(set->order, capacity * sizeof(int));
+        if (triggers) set->triggers = triggers;
+        if (order) set->order = order;
+        if (!triggers || !order) {
+            fprintf(stderr, "addTrigger: Failed to grow trigger set to %d\n", capacity);
+            return -1;
+        }
+        set->capacity = capacity;
+    }
+
+    int handle = set->count++;
+    Trigger *trigger = &set->triggers[handle];
+    trigger->rect = rect;
+    trigger->feet = feet;
+    trigger->id = id;
+    trigger->alive = 1;
+    trigger->callback = callback;
+    if (rect.w > set->maxWidth) set->maxWidth = rect.w;
+
+    int at = lowerBound(set, rect.x);
+    memmove(set->order + at + 1, set->order + at, (set->numOrdered - at) * sizeof(int));
+    set->order[at] = handle;
+    set->numOrdered++;
+    return handle;
+}
+
+void moveTrigger(TriggerSet *set, int handle, SDL_Rect rect) {
+    if (handle < 0 || handle >= set->count || !set->triggers[handle].alive) return;
+    int i = orderIndex(set, handle);
+    if (i < 0) return;
+    set->triggers[handle].rect = rect;
+    if (rect.w > set->maxWidth) set->maxWidth = rect.w;
+
+    // Moving things move a few px per frame, so shifting the handle to its new slot is short
+    while (i > 0 && set->triggers[set->order[i - 1]].rect.x > rect.x) {
+        set->order[i] = set->order[i - 1];
+        set->order[--i] = handle;
+    }
+    while (i + 1 < set->numOrdered && set->triggers[set->order[i + 1]].rect.x < rect.x) {
+        set->order[i] = set->order[i + 1];
+        set->order[++i] = handle;
+    }
+}
+
+void removeTrigger(TriggerSet *set, int handle) {
+    if (handle < 0 || handle >= set->count || !set->triggers[handle].alive) return;
+    int i = orderIndex(set, handle);
+    if (i < 0) return;
+    memmove(set->order + i, set->order + i + 1, (set->numOrdered - i - 1) * sizeof(int));
+    set->numOrdered--;
+    set->triggers[handle].alive = 0;
+
+    for (int k = 0; k < set->numInside; k++) {
+        if (set->inside[k] == handle) {
+            set->inside[k] = set->inside[--set->numInside];
+            break;
+        }
+    }
+}
+
+static int zoneGap(const SDL_Rect *a, const SDL_Rect *b) {
+    int gapX = (a->x > b->x ? a->x - (b->x + b->w) : b->x - (a->x + a->w));
+    int gapY = (a->y > b->y ? a->y - (b->y + b->h) : b->y - (a->y + a->h));
+    return gapX > gapY ? gapX : gapY;
+}
+
+static int clusterRoot(int *parent, int i) {
+    while (parent[i] != i) i = parent[i] = parent[parent[i]];
+    return i;
+}
+
+int addZoneTriggers(TriggerSet *set, const CollisionMap *map, Material material, int radius, TriggerCallback callback) {
+    if (!map->zones || map->numZones == 0) return 0;
+    int *parent = malloc(map->numZones * sizeof(int));
+    if (!parent) {
+        fprintf(stderr, "addZoneTriggers: Failed to allocate %d zone clusters\n", map->numZones);
+        return 0;
+    }
+
+    // Zones whose grown rects overlap are one volume; zones are sorted by x, so stop at the first one past reach
+    for (int i = 0; i < map->numZones; i++) parent[i] = i;
+    for (int i = 0; i < map->numZones; i++) {
+        const SDL_Rect *a = &map->zones[i].rect;
+        if (map->zones[i].material != material) continue;
+        for (int j = i + 1; j < map->numZones && map->zones[j].rect.x <= a->x + a->w + 2 * radius; j++) {
+            if (map->zones[j].material != material || zoneGap(a, &map->zones[j].rect) > 2 * radius) continue;
+            parent[clusterRoot(parent, j)] = clusterRoot(parent, i);
+        }
+    }
+
+    int added = 0;
+    for (int i = 0; i < map->numZones; i++) {
+        if (map->zones[i].material != material || clusterRoot(parent, i) != i) continue;
+        int x0 = map->w, y0 = map->h, x1 = 0, y1 = 0;
+        for (int j = 0; j < map->numZones; j++) {
+            if (map->zones[j].material != material || clusterRoot(parent, j) != i) continue;
+            const SDL_Rect *r = &map->zones[j].rect;
+            if (r->x < x0) x0 = r->x;
+            if (r->y < y0) y0 = r->y;
+            if (r->x + r->w > x1) x1 = r->x + r->w;
+            if (r->y + r->h > y1) y1 = r->y + r->h;
+        }
+        SDL_Rect rect = {x0 - radius, y0 - radius + map->y_offset, x1 - x0 + 2 * radius, y1 - y0 + 2 * radius};
+        if (addTrigger(set, rect, 1, added, callback) >= 0) added++;
+    }
+    free(parent);
+    return added;
+}
+
+static int listed(const int *handles, int count, int handle) {
+    for (int i = 0; i < count; i++) {
+        if (handles[i] == handle) return 1;
+    }
+    return 0;
+}
+
+void updateTriggers(TriggerSet *set, struct GAME *game, SDL_Rect body, int feet_x, int feet_y) {
+    int left = body.x < feet_x ? body.x : feet_x;
+    int right = body.x + body.w - 1 > feet_x ? body.x + body.w - 1 : feet_x;
+
+    int now[TRIGGER_MAX_INSIDE], numNow = 0;
+    for (int i = lowerBound(set, left - set->maxWidth + 1); i < set->numOrdered; i++) {
+        int handle = set->order[i];
+        const Trigger *trigger = &set->triggers[handle];
+        if (trigger->rect.x > right) break;
+        const SDL_Rect *r = &trigger->rect;
+        int overlaps = trigger->feet ? (feet_x >= r->x && feet_x < r->x + r->w && feet_y >= r->y && feet_y < r->y + r->h)
+                                     : rectIntersect(&body, r);
+        if (overlaps && numNow < TRIGGER_MAX_INSIDE) now[numNow++] = handle;
+    }
+
+    // Callbacks may add or remove triggers, so work from copies and re-check that each one is alive
+    int before[TRIGGER_MAX_INSIDE], numBefore = set->numInside;
+    memcpy(before, set->inside, numBefore * sizeof(int));
+    memcpy(set->inside, now, numNow * sizeof(int));
+    set->numInside = numNow;
+
+    for (int i = 0; i < numBefore; i++) {
+        Trigger *trigger = &set->triggers[before[i]];
+        if (trigger->alive && !listed(now, numNow, before[i])) trigger->callback(game, trigger->id, trigger->rect, TRIGGER_EXIT);
+    }
+    for (int i = 0; i < numNow; i++) {
+        Trigger *trigger = &set->triggers[now[i]];
+        if (!trigger->alive) continue;
+        TriggerEvent event = listed(before, numBefore, now[i]) ? TRIGGER_STAY : TRIGGER_ENTER;
+        trigger->callback(game, trigger->id, trigger->rect, event);
+    }
+}
@@ -1,4 +1,6 @@
 #include "ui.h"
+#include "glyphatlas.h"
+#include "textcache.h"
 #include <SDL/SDL_image.h>
 #include <SDL/SDL_ttf.h>
 #include <stdio.h>
@@ -45,10 +47,9 @@ void initUI(UI *ui) {
         fprintf(stderr, "Failed to load ammo_icon.png: %s\n", SDL_GetError());
     } else {
         SDL_SetColorKey(ui->ammoIcon, SDL_SRCCOLORKEY, SDL_MapRGB(ui->ammoIcon->format, 255, 0, 255));
+        packSpriteSheet(ui->ammoIcon, ui->ammoIcon->w, ui->ammoIcon->h);
     }
 
-    ui->cachedScoreSurface = NULL;
-    ui->cachedAmmoSurface = NULL;
     ui->wastedFrame = 0;
     ui->wastedDelay = 0;
     ui->showWasted = 0;
@@ -81,18 +82,13 @@ void updateUI(UI *ui, int playerLives) {
 
 void renderUI(UI *ui, SDL_Surface *screen, Player *player, Global *global) {
     if (ui->avatar) {
-        SDL_BlitSurface(ui->avatar, NULL, screen, &ui->pos_avatar);
+        trackedBlit(ui->avatar, NULL, screen, &ui->pos_avatar);
     }
 
     char livesText[20];
     snprintf(livesText, sizeof(livesText), "%d", player->lives);
-    SDL_Surface *livesSurface = TTF_RenderText_Solid(ui->font, livesText, ui->textColor);
-    if (livesSurface) {
-        SDL_Rect livesRect = {ui->pos_lives.x, ui->pos_lives.y, 0, 0};
-        SDL_BlitSurface(livesSurface, NULL, screen, &livesRect);
-        SDL_FreeSurface(livesSurface);
-    } else {
-        fprintf(stderr, "Warning: Failed to render lives text: %s\n", TTF_GetError());
+    if (blitText(screen, ui->font, livesText, ui->textColor, ui->pos_lives.x, ui->pos_lives.y) < 0) {
+        fprintf(stderr, "Warning: Failed to render lives text: %s\n", SDL_GetError());
     }
 
     // Health Bar Rendering
@@ -105,12 +101,12 @@ void renderUI(UI *ui, SDL_Surface *screen, Player *player, Global *global) {
             if (greenWidth > player->healthBarBg->w) greenWidth = player->healthBarBg->w;
             SDL_Rect greenSrc = {0, 0, greenWidth, player->healthBarGreen->h};
             SDL_Rect greenDst = {ui->pos_healthBar.x, ui->pos_healthBar.y, greenWidth, player->healthBarGreen->h};
-            if (SDL_BlitSurface(player->healthBarGreen, &greenSrc, screen, &greenDst) < 0) {
+            if (blitSprite(player->healthBarGreen, &greenSrc, screen, &greenDst, 0) < 0) {
                 fprintf(stderr, "Warning: Failed to blit healthBarGreen: %s\n", SDL_GetError());
             }
         }
         SDL_Rect bgRect = {ui->pos_healthBar.x, ui->pos_healthBar.y, player->healthBarBg->w, player->healthBarBg->h};
-        if (SDL_BlitSurface(player->healthBarBg, NULL, screen, &bgRect) < 0) {
+        if (blitSprite(player->healthBarBg, NULL, screen, &bgRect, 0) < 0) {
             fprintf(stderr, "Warning: Failed to blit healthBarBg: %s\n", SDL_GetError());
         }
     } else {
@@ -119,48 +115,30 @@ void renderUI(UI *ui, SDL_Surface *screen, Player *player, Global *global) {
     }
 
     // Score Rendering
-    static int lastScore = -1;
-    if (player->score != lastScore) {
-        if (ui->cachedScoreSurface) {
-            SDL_FreeSurface(ui->cachedScoreSurface);
-            ui->cachedScoreSurface = NULL;
-        }
-        char scoreText[32];
-        snprintf(scoreText, sizeof(scoreText), "Score: %d", player->score);
-        ui->cachedScoreSurface = TTF_RenderText_Solid(ui->font, scoreText, ui->textColor);
-        lastScore = player->score;
-        if (!ui->cachedScoreSurface) {
-            fprintf(stderr, "Warning: Failed to render score text: %s\n", TTF_GetError());
-        }
-    }
-    if (ui->cachedScoreSurface) {
+    char scoreText[32];
+    snprintf(scoreText, sizeof(scoreText), "Score: %d", player->score);
+    SDL_Surface *scoreSurface = cachedText(ui->font, scoreText, ui->textColor, TEXT_SOLID);
+    if (scoreSurface) {
         SDL_Rect scoreRect = {ui->pos_score.x, ui->pos_score.y, 0, 0};
-        SDL_BlitSurface(ui->cachedScoreSurface, NULL, screen, &scoreRect);
+        trackedBlit(scoreSurface, NULL, screen, &scoreRect);
+    } else {
+        fprintf(stderr, "Warning: Failed to render score text: %s\n", TTF_GetError());
     }
 
     // Ammo Icon and Count Rendering
     if (ui->ammoIcon) {
         SDL_Rect ammoIconRect = {ui->pos_score.x, ui->pos_score.y + 30, 0, 0};
-        SDL_BlitSurface(ui->ammoIcon, NULL, screen, &ammoIconRect);
+        blitSprite(ui->ammoIcon, NULL, screen, &ammoIconRect, 0);
     }
-    static int lastAmmo = -1;
-    if (player->ammo != lastAmmo) {
-        if (ui->cachedAmmoSurface) {
-            SDL_FreeSurface(ui->cachedAmmoSurface);
-            ui->cachedAmmoSurface = NULL;
-        }
-        char ammoText[20];
-        snprintf(ammoText, sizeof(ammoText), "%d", player->ammo);
-        ui->cachedAmmoSurface = TTF_RenderText_Solid(ui->font, ammoText, ui->textColor);
-        lastAmmo = player->ammo;
-        if (!ui->cachedAmmoSurface) {
-            fprintf(stderr, "Warning: Failed to render ammo text: %s\n", TTF_GetError());
-        }
-    }
-    if (ui->cachedAmmoSurface) {
+    char ammoText[20];
+    snprintf(ammoText, sizeof(ammoText), "%d", player->ammo);
+    SDL_Surface *ammoSurface = cachedText(ui->font, ammoText, ui->textColor, TEXT_SOLID);
+    if (ammoSurface) {
         int iconWidth = ui->ammoIcon ? ui->ammoIcon->w : 0;
         SDL_Rect ammoRect = {ui->pos_score.x + iconWidth + 10, ui->pos_score.y + 30, 0, 0};
-        SDL_BlitSurface(ui->cachedAmmoSurface, NULL, screen, &ammoRect);
+        trackedBlit(ammoSurface, NULL, screen, &ammoRect);
+    } else {
+        fprintf(stderr, "Warning: Failed to render ammo text: %s\n", TTF_GetError());
     }
 
     if (ui->showWasted) {
@@ -168,30 +146,22 @@ void renderUI(UI *ui, SDL_Surface *screen, Player *player, Global *global) {
             SDL_Rect wastedRect = {(SCREEN_WIDTH - ui->wastedImages[ui->wastedFrame]->w) / 2,
                                    (SCREEN_HEIGHT - ui->wastedImages[ui->wastedFrame]->h) / 2,
                                    0, 0};
-            SDL_BlitSurface(ui->wastedImages[ui->wastedFrame], NULL, screen, &wastedRect);
+            trackedBlit(ui->wastedImages[ui->wastedFrame], NULL, screen, &wastedRect);
         }
     }
 
     if (global->gameOver) {
         const char *gameOverText = "Game Over - Press R to Restart";
-        SDL_Surface *gameOverSurface = TTF_RenderText_Solid(ui->font, gameOverText, ui->textColor);
-        if (gameOverSurface) {
-            SDL_Rect rect = {(SCREEN_WIDTH - gameOverSurface->w) / 2, SCREEN_HEIGHT / 2 + 50, 0, 0};
-            SDL_BlitSurface(gameOverSurface, NULL, screen, &rect);
-            SDL_FreeSurface(gameOverSurface);
-        } else {
-            fprintf(stderr, "Warning: Failed to render game over text: %s\n", TTF_GetError());
+        int x = (SCREEN_WIDTH - textWidth(ui->font, gameOverText)) / 2;
+        if (blitText(screen, ui->font, gameOverText, ui->textColor, x, SCREEN_HEIGHT / 2 + 50) < 0) {
+            fprintf(stderr, "Warning: Failed to render game over text: %s\n", SDL_GetError());
         }
     }
 
     if (global->showMessage && strlen(global->message) > 0) {
-        SDL_Surface *messageSurface = TTF_RenderText_Solid(ui->font, global->message, ui->textColor);
-        if (messageSurface) {
-            SDL_Rect messageRect = {global->messagePosition.x, global->messagePosition.y, 0, 0};
-            SDL_BlitSurface(messageSurface, NULL, screen, &messageRect);
-            SDL_FreeSurface(messageSurface);
-        } else {
-            fprintf(stderr, "Warning: Failed to render message text: %s\n", TTF_GetError());
+        if (blitText(screen, ui->font, global->message, ui->textColor,
+                     global->messagePosition.x, global->messagePosition.y) < 0) {
+            fprintf(stderr, "Warning: Failed to render message text: %s\n", SDL_GetError());
         }
     }
 }
@@ -208,20 +178,15 @@ void freeUI(UI *ui) {
         }
     }
     if (ui->font) {
+        releaseGlyphFont(ui->font);
+        releaseTextFont(ui->font);
         TTF_CloseFont(ui->font);
         ui->font = NULL;
     }
-    if (ui->cachedScoreSurface) {
-        SDL_FreeSurface(ui->cachedScoreSurface);
-        ui->cachedScoreSurface = NULL;
-    }
     if (ui->ammoIcon) {
+        unpackSpriteSheet(ui->ammoIcon);
         SDL_FreeSurface(ui->ammoIcon);
         ui->ammoIcon = NULL;
     }
-    if (ui->cachedAmmoSurface) {
-        SDL_FreeSurface(ui->cachedAmmoSurface);
-        ui->cachedAmmoSurface = NULL;
-    }
     printf("UI resources freed\n");
 }
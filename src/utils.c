@@ -1,58 +1,45 @@
 #include "utils.h"
+#include "spritemask.h"
+#include "colmap.h"
+#include "pixelkernels.h"
 #include <SDL/SDL.h>
 #include <stdlib.h>
 
-// Flips a surface horizontally
-SDL_Surface* flipHorizontally(SDL_Surface *src) {
-    if (!src) return NULL;
-
-    SDL_Surface *dest = SDL_CreateRGBSurface(src->flags, src->w, src->h,
-                                            src->format->BitsPerPixel,
-                                            src->format->Rmask,
-                                            src->format->Gmask,
-                                            src->format->Bmask,
-                                            src->format->Amask);
-    if (!dest) {
-        fprintf(stderr, "flipHorizontally: SDL_CreateRGBSurface failed: %s\n", SDL_GetError());
-        return NULL;
+SDL_Surface* keyedDisplayFormatAlpha(SDL_Surface *surface) {
+    if (!surface) return NULL;
+    // SDL converts colorkeyed surfaces with its generic per-pixel blitter. Without the key it
+    // uses the packed converters, and the key is applied afterwards. Palettes may hold the key
+    // color under several indices, so those keep SDL's path.
+    if (!(surface->flags & SDL_SRCCOLORKEY) || surface->format->BytesPerPixel < 2) {
+        return SDL_DisplayFormatAlpha(surface);
     }
 
-    // Lock surfaces if needed
-    if (SDL_MUSTLOCK(src)) SDL_LockSurface(src);
-    if (SDL_MUSTLOCK(dest)) SDL_LockSurface(dest);
-
-    // Copy pixels in reverse order
-    for (int y = 0; y < src->h; y++) {
-        for (int x = 0; x < src->w; x++) {
-            Uint32 pixel = 0;
-            // Read pixel from source
-            if (src->format->BytesPerPixel == 4) {
-                pixel = ((Uint32*)src->pixels)[y * src->w + x];
-            } else if (src->format->BytesPerPixel == 2) {
-                pixel = ((Uint16*)src->pixels)[y * src->w + x];
-            }
-            // Write pixel to destination
-            if (dest->format->BytesPerPixel == 4) {
-                ((Uint32*)dest->pixels)[y * dest->w + (src->w - 1 - x)] = pixel;
-            } else if (dest->format->BytesPerPixel == 2) {
-                ((Uint16*)dest->pixels)[y * dest->w + (src->w - 1 - x)] = pixel;
-            }
-        }
+    Uint32 colorkey = surface->format->colorkey;
+    Uint32 keyFlags = SDL_SRCCOLORKEY | ((surface->flags & SDL_RLEACCELOK) ? SDL_RLEACCEL : 0);
+    Uint8 r, g, b;
+    SDL_GetRGB(colorkey, surface->format, &r, &g, &b);
+    SDL_SetColorKey(surface, 0, 0);
+    SDL_Surface *converted = SDL_DisplayFormatAlpha(surface);
+    SDL_SetColorKey(surface, keyFlags, colorkey);
+    if (!converted) return NULL;
+
+    Uint32 rgbMask = ~converted->format->Amask;
+    Uint32 key = SDL_MapRGB(converted->format, r, g, b) & rgbMask;
+    if (SDL_MUSTLOCK(converted) && SDL_LockSurface(converted) < 0) {
+        SDL_FreeSurface(converted);
+        return NULL;
     }
-
-    // Unlock surfaces
-    if (SDL_MUSTLOCK(src)) SDL_UnlockSurface(src);
-    if (SDL_MUSTLOCK(dest)) SDL_UnlockSurface(dest);
-
-    // Copy colorkey
-    if (src->flags & SDL_SRCCOLORKEY) {
-        SDL_SetColorKey(dest, SDL_SRCCOLORKEY, src->format->colorkey);
+    for (int y = 0; y < converted->h; y++) {
+        clearKeyedPixels32((Uint32 *)((Uint8 *)converted->pixels + y * converted->pitch), converted->w, rgbMask, key);
     }
-
-    return dest;
+    if (SDL_MUSTLOCK(converted)) SDL_UnlockSurface(converted);
+    // SDL_DisplayFormatAlpha() carries an RLE request over from the source
+    if (keyFlags & SDL_RLEACCEL) SDL_SetAlpha(converted, SDL_SRCALPHA | SDL_RLEACCEL, SDL_ALPHA_OPAQUE);
+    return converted;
 }
 
-// Gets the RGB color of a pixel at (x, y) on the surface
+// Gets the RGB color of a pixel at (x, y) on the surface. Locks per call: loops over many pixels
+// should lock once and read rows through surface->pitch, or use the packed CollisionMap for masks.
 SDL_Color get_pixel(SDL_Surface *surface, int x, int y) {
     SDL_Color color = {0, 0, 0};
     if (!surface || x < 0 || x >= surface->w || y < 0 || y >= surface->h) {
@@ -60,16 +47,19 @@ SDL_Color get_pixel(SDL_Surface *surface, int x, int y) {
     }
 
     // Lock surface if needed
-    if (SDL_MUSTLOCK(surface)) SDL_LockSurface(surface);
+    if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface) == 0) collisionStats.locks++;
 
+    int bpp = surface->format->BytesPerPixel;
+    const Uint8 *p = (const Uint8 *)surface->pixels + y * surface->pitch + x * bpp;
     Uint32 pixel;
-    if (surface->format->BytesPerPixel == 4) {
-        pixel = ((Uint32*)surface->pixels)[y * surface->w + x];
-    } else if (surface->format->BytesPerPixel == 2) {
-        pixel = ((Uint16*)surface->pixels)[y * surface->w + x];
-    } else {
-        if (SDL_MUSTLOCK(surface)) SDL_UnlockSurface(surface);
-        return color;
+    switch (bpp) {
+        case 1: pixel = *p; break;
+        case 2: pixel = *(const Uint16 *)p; break;
+        case 3:
+            if (SDL_BYTEORDER == SDL_BIG_ENDIAN) pixel = (p[0] << 16) | (p[1] << 8) | p[2];
+            else pixel = p[0] | (p[1] << 8) | (p[2] << 16);
+            break;
+        default: pixel = *(const Uint32 *)p; break;
     }
 
     // Convert pixel to RGB
@@ -91,6 +81,11 @@ int rectIntersect(const SDL_Rect *a, const SDL_Rect *b) {
 // Checks for pixel-perfect collision between two surfaces
 int pixelPerfectCollision(SDL_Surface *surface1, SDL_Rect *rect1, SDL_Rect *srcRect1,
                          SDL_Surface *surface2, SDL_Rect *rect2, SDL_Rect *srcRect2) {
+    return mirroredPixelCollision(surface1, 0, rect1, srcRect1, surface2, 0, rect2, srcRect2);
+}
+
+int mirroredPixelCollision(SDL_Surface *surface1, int mirrored1, SDL_Rect *rect1, SDL_Rect *srcRect1,
+                           SDL_Surface *surface2, int mirrored2, SDL_Rect *rect2, SDL_Rect *srcRect2) {
     if (!surface1 || !rect1 || !srcRect1 || !surface2 || !rect2 || !srcRect2) {
         return 0;
     }
@@ -100,22 +95,22 @@ int pixelPerfectCollision(SDL_Surface *surface1, SDL_Rect *rect1, SDL_Rect *srcR
         return 0;
     }
 
+    // Sheets registered by their loaders are compared 64 pixels at a time
+    const SpriteMask *mask1 = mirrored1 ? findMirroredSpriteMask(surface1) : findSpriteMask(surface1);
+    const SpriteMask *mask2 = mirrored2 ? findMirroredSpriteMask(surface2) : findSpriteMask(surface2);
+    if (mask1 && mask2) {
+        return spriteMaskCollision(mask1, rect1, srcRect1, mask2, rect2, srcRect2);
+    }
+
     // Compute intersection rectangle
     int x1 = rect1->x > rect2->x ? rect1->x : rect2->x;
     int y1 = rect1->y > rect2->y ? rect1->y : rect2->y;
     int x2 = (rect1->x + rect1->w) < (rect2->x + rect2->w) ? (rect1->x + rect1->w) : (rect2->x + rect2->w);
     int y2 = (rect1->y + rect1->h) < (rect2->y + rect2->h) ? (rect1->y + rect1->h) : (rect2->y + rect2->h);
 
-    // Get colorkeys
-    Uint32 colorkey1 = 0, colorkey2 = 0;
-    int hasColorkey1 = (surface1->flags & SDL_SRCCOLORKEY) != 0;
-    int hasColorkey2 = (surface2->flags & SDL_SRCCOLORKEY) != 0;
-    if (hasColorkey1) colorkey1 = surface1->format->colorkey;
-    if (hasColorkey2) colorkey2 = surface2->format->colorkey;
-
     // Lock surfaces if needed
-    if (SDL_MUSTLOCK(surface1)) SDL_LockSurface(surface1);
-    if (SDL_MUSTLOCK(surface2)) SDL_LockSurface(surface2);
+    if (SDL_MUSTLOCK(surface1) && SDL_LockSurface(surface1) == 0) collisionStats.locks++;
+    if (SDL_MUSTLOCK(surface2) && SDL_LockSurface(surface2) == 0) collisionStats.locks++;
 
     // Check pixels in the intersection area
     for (int y = y1; y < y2; y++) {
@@ -134,20 +129,10 @@ int pixelPerfectCollision(SDL_Surface *surface1, SDL_Rect *rect1, SDL_Rect *srcR
                 continue;
             }
 
-            // Get pixel colors
-            SDL_Color color1 = get_pixel(surface1, localX1, localY1);
-            SDL_Color color2 = get_pixel(surface2, localX2, localY2);
-
-            // Convert colors to pixel values
-            Uint32 pixel1 = SDL_MapRGB(surface1->format, color1.r, color1.g, color1.b);
-            Uint32 pixel2 = SDL_MapRGB(surface2->format, color2.r, color2.g, color2.b);
-
-            // Check if pixels are non-transparent (not equal to colorkey)
-            int pixel1Opaque = !hasColorkey1 || pixel1 != colorkey1;
-            int pixel2Opaque = !hasColorkey2 || pixel2 != colorkey2;
-
             // If both pixels are opaque, collision detected
-            if (pixel1Opaque && pixel2Opaque) {
+            if (mirrored1) localX1 = surface1->w - 1 - localX1;
+            if (mirrored2) localX2 = surface2->w - 1 - localX2;
+            if (spritePixelOpaque(surface1, localX1, localY1) && spritePixelOpaque(surface2, localX2, localY2)) {
                 if (SDL_MUSTLOCK(surface1)) SDL_UnlockSurface(surface1);
                 if (SDL_MUSTLOCK(surface2)) SDL_UnlockSurface(surface2);
                 return 1;
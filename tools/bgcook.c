@@ -0,0 +1,31 @@
+#include <SDL/SDL.h>
+#include <SDL/SDL_image.h>
+#include <stdio.h>
+#include "bgtiles.h"
+
+// Splits a level background PNG into the BMP columns load_level() decodes around the camera
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <levelN.png> <levelN.tiles>\n", argv[0]);
+        return 1;
+    }
+
+    SDL_Surface *image = IMG_Load(argv[1]);
+    if (!image) {
+        fprintf(stderr, "Failed to load %s: %s\n", argv[1], IMG_GetError());
+        return 1;
+    }
+
+    TiledBackground bg;
+    if (!splitTiledBackground(&bg, image, BG_TILE_WIDTH)) {
+        fprintf(stderr, "Failed to split %s into columns\n", argv[1]);
+        SDL_FreeSurface(image);
+        return 1;
+    }
+    SDL_FreeSurface(image);
+
+    int ok = saveTiledBackground(&bg, argv[2]);
+    if (ok) printf("Wrote %s: %d columns of %dx%d\n", argv[2], bg.numTiles, bg.tileWidth, bg.height);
+    freeTiledBackground(&bg);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,307 @@
+#include <SDL/SDL.h>
+#include <SDL/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "colmap.h"
+#include "game.h"
+#include "utils.h"
+
+// Checks the packed CollisionMap queries against the get_pixel() scans the game used before them, on every
+// level mask, and times both. Needs no display: masks are decoded with IMG_Load() and never blitted.
+//
+//   tools/colcheck [-n queries] [-s seed] assets/levels/level1_mask.png ...
+//
+// Each mask is checked through the map built from the PNG and, when it exists, the compiled .colmap next to
+// it. Exits with 1 when any query disagrees.
+
+#define DEFAULT_QUERIES 1000000
+#define MAX_REPORTED 5          // Mismatches printed per query kind
+#define ONGROUND_STEP 5         // Column spacing of onGround* and place*OnGround scans
+#define PLACE_WINDOW 20         // place*OnGround() searches y_start - 20 .. y_start + 20
+
+typedef enum {
+    QUERY_COLOR,        // collision_color()
+    QUERY_ONGROUND,     // onGround*(): one row across the feet
+    QUERY_PLACE,        // placePlayerOnGround() / placeSoldier*OnGround(): centre column, +-20 rows
+    QUERY_PLACE_WIDE,   // placeEnemyOnGround() / sweepMove(): first ground under any sampled column
+    QUERY_RAY,          // projectileHitsTerrain() / hasLineOfSight()
+    QUERY_ZONE,         // collisionFindZone(MAT_DOOR, radius 30)
+    QUERY_KINDS
+} QueryKind;
+
+static const char *kindNames[QUERY_KINDS] = {"color", "onGround", "place", "placeWide", "ray", "zone"};
+// Fraction of -n each kind runs: the reference scans of the last three are hundreds of pixels per query
+static const int kindDivisor[QUERY_KINDS] = {1, 1, 1, 20, 20, 50};
+
+typedef struct {
+    int x, y, x1, y1, w;
+} Query;
+
+// Reference: the per-pixel get_pixel() code the terrain queries replaced
+
+static Material refMaterial(SDL_Surface *mask, int x, int y) {
+    if (x < 0 || x >= mask->w || y < 0 || y >= mask->h) return MAT_EMPTY;
+    SDL_Color c = get_pixel(mask, x, y);
+    if (c.r == 255 && c.g == 255 && c.b == 255) return MAT_SOLID;
+    if (c.r == 255 && c.g == 0 && c.b == 42) return MAT_DOOR;
+    if (c.r == 0 && c.g == 255 && c.b == 0) return MAT_GREEN;
+    return MAT_EMPTY;
+}
+
+static int refOnGround(SDL_Surface *mask, const Query *q) {
+    if (q->y < 0 || q->y >= mask->h) return 0;
+    for (int x = q->x; x <= q->x + q->w - 1; x += ONGROUND_STEP) {
+        if (x >= 0 && x < mask->w && refMaterial(mask, x, q->y) == MAT_SOLID) return 1;
+    }
+    return 0;
+}
+
+static int refPlace(SDL_Surface *mask, const Query *q) {
+    for (int y = q->y - PLACE_WINDOW; y <= q->y + PLACE_WINDOW && y < mask->h; y++) {
+        if (y < 0) continue;
+        if (refMaterial(mask, q->x, y) == MAT_SOLID) return y;
+    }
+    return -1;
+}
+
+static int refPlaceWide(SDL_Surface *mask, const Query *q) {
+    for (int y = q->y < 0 ? 0 : q->y; y < mask->h; y++) {
+        for (int x = q->x; x <= q->x + q->w - 1; x += ONGROUND_STEP) {
+            if (refMaterial(mask, x, y) == MAT_SOLID) return y;
+        }
+    }
+    return -1;
+}
+
+// Same pixel order as collisionRaycast(), one pixel at a time; returns the hit packed as y * 65536 + x, or -1
+static int refRay(SDL_Surface *mask, const Query *q) {
+    int dx = abs(q->x1 - q->x), dy = abs(q->y1 - q->y);
+    int sx = q->x1 >= q->x ? 1 : -1, sy = q->y1 >= q->y ? 1 : -1;
+    int err = dx - dy, x = q->x, y = q->y;
+    for (int n = 0; ; n++) {
+        if (refMaterial(mask, x, y) == MAT_SOLID) return (y + 1024) * 65536 + (x + 1024);
+        if (n == dx + dy) return -1;
+        if (err > 0) {
+            x += sx;
+            err -= 2 * dy;
+        } else {
+            y += sy;
+            err += 2 * dx;
+        }
+    }
+}
+
+static int refZone(SDL_Surface *mask, const Query *q) {
+    int r = q->w;
+    for (int x = q->x - r; x <= q->x + r; x++) {
+        for (int y = q->y - r; y <= q->y + r; y++) {
+            if ((x - q->x) * (x - q->x) + (y - q->y) * (y - q->y) <= r * r && refMaterial(mask, x, y) == MAT_DOOR) return x;
+        }
+    }
+    return -1;
+}
+
+static int runReference(SDL_Surface *mask, QueryKind kind, const Query *q) {
+    switch (kind) {
+        case QUERY_COLOR: return refMaterial(mask, q->x, q->y);
+        case QUERY_ONGROUND: return refOnGround(mask, q);
+        case QUERY_PLACE: return refPlace(mask, q);
+        case QUERY_PLACE_WIDE: return refPlaceWide(mask, q);
+        case QUERY_RAY: return refRay(mask, q);
+        default: return refZone(mask, q);
+    }
+}
+
+// Accelerated: the CollisionMap queries the game calls now
+
+static int runMap(const CollisionMap *map, QueryKind kind, const Query *q) {
+    switch (kind) {
+        case QUERY_COLOR:
+            return collisionMaterial(map, q->x, q->y);
+        case QUERY_ONGROUND:
+            return collisionRowSolid(map, q->x, q->x + q->w - 1, q->y, ONGROUND_STEP);
+        case QUERY_PLACE: {
+            int y = collisionFirstSolidBelow(map, q->x, q->y - PLACE_WINDOW);
+            return (y >= 0 && y <= q->y + PLACE_WINDOW) ? y : -1;
+        }
+        case QUERY_PLACE_WIDE:
+            return collisionGroundBelow(map, q->x, q->x + q->w - 1, ONGROUND_STEP, q->y);
+        case QUERY_RAY: {
+            int hx, hy;
+            return collisionRaycast(map, q->x, q->y, q->x1, q->y1, &hx, &hy) ? (hy + 1024) * 65536 + (hx + 1024) : -1;
+        }
+        default:
+            return collisionFindZone(map, MAT_DOOR, q->x, q->y, q->w);
+    }
+}
+
+// Query generation
+
+static Uint32 rngState;
+
+static Uint32 nextRandom(void) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static int randomRange(int lo, int hi) {
+    return lo + (int)(nextRandom() % (Uint32)(hi - lo + 1));
+}
+
+// Coordinates on the boundaries the map is built from: map edges, packed bytes, tiles
+static int edgeCoord(int size) {
+    switch (nextRandom() % 4) {
+        case 0: {
+            int edges[] = {-2, -1, 0, 1, size - 2, size - 1, size, size + 1};
+            return edges[nextRandom() % 8];
+        }
+        case 1: return (randomRange(0, size / 4) * 4) + randomRange(-1, 1);
+        case 2: return (randomRange(0, size / 8) * 8) + randomRange(-1, 1);
+        default: return (randomRange(0, size / 64) * 64) + randomRange(-1, 1);
+    }
+}
+
+// A y right around a ground surface or underside of column x, where off-by-one errors show
+static int surfaceCoord(const CollisionMap *map, int x) {
+    if (x < 0 || x >= map->w || map->spanStart[x] == map->spanStart[x + 1]) return randomRange(0, map->h - 1);
+    const GroundSpan *span = &map->spans[randomRange(map->spanStart[x], map->spanStart[x + 1] - 1)];
+    int base = (nextRandom() & 1) ? span->top : span->bottom;
+    int offsets[] = {-PLACE_WINDOW - 1, -PLACE_WINDOW, -1, 0, 1, PLACE_WINDOW, PLACE_WINDOW + 1};
+    return base + offsets[nextRandom() % 7];
+}
+
+// A point inside or just outside a door zone
+static void zonePoint(const CollisionMap *map, int *x, int *y) {
+    if (map->numZones == 0) {
+        *x = randomRange(0, map->w - 1);
+        *y = randomRange(0, map->h - 1);
+        return;
+    }
+    const SDL_Rect *r = &map->zones[nextRandom() % map->numZones].rect;
+    *x = randomRange(r->x - 40, r->x + r->w + 40);
+    *y = randomRange(r->y - 40, r->y + r->h + 40);
+}
+
+// Half the queries are uniform over the map and a margin around it, half adversarial
+static void makeQuery(const CollisionMap *map, QueryKind kind, Query *q) {
+    int adversarial = nextRandom() & 1;
+    q->x = adversarial ? edgeCoord(map->w) : randomRange(-64, map->w + 63);
+    q->y = adversarial ? surfaceCoord(map, q->x) : randomRange(-64, map->h + 63);
+    int widths[] = {1, 64, 128, 256};
+    q->w = widths[nextRandom() % 4];
+    q->x1 = q->x;
+    q->y1 = q->y;
+
+    if (kind == QUERY_RAY) {
+        int length = randomRange(0, 600);
+        switch (nextRandom() % 4) {
+            case 0: q->x1 = q->x + (nextRandom() & 1 ? length : -length); break;              // Horizontal shots
+            case 1: q->y1 = q->y + (nextRandom() & 1 ? length : -length); break;
+            case 2: q->x1 = q->x + length; q->y1 = q->y + (nextRandom() & 1 ? length : -length); break;
+            default: q->x1 = q->x + randomRange(-length, length); q->y1 = q->y + randomRange(-length, length); break;
+        }
+    } else if (kind == QUERY_ZONE) {
+        if (adversarial) zonePoint(map, &q->x, &q->y);
+        q->w = 30;
+    }
+}
+
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Runs every kind against the reference; returns the number of mismatches
+static long checkMask(const char *path, int numQueries) {
+    SDL_Surface *mask = IMG_Load(path);
+    if (!mask) {
+        fprintf(stderr, "Failed to load %s: %s\n", path, IMG_GetError());
+        return 1;
+    }
+
+    CollisionMap maps[2];
+    const char *mapNames[2] = {"built", "mapped"};
+    int numMaps = 0;
+    if (!initCollisionMap(&maps[numMaps], mask, (SCREEN_HEIGHT - mask->h) / 2)) {
+        fprintf(stderr, "Failed to build collision map from %s\n", path);
+        SDL_FreeSurface(mask);
+        return 1;
+    }
+    numMaps++;
+
+    char colmapPath[256];
+    snprintf(colmapPath, sizeof(colmapPath), "%.*s.colmap", (int)(strlen(path) - 4), path);
+    if (loadCollisionMap(&maps[numMaps], colmapPath)) numMaps++;
+
+    printf("%s (%dx%d):\n", path, mask->w, mask->h);
+    long mismatches = 0;
+    for (int kind = 0; kind < QUERY_KINDS; kind++) {
+        int count = numQueries / kindDivisor[kind];
+        if (count < 1) count = 1;
+        Query *queries = malloc(count * sizeof(Query));
+        int *expected = malloc(count * sizeof(int));
+        if (!queries || !expected) {
+            fprintf(stderr, "checkMask: Failed to allocate %d queries\n", count);
+            exit(1);
+        }
+        for (int i = 0; i < count; i++) makeQuery(&maps[0], kind, &queries[i]);
+
+        double start = nowNs();
+        for (int i = 0; i < count; i++) expected[i] = runReference(mask, kind, &queries[i]);
+        double refNs = (nowNs() - start) / count;
+        printf("  %-10s %8d queries  reference %9.1f ns", kindNames[kind], count, refNs);
+
+        for (int m = 0; m < numMaps; m++) {
+            long bad = 0;
+            long sink = 0;
+            start = nowNs();
+            for (int i = 0; i < count; i++) sink += runMap(&maps[m], kind, &queries[i]);
+            double mapNs = (nowNs() - start) / count;
+            for (int i = 0; i < count; i++) {
+                int got = runMap(&maps[m], kind, &queries[i]);
+                if (got == expected[i]) continue;
+                if (bad++ < MAX_REPORTED) {
+                    const Query *q = &queries[i];
+                    fprintf(stderr, "    %s %s mismatch: x=%d y=%d x1=%d y1=%d w=%d expected %d got %d\n",
+                            mapNames[m], kindNames[kind], q->x, q->y, q->x1, q->y1, q->w, expected[i], got);
+                }
+            }
+            printf("  %s %7.1f ns (%.0fx) %ld bad", mapNames[m], mapNs, mapNs > 0 ? refNs / mapNs : 0.0, bad);
+            if (sink == 42) printf(" ");   // Keeps the timed loop from being optimised away
+            mismatches += bad;
+        }
+        printf("\n");
+        free(queries);
+        free(expected);
+    }
+
+    for (int m = 0; m < numMaps; m++) freeCollisionMap(&maps[m]);
+    SDL_FreeSurface(mask);
+    return mismatches;
+}
+
+int main(int argc, char *argv[]) {
+    int numQueries = DEFAULT_QUERIES;
+    rngState = 2463534242u;
+    int first = 1;
+    while (first + 1 < argc && argv[first][0] == '-') {
+        if (strcmp(argv[first], "-n") == 0) numQueries = atoi(argv[first + 1]);
+        else if (strcmp(argv[first], "-s") == 0) rngState = (Uint32)strtoul(argv[first + 1], NULL, 10) | 1;
+        else break;
+        first += 2;
+    }
+    if (first >= argc || numQueries <= 0) {
+        fprintf(stderr, "Usage: %s [-n queries] [-s seed] <levelN_mask.png>...\n", argv[0]);
+        return 1;
+    }
+
+    long mismatches = 0;
+    for (int i = first; i < argc; i++) mismatches += checkMask(argv[i], numQueries);
+    printf("%ld mismatches\n", mismatches);
+    return mismatches ? 1 : 0;
+}
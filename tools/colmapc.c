@@ -0,0 +1,33 @@
+#include <SDL/SDL.h>
+#include <SDL/SDL_image.h>
+#include <stdio.h>
+#include "colmap.h"
+#include "game.h"
+
+// Compiles a level mask PNG into the .colmap file load_level() maps at runtime
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <levelN_mask.png> <levelN_mask.colmap>\n", argv[0]);
+        return 1;
+    }
+
+    SDL_Surface *mask = IMG_Load(argv[1]);
+    if (!mask) {
+        fprintf(stderr, "Failed to load %s: %s\n", argv[1], IMG_GetError());
+        return 1;
+    }
+
+    CollisionMap map;
+    if (!initCollisionMap(&map, mask, (SCREEN_HEIGHT - mask->h) / 2)) {
+        fprintf(stderr, "Failed to build collision map from %s\n", argv[1]);
+        SDL_FreeSurface(mask);
+        return 1;
+    }
+    SDL_FreeSurface(mask);
+
+    int ok = saveCollisionMap(&map, argv[2]);
+    freeCollisionMap(&map);
+    if (!ok) return 1;
+    printf("Wrote %s\n", argv[2]);
+    return 0;
+}